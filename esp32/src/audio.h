@@ -0,0 +1,142 @@
+/*
+ * Buzzer Sequencer
+ *
+ * Notes are queued and played from an esp_timer callback driving an LEDC
+ * channel, so sounds run alongside rendering and input instead of
+ * blocking the loop. Each sound has a priority: an equal or higher
+ * priority sound interrupts the one playing, a lower one is dropped.
+ * Volume is the PWM duty (50% = full).
+ */
+
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <Arduino.h>
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "config.h"
+
+#define AUDIO_QUEUE_LEN     32
+#define AUDIO_LEDC_BITS     10
+#define AUDIO_DUTY_FULL     (1 << (AUDIO_LEDC_BITS - 1))   // 50%
+
+enum SoundPriority { PRIO_UI, PRIO_EVENT, PRIO_ALERT };
+
+struct AudioNote {
+    uint16_t freq;              // 0 = rest
+    uint16_t ms;
+};
+
+struct AudioState {
+    AudioNote queue[AUDIO_QUEUE_LEN];
+    uint8_t head;
+    uint8_t count;
+    SoundPriority priority;     // Of the sound playing
+    volatile bool playing;
+    uint8_t volume;             // %, 0 = muted
+    int8_t pin;                 // -1 until audioBegin()
+    esp_timer_handle_t timer;
+    portMUX_TYPE lock;
+};
+
+// One instance; the header is included once per build (single .cpp)
+static AudioState audio = {
+    {}, 0, 0, PRIO_UI, false, 100, -1, nullptr, portMUX_INITIALIZER_UNLOCKED
+};
+
+// Runs in the esp_timer task: start the next note, or go quiet
+static void audioAdvance(void*) {
+    AudioNote note = {0, 0};
+    bool have = false;
+
+    portENTER_CRITICAL(&audio.lock);
+    if (audio.count > 0) {
+        note = audio.queue[audio.head];
+        audio.head = (audio.head + 1) % AUDIO_QUEUE_LEN;
+        audio.count--;
+        have = true;
+    } else {
+        audio.playing = false;
+    }
+    portEXIT_CRITICAL(&audio.lock);
+
+    if (!have) {
+        ledcWrite(BUZZER_CHANNEL, 0);
+        return;
+    }
+
+    if (note.freq > 0 && audio.volume > 0) {
+        ledcWriteTone(BUZZER_CHANNEL, note.freq);
+        ledcWrite(BUZZER_CHANNEL, (AUDIO_DUTY_FULL * audio.volume) / 100);
+    } else {
+        ledcWrite(BUZZER_CHANNEL, 0);
+    }
+    esp_timer_start_once(audio.timer, (uint64_t)note.ms * 1000ULL);
+}
+
+inline void audioBegin(int8_t pin) {
+    ledcSetup(BUZZER_CHANNEL, 2000, AUDIO_LEDC_BITS);
+    ledcAttachPin(pin, BUZZER_CHANNEL);
+    ledcWrite(BUZZER_CHANNEL, 0);
+
+    esp_timer_create_args_t args = {};
+    args.callback = audioAdvance;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "audio";
+    esp_timer_create(&args, &audio.timer);
+    audio.pin = pin;
+}
+
+inline void audioSetVolume(uint8_t pct) {
+    audio.volume = pct > 100 ? 100 : pct;
+}
+
+inline bool audioBusy() {
+    return audio.playing;
+}
+
+// Queue a sound. Returns false if it was dropped (lower priority than the
+// sound playing, muted, or no buzzer).
+inline bool audioPlay(const AudioNote* notes, uint8_t count, SoundPriority prio) {
+    if (audio.pin < 0 || audio.volume == 0 || count == 0) return false;
+    if (count > AUDIO_QUEUE_LEN) count = AUDIO_QUEUE_LEN;
+
+    portENTER_CRITICAL(&audio.lock);
+    if (audio.playing && prio < audio.priority) {
+        portEXIT_CRITICAL(&audio.lock);
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++) audio.queue[i] = notes[i];
+    audio.head = 0;
+    audio.count = count;
+    audio.priority = prio;
+    audio.playing = true;
+    portEXIT_CRITICAL(&audio.lock);
+
+    // Cut the current note short; the timer task starts the new sound
+    esp_timer_stop(audio.timer);
+    esp_timer_start_once(audio.timer, 1);
+    return true;
+}
+
+inline bool audioTone(uint16_t freq, uint16_t ms, SoundPriority prio = PRIO_UI) {
+    AudioNote note = { freq, ms };
+    return audioPlay(&note, 1, prio);
+}
+
+inline void audioStop() {
+    if (audio.pin < 0) return;
+    portENTER_CRITICAL(&audio.lock);
+    audio.count = 0;
+    portEXIT_CRITICAL(&audio.lock);
+    esp_timer_stop(audio.timer);
+    esp_timer_start_once(audio.timer, 1);
+}
+
+// Before deep sleep or a reset: let the last sound finish
+inline void audioWaitIdle(uint32_t timeoutMs) {
+    uint32_t start = millis();
+    while (audioBusy() && millis() - start < timeoutMs) delay(5);
+}
+
+#endif // AUDIO_H
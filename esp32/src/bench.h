@@ -0,0 +1,98 @@
+/*
+ * Microbenchmarks
+ *
+ * Runs an operation N times, timing each call on the CPU cycle counter,
+ * and reports min/median/p99 and the free-heap change across the run.
+ * One untimed call goes first, so one-time allocations and cold caches
+ * don't count. Output is one line per bench, for tools/benchdiff.py:
+ *
+ *   BENCH_RUN <fw_version> <fw_build> <cpu_mhz>
+ *   BENCH <name> <iters> <min> <median> <p99> <unit> <heap_delta>
+ *
+ * Cycles don't depend on the clock for CPU-bound work, but bus and radio
+ * work (OLED push, EEPROM, TLS) does: callers pin the clock for the run
+ * and the header records it. On the host (native tests) the counter is
+ * the steady clock in nanoseconds.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <Arduino.h>
+#include <algorithm>
+#ifdef NATIVE_TEST
+#include <chrono>
+#endif
+
+#ifndef BENCH_MAX_ITERS
+#define BENCH_MAX_ITERS     200
+#endif
+
+#define BENCH_BOOT_WAIT_MS  20000   // -DBENCH_ON_BOOT: longest wait for WiFi
+
+#ifdef NATIVE_TEST
+#define BENCH_UNIT          "ns"
+#else
+#define BENCH_UNIT          "cyc"
+#endif
+
+struct BenchResult {
+    uint16_t iters;
+    uint32_t min;
+    uint32_t median;
+    uint32_t p99;
+    int32_t heapDelta;      // Bytes; negative = still held after the run
+};
+
+// Wraps (17 s at 240 MHz, 4 s on the host); only differences are used
+inline uint32_t benchNow() {
+    #ifdef NATIVE_TEST
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    #else
+    return ESP.getCycleCount();
+    #endif
+}
+
+// Sorts samples in place
+inline BenchResult benchStats(uint32_t* samples, uint16_t n) {
+    BenchResult r = { n, 0, 0, 0, 0 };
+    if (n == 0) return r;
+    std::sort(samples, samples + n);
+    r.min = samples[0];
+    r.median = samples[n / 2];
+    r.p99 = samples[(n * 99) / 100];
+    return r;
+}
+
+inline void benchHeader(Print& out, uint32_t mhz) {
+    out.printf("BENCH_RUN %s %s %lu\n", FW_VERSION, FW_BUILD, (unsigned long)mhz);
+}
+
+inline void benchPrint(Print& out, const char* name, const BenchResult& r) {
+    out.printf("BENCH %s %u %lu %lu %lu %s %ld\n", name, r.iters, (unsigned long)r.min,
+               (unsigned long)r.median, (unsigned long)r.p99, BENCH_UNIT, (long)r.heapDelta);
+}
+
+// Samples live in a static buffer so the run itself doesn't touch the heap
+template <typename Fn>
+BenchResult benchRun(const char* name, uint16_t iters, Fn fn, Print& out = Serial) {
+    static uint32_t samples[BENCH_MAX_ITERS];
+    if (iters > BENCH_MAX_ITERS) iters = BENCH_MAX_ITERS;
+
+    fn();
+    int32_t heapBefore = ESP.getFreeHeap();
+    for (uint16_t i = 0; i < iters; i++) {
+        uint32_t t0 = benchNow();
+        fn();
+        samples[i] = benchNow() - t0;
+    }
+    int32_t heapAfter = ESP.getFreeHeap();
+
+    BenchResult r = benchStats(samples, iters);
+    r.heapDelta = heapAfter - heapBefore;
+    benchPrint(out, name, r);
+    return r;
+}
+
+#endif // BENCH_H
@@ -0,0 +1,88 @@
+/*
+ * Boot Timeline Profiler
+ *
+ * Timestamps each setup() phase and prints a summary once the face is up.
+ * Phases may overlap: WiFi association and the first cloud check run in
+ * the background and report when they finish, after the summary.
+ */
+
+#ifndef BOOTTIME_H
+#define BOOTTIME_H
+
+#include <Arduino.h>
+
+#define BOOT_MAX_PHASES 16
+
+struct BootPhase {
+    const char* name;
+    uint32_t start_us;
+    uint32_t end_us;        // 0 while running
+};
+
+class BootProfiler {
+private:
+    BootPhase phases[BOOT_MAX_PHASES];
+    uint8_t count;
+    uint32_t ready_us;      // Face interactive
+
+    int find(const char* name) {
+        for (int i = count - 1; i >= 0; i--) {
+            if (strcmp(phases[i].name, name) == 0) return i;
+        }
+        return -1;
+    }
+
+public:
+    BootProfiler() : count(0), ready_us(0) {}
+
+    void begin(const char* name) {
+        if (count >= BOOT_MAX_PHASES) return;
+        phases[count].name = name;
+        phases[count].start_us = micros();
+        phases[count].end_us = 0;
+        count++;
+    }
+
+    void end(const char* name) {
+        int i = find(name);
+        if (i < 0 || phases[i].end_us != 0) return;
+        phases[i].end_us = micros();
+
+        // Background phases finishing after the summary get their own line
+        if (ready_us != 0) {
+            Serial.printf("[Boot] %s done at %lu ms (took %lu ms)\n", name,
+                          (unsigned long)(phases[i].end_us / 1000),
+                          (unsigned long)((phases[i].end_us - phases[i].start_us) / 1000));
+        }
+    }
+
+    bool isRunning(const char* name) {
+        int i = find(name);
+        return i >= 0 && phases[i].end_us == 0;
+    }
+
+    // Face is up and buttons work - print the timeline so far
+    void ready() {
+        ready_us = micros();
+
+        Serial.println(F("\n[Boot] Timeline (ms)      start    took"));
+        for (int i = 0; i < count; i++) {
+            const BootPhase& p = phases[i];
+            if (p.end_us != 0) {
+                Serial.printf("  %-22s %6lu  %6lu\n", p.name,
+                              (unsigned long)(p.start_us / 1000),
+                              (unsigned long)((p.end_us - p.start_us) / 1000));
+            } else {
+                Serial.printf("  %-22s %6lu  (running)\n", p.name,
+                              (unsigned long)(p.start_us / 1000));
+            }
+        }
+        Serial.printf("[Boot] Face ready at %lu ms\n", (unsigned long)(ready_us / 1000));
+    }
+
+    uint32_t readyMs() { return ready_us / 1000; }
+};
+
+extern BootProfiler bootProf;
+
+#endif // BOOTTIME_H
@@ -2,7 +2,10 @@
  * Cloud API Client - HTTPS with Bearer Token Auth
  *
  * Handles all communication with ApexAurum Cloud backend.
- * Uses WiFiClientSecure with root CA bundle for TLS validation.
+ * Uses WiFiClientSecure with a DER root CA bundle (certs.h, built by
+ * tools/certs_to_der.py) for TLS validation. With pinned intermediates
+ * in the bundle, a new session is opened and its chain checked before
+ * HTTPClient sends anything over it.
  *
  * Endpoints:
  *   GET  /api/v1/pocket/status  - Check cloud connection & billing
@@ -19,13 +22,28 @@
 #include <WiFiClientSecure.h>
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
+#include <mbedtls/sha256.h>
 #include "config.h"
 #include "certs.h"
+#include "trace.h"
+#include "log.h"
+#include "metrics.h"
+#include "jsonarena.h"
 
 // ============================================================================
 // DATA STRUCTURES
 // ============================================================================
 
+// Power hooks: request start/end (with TLS handshake flag) and extra
+// telemetry sections added to the sync body root
+typedef void (*CloudRequestHook)(bool starting, bool handshake);
+typedef void (*CloudTelemetryFn)(JsonObject obj);
+
+#define CLOUD_PIN_LEN       32          // SHA-256 of an intermediate's SubjectPublicKeyInfo
+
+// Round-trip buckets for apex_cloud_request_ms; the top one is API_TIMEOUT_MS
+static const uint32_t CLOUD_LATENCY_BOUNDS_MS[] = { 100, 250, 500, 1000, 2000, 5000, 10000, 15000 };
+
 struct CloudConfig {
     char cloud_url[128];        // Base URL (from config.json)
     char device_token[TOKEN_MAX_LEN]; // apex_dev_... (from config.json)
@@ -48,11 +66,83 @@ struct CloudStatus {
     char motd[80];              // Message of the day
 };
 
+// ============================================================================
+// DOCUMENT SCHEMAS
+// ============================================================================
+// Fields of every request and response; capacities follow (jsonarena.h).
+// The sync body's telemetry sections are sized by whoever provides them.
+#define CHAT_REPLY_MAX      512     // Longest reply parsed whole; the screen shows less
+#define CLOUD_AGENTS_MAX    8
+#define AGENT_NAME_MAX      15
+
+static constexpr JsonField STATUS_RESPONSE[] = {
+    { "tools_available", 0 }, { "messages_used", 0 }, { "messages_limit", 0 },
+    { "tier", sizeof(CloudStatus::tier_name) }, { "motd", sizeof(CloudStatus::motd) },
+};
+static constexpr JsonField CHAT_REQUEST[] = {
+    { "message", 0 }, { "E", 0 }, { "state", 0 }, { "device_id", DEVICE_ID_MAX_LEN },
+    { "agent", 0 }, { "firmware", 0 },
+};
+static constexpr JsonField CHAT_RESPONSE[] = {
+    { "response", CHAT_REPLY_MAX }, { "expression", 15 }, { "care_value", 0 },
+    { "messages_used", 0 },
+};
+static constexpr JsonField CARE_REQUEST[] = {
+    { "care_type", 0 }, { "intensity", 0 }, { "E", 0 }, { "device_id", DEVICE_ID_MAX_LEN },
+};
+static constexpr JsonField SYNC_REQUEST[] = {
+    { "E", 0 }, { "E_floor", 0 }, { "E_peak", 0 }, { "interactions", 0 }, { "total_care", 0 },
+    { "device_id", DEVICE_ID_MAX_LEN }, { "state", 0 }, { "agent", 0 }, { "curiosity", 0 },
+    { "playfulness", 0 }, { "wisdom", 0 }, { "firmware", 0 },
+};
+static constexpr JsonField SYNC_RESPONSE[] = { { "motd", sizeof(CloudStatus::motd) } };
+static constexpr JsonField AGENTS_RESPONSE[] = { { "agents", 0 } };
+
+static constexpr size_t STATUS_RESPONSE_CAP = jsonObjectSize(STATUS_RESPONSE, true) + JSON_SLACK;
+static constexpr size_t CHAT_REQUEST_CAP = jsonObjectSize(CHAT_REQUEST, false);
+static constexpr size_t CHAT_RESPONSE_CAP = jsonObjectSize(CHAT_RESPONSE, true) + JSON_SLACK;
+static constexpr size_t CARE_REQUEST_CAP = jsonObjectSize(CARE_REQUEST, false);
+static constexpr size_t SYNC_REQUEST_CAP = jsonObjectSize(SYNC_REQUEST, false);
+static constexpr size_t SYNC_RESPONSE_CAP = jsonObjectSize(SYNC_RESPONSE, true) + JSON_SLACK;
+static constexpr size_t AGENTS_RESPONSE_CAP = jsonObjectSize(AGENTS_RESPONSE, true) +
+    JSON_ARRAY_SIZE(CLOUD_AGENTS_MAX) + CLOUD_AGENTS_MAX * JSON_STRING_SIZE(AGENT_NAME_MAX) + JSON_SLACK;
+
+static_assert(CHAT_RESPONSE_CAP <= JSON_ARENA_SIZE, "chat reply must fit the JSON arena");
+static_assert(AGENTS_RESPONSE_CAP <= JSON_ARENA_SIZE, "agent list must fit the JSON arena");
+
 struct WifiNetwork {
     char ssid[33];
     char pass[65];
 };
 
+// Care events that couldn't be sent (offline, backoff). Lives in RTC memory
+// so taps made before deep sleep still reach the cloud on a later sync.
+#define CARE_QUEUE_MAX      16
+
+struct CareEvent {
+    char care_type[8];          // "love", "poke"
+    float intensity;
+    float E;                    // Soul E when the care happened
+};
+
+struct CareQueue {
+    uint8_t count;
+    uint16_t dropped;           // Oldest events discarded when full
+    CareEvent events[CARE_QUEUE_MAX];
+};
+
+inline void careQueuePush(CareQueue* q, const char* careType, float intensity, float E) {
+    if (q->count >= CARE_QUEUE_MAX) {
+        memmove(&q->events[0], &q->events[1], sizeof(CareEvent) * (CARE_QUEUE_MAX - 1));
+        q->count--;
+        q->dropped++;
+    }
+    CareEvent& ev = q->events[q->count++];
+    strlcpy(ev.care_type, careType, sizeof(ev.care_type));
+    ev.intensity = intensity;
+    ev.E = E;
+}
+
 // ============================================================================
 // CLOUD CLIENT CLASS
 // ============================================================================
@@ -61,6 +151,24 @@ private:
     WiFiClientSecure secureClient;
     CloudConfig* config;
     bool initialized;
+    CloudRequestHook requestHook;
+    CloudTelemetryFn telemetryFn;
+    size_t telemetryCap;            // Pool the telemetry sections need
+    unsigned long requestStart;
+    const uint8_t (*pins)[CLOUD_PIN_LEN];
+    uint8_t pinCount;               // 0: any chain the bundle validates
+
+    // Outcomes, round trips and handshakes (registerMetrics)
+    Counter reqOk{"apex_cloud_requests_total", "Cloud API requests by result", "result=\"ok\""};
+    Counter reqAuth{"apex_cloud_requests_total", "", "result=\"auth\""};
+    Counter reqBilling{"apex_cloud_requests_total", "", "result=\"billing\""};
+    Counter reqServer{"apex_cloud_requests_total", "", "result=\"server\""};
+    Counter reqNetwork{"apex_cloud_requests_total", "", "result=\"network\""};
+    Counter reqOther{"apex_cloud_requests_total", "", "result=\"other\""};
+    Counter handshakes{"apex_cloud_tls_handshakes_total", "TLS sessions opened to the cloud host"};
+    Counter pinRejects{"apex_cloud_pin_rejects_total", "TLS sessions dropped for lacking a pinned intermediate"};
+    Histogram latency{"apex_cloud_request_ms", "Cloud HTTP exchange time",
+                      CLOUD_LATENCY_BOUNDS_MS, sizeof(CLOUD_LATENCY_BOUNDS_MS) / sizeof(uint32_t)};
 
     // Build full URL for an endpoint
     String buildUrl(const char* endpoint) {
@@ -69,12 +177,75 @@ private:
 
     // Add auth headers to HTTP client
     void addHeaders(HTTPClient& https) {
+        https.setReuse(true);  // Keep-alive: back-to-back calls share one TLS session
         https.addHeader("Content-Type", "application/json");
         https.addHeader("Authorization", String("Bearer ") + config->device_token);
     }
 
+    // Host and port of the cloud URL
+    bool hostPort(char* name, size_t size, uint16_t& port) {
+        const char* host = strstr(config->cloud_url, "://");
+        host = host ? host + 3 : config->cloud_url;
+        size_t len = strcspn(host, ":/");
+        if (len >= size) return false;
+        memcpy(name, host, len);
+        name[len] = '\0';
+        port = host[len] == ':' ? atoi(host + len + 1) : 443;
+        return true;
+    }
+
+    // Open the session here so its chain is checked before HTTPClient,
+    // which reuses an open connection, sends the token over it. The leaf
+    // is skipped: one of the certs above it must carry a pinned key.
+    bool connectPinned() {
+        char name[64];
+        uint16_t port;
+        if (!hostPort(name, sizeof(name), port) || !secureClient.connect(name, port)) return false;
+
+        const mbedtls_x509_crt* crt = secureClient.getPeerCertificate();
+        for (crt = crt ? crt->next : nullptr; crt; crt = crt->next) {
+            uint8_t hash[CLOUD_PIN_LEN];
+            mbedtls_sha256_ret(crt->pk_raw.p, crt->pk_raw.len, hash, 0);
+            for (uint8_t i = 0; i < pinCount; i++) {
+                if (memcmp(hash, pins[i], CLOUD_PIN_LEN) == 0) return true;
+            }
+        }
+        pinRejects.inc();
+        LOG_E(CLOUD, "[Cloud] TLS chain has no pinned intermediate, request not sent");
+        secureClient.stop();
+        return false;
+    }
+
+    // Bracket each HTTP exchange for the power hook. A request on a closed
+    // connection costs a TLS handshake. False: the new session failed the
+    // pin check and the request must not go out.
+    bool requestStarting() {
+        bool handshake = !secureClient.connected();
+        TRACE_BEGIN(TRACE_CLOUD, "http");
+        if (handshake) {
+            TRACE_INSTANT(TRACE_CLOUD, "tls_handshake", 0);
+            handshakes.inc();
+        }
+        requestStart = millis();
+        if (requestHook) requestHook(true, handshake);
+        return !handshake || !pinCount || connectPinned();
+    }
+
+    void requestDone() {
+        latency.observe(millis() - requestStart);
+        if (requestHook) requestHook(false, false);
+        TRACE_END(TRACE_CLOUD, "http");
+    }
+
     // Handle HTTP response code, update status
     void handleResponseCode(int code, CloudStatus* status) {
+        if (code == 200) reqOk.inc();
+        else if (code == 401) reqAuth.inc();
+        else if (code == 402) reqBilling.inc();
+        else if (code >= 500) reqServer.inc();
+        else if (code < 0) reqNetwork.inc();
+        else reqOther.inc();
+
         if (code == 200) {
             status->connected = true;
             status->consecutive_failures = 0;
@@ -82,22 +253,22 @@ private:
             status->backoff_ms = 0;
         } else if (code == 401) {
             status->token_valid = false;
-            Serial.println(F("[Cloud] 401 - Token invalid, device needs re-pairing"));
+            LOG_E(CLOUD, "[Cloud] 401 - Token invalid, device needs re-pairing");
         } else if (code == 402) {
             status->billing_ok = false;
-            Serial.println(F("[Cloud] 402 - Message limit reached"));
+            LOG_W(CLOUD, "[Cloud] 402 - Message limit reached");
         } else if (code >= 500) {
             status->consecutive_failures++;
             applyBackoff(status);
-            Serial.printf("[Cloud] %d - Server error (failure #%d)\n", code, status->consecutive_failures);
+            LOG_W(CLOUD, "[Cloud] %d - Server error (failure #%d)", code, status->consecutive_failures);
         } else if (code < 0) {
             // Network error
             status->connected = false;
             status->consecutive_failures++;
             applyBackoff(status);
-            Serial.printf("[Cloud] Network error %d (failure #%d)\n", code, status->consecutive_failures);
+            LOG_W(CLOUD, "[Cloud] Network error %d (failure #%d)", code, status->consecutive_failures);
         } else {
-            Serial.printf("[Cloud] Unexpected %d\n", code);
+            LOG_W(CLOUD, "[Cloud] Unexpected %d", code);
         }
     }
 
@@ -113,24 +284,55 @@ private:
 public:
     CloudStatus status;
 
-    CloudClient() : config(nullptr), initialized(false) {
+    CloudClient() : config(nullptr), initialized(false),
+                    requestHook(nullptr), telemetryFn(nullptr), telemetryCap(0),
+                    requestStart(0), pins(nullptr), pinCount(0) {
+        resetStatus();
+    }
+
+    // Forget counters, backoff and 401/402 flags (e.g. after a new token)
+    void resetStatus() {
         memset(&status, 0, sizeof(CloudStatus));
         status.token_valid = true;
         status.billing_ok = true;
     }
 
     void init(CloudConfig* cfg) {
+        secureClient.stop();  // Drop any kept-alive connection to an old host
         config = cfg;
         if (!config || !config->configured) {
-            Serial.println(F("[Cloud] No config, running offline"));
+            LOG_I(CLOUD, "[Cloud] No config, running offline");
             initialized = false;
             return;
         }
 
-        secureClient.setCACert(CLOUD_ROOT_CA);
+        // The bundle is indexed once and shared by every session; nothing
+        // is decoded per handshake
+        secureClient.setCACertBundle(CLOUD_CA_BUNDLE);
+        #if CLOUD_CA_PIN_COUNT
+        setPins(CLOUD_CA_PINS, CLOUD_CA_PIN_COUNT);
+        #endif
         initialized = true;
-        Serial.printf("[Cloud] Initialized for %s\n", config->cloud_url);
-        Serial.printf("[Cloud] Device: %s\n", config->device_id);
+        LOG_I(CLOUD, "[Cloud] Initialized for %s", config->cloud_url);
+        LOG_D(CLOUD, "[Cloud] Device: %s", config->device_id);
+    }
+
+    void setRequestHook(CloudRequestHook hook) { requestHook = hook; }
+    // Intermediates a new session's chain must include (certs.h sets them)
+    void setPins(const uint8_t (*list)[CLOUD_PIN_LEN], uint8_t count) {
+        pins = list;
+        pinCount = count;
+    }
+    // capacity: JSON pool for everything fn adds, root members included
+    void setTelemetryProvider(CloudTelemetryFn fn, size_t capacity) {
+        telemetryFn = fn;
+        telemetryCap = capacity;
+    }
+
+    void registerMetrics(MetricsRegistry& reg) {
+        Metric* all[] = { &reqOk, &reqAuth, &reqBilling, &reqServer, &reqNetwork, &reqOther,
+                          &handshakes, &pinRejects, &latency };
+        for (Metric* m : all) reg.add(m);
     }
 
     bool isInitialized() { return initialized; }
@@ -156,6 +358,8 @@ public:
         if (!shouldAttempt()) return false;
         status.last_attempt = millis();
 
+        TRACE_SCOPE(TRACE_CLOUD, "status");
+        JsonArenaScope arena;
         HTTPClient https;
         String url = buildUrl("/status");
 
@@ -163,13 +367,13 @@ public:
         addHeaders(https);
         https.setTimeout(API_TIMEOUT_MS);
 
-        int code = https.GET();
+        int code = requestStarting() ? https.GET() : HTTPC_ERROR_CONNECTION_REFUSED;
         handleResponseCode(code, &status);
 
         if (code == 200) {
             String response = https.getString();
-            StaticJsonDocument<512> doc;
-            if (!deserializeJson(doc, response)) {
+            ArenaJsonDocument doc(STATUS_RESPONSE_CAP);
+            if (jsonArena.parsed(deserializeJson(doc, response), "status")) {
                 status.tools_available = doc["tools_available"] | 0;
                 status.messages_used = doc["messages_used"] | 0;
                 status.messages_limit = doc["messages_limit"] | 0;
@@ -180,16 +384,18 @@ public:
                 const char* motd = doc["motd"] | "";
                 strlcpy(status.motd, motd, sizeof(status.motd));
 
-                Serial.printf("[Cloud] Status OK - %d tools, %s tier, %d/%d msgs\n",
+                LOG_I(CLOUD, "[Cloud] Status OK - %d tools, %s tier, %d/%d msgs",
                     status.tools_available,
                     status.tier_name,
                     status.messages_used,
                     status.messages_limit);
             }
+            requestDone();
             https.end();
             return true;
         }
 
+        requestDone();
         https.end();
         return false;
     }
@@ -205,6 +411,8 @@ public:
         if (!status.billing_ok) return false;  // Don't try chat when 402
         status.last_attempt = millis();
 
+        TRACE_SCOPE(TRACE_CLOUD, "chat");
+        JsonArenaScope arena;
         HTTPClient https;
         String url = buildUrl("/chat");
 
@@ -212,24 +420,28 @@ public:
         addHeaders(https);
         https.setTimeout(API_TIMEOUT_MS);
 
-        StaticJsonDocument<512> doc;
-        doc["message"] = message;
-        doc["E"] = E;
-        doc["state"] = state;
-        doc["device_id"] = config->device_id;
-        doc["agent"] = agent;
-        doc["firmware"] = FW_VERSION;
-
+        // The request document is handed back before the reply is parsed
         String body;
-        serializeJson(doc, body);
+        {
+            ArenaJsonDocument doc(CHAT_REQUEST_CAP);
+            doc["message"] = message;
+            doc["E"] = E;
+            doc["state"] = state;
+            doc["device_id"] = config->device_id;
+            doc["agent"] = agent;
+            doc["firmware"] = FW_VERSION;
+            if (!jsonArena.built(doc, "chat")) return false;
+            serializeJson(doc, body);
+        }
 
-        int code = https.POST(body);
+        int code = requestStarting() ? https.POST(body) : HTTPC_ERROR_CONNECTION_REFUSED;
         handleResponseCode(code, &status);
 
         if (code == 200) {
             String resp = https.getString();
-            StaticJsonDocument<1024> respDoc;
-            if (!deserializeJson(respDoc, resp)) {
+            ArenaJsonDocument respDoc(CHAT_RESPONSE_CAP);
+            bool ok = jsonArena.parsed(deserializeJson(respDoc, resp), "chat");
+            if (ok) {
                 const char* text = respDoc["response"] | "...";
                 strlcpy(response, text, maxLen);
 
@@ -243,10 +455,12 @@ public:
                     status.messages_used = respDoc["messages_used"];
                 }
             }
+            requestDone();
             https.end();
-            return true;
+            return ok;
         }
 
+        requestDone();
         https.end();
         return false;
     }
@@ -258,6 +472,7 @@ public:
         if (!shouldAttempt()) return false;
         status.last_attempt = millis();
 
+        TRACE_SCOPE(TRACE_CLOUD, "care");
         HTTPClient https;
         String url = buildUrl("/care");
 
@@ -265,22 +480,56 @@ public:
         addHeaders(https);
         https.setTimeout(5000);  // Care is fire-and-forget, shorter timeout
 
-        StaticJsonDocument<256> doc;
+        JsonArenaScope arena;
+        ArenaJsonDocument doc(CARE_REQUEST_CAP);
         doc["care_type"] = careType;
         doc["intensity"] = intensity;
         doc["E"] = E;
         doc["device_id"] = config->device_id;
+        if (!jsonArena.built(doc, "care")) return false;
 
         String body;
         serializeJson(doc, body);
 
-        int code = https.POST(body);
+        int code = requestStarting() ? https.POST(body) : HTTPC_ERROR_CONNECTION_REFUSED;
         handleResponseCode(code, &status);
+        requestDone();
         https.end();
 
         return (code == 200);
     }
 
+    // Sync request body, telemetry included (also timed by /bench json).
+    // False when it didn't fit its document.
+    bool buildSyncBody(String& body, float E, float E_floor, float E_peak,
+                       uint32_t interactions, float totalCare,
+                       const char* state, const char* agent,
+                       float curiosity, float playfulness, float wisdom,
+                       const char* fwVersion) {
+        JsonArenaScope arena;
+        ArenaJsonDocument doc(SYNC_REQUEST_CAP + (telemetryFn ? telemetryCap : 0));
+        doc["E"] = E;
+        doc["E_floor"] = E_floor;
+        doc["E_peak"] = E_peak;
+        doc["interactions"] = interactions;
+        doc["total_care"] = totalCare;
+        doc["device_id"] = config->device_id;
+        doc["state"] = state;
+        doc["agent"] = agent;
+        doc["curiosity"] = curiosity;
+        doc["playfulness"] = playfulness;
+        doc["wisdom"] = wisdom;
+        doc["firmware"] = fwVersion;
+        if (telemetryFn) {
+            telemetryFn(doc.as<JsonObject>());
+        }
+
+        body = "";
+        if (!jsonArena.built(doc, "sync")) return false;
+        serializeJson(doc, body);
+        return true;
+    }
+
     // ========================================================================
     // POST /api/v1/pocket/sync
     // ========================================================================
@@ -293,6 +542,14 @@ public:
         if (!shouldAttempt()) return false;
         status.last_attempt = millis();
 
+        TRACE_SCOPE(TRACE_CLOUD, "sync");
+        String body;
+        if (!buildSyncBody(body, E, E_floor, E_peak, interactions, totalCare, state, agent,
+                           curiosity, playfulness, wisdom, fwVersion)) {
+            return false;
+        }
+
+        JsonArenaScope arena;
         HTTPClient https;
         String url = buildUrl("/sync");
 
@@ -300,39 +557,23 @@ public:
         addHeaders(https);
         https.setTimeout(API_TIMEOUT_MS);
 
-        StaticJsonDocument<512> doc;
-        doc["E"] = E;
-        doc["E_floor"] = E_floor;
-        doc["E_peak"] = E_peak;
-        doc["interactions"] = interactions;
-        doc["total_care"] = totalCare;
-        doc["device_id"] = config->device_id;
-        doc["state"] = state;
-        doc["agent"] = agent;
-        doc["curiosity"] = curiosity;
-        doc["playfulness"] = playfulness;
-        doc["wisdom"] = wisdom;
-        doc["firmware"] = fwVersion;
-
-        String body;
-        serializeJson(doc, body);
-
-        int code = https.POST(body);
+        int code = requestStarting() ? https.POST(body) : HTTPC_ERROR_CONNECTION_REFUSED;
         handleResponseCode(code, &status);
 
         if (code == 200) {
             String resp = https.getString();
-            StaticJsonDocument<256> respDoc;
-            if (!deserializeJson(respDoc, resp)) {
+            ArenaJsonDocument respDoc(SYNC_RESPONSE_CAP);
+            if (jsonArena.parsed(deserializeJson(respDoc, resp), "sync")) {
                 // Server may return updated MOTD or config
                 const char* motd = respDoc["motd"] | "";
                 if (strlen(motd) > 0) {
                     strlcpy(status.motd, motd, sizeof(status.motd));
                 }
             }
-            Serial.println(F("[Cloud] Sync OK"));
+            LOG_I(CLOUD, "[Cloud] Sync OK");
         }
 
+        requestDone();
         https.end();
         return (code == 200);
     }
@@ -340,10 +581,12 @@ public:
     // ========================================================================
     // GET /api/v1/pocket/agents
     // ========================================================================
-    bool fetchAgents(char agentNames[][16], int* count, int maxAgents) {
+    bool fetchAgents(char agentNames[][AGENT_NAME_MAX + 1], int* count, int maxAgents) {
         if (!shouldAttempt()) return false;
         status.last_attempt = millis();
 
+        TRACE_SCOPE(TRACE_CLOUD, "agents");
+        JsonArenaScope arena;
         HTTPClient https;
         String url = buildUrl("/agents");
 
@@ -351,29 +594,71 @@ public:
         addHeaders(https);
         https.setTimeout(API_TIMEOUT_MS);
 
-        int code = https.GET();
+        int code = requestStarting() ? https.GET() : HTTPC_ERROR_CONNECTION_REFUSED;
         handleResponseCode(code, &status);
 
         if (code == 200) {
             String response = https.getString();
-            StaticJsonDocument<512> doc;
-            if (!deserializeJson(doc, response)) {
+            ArenaJsonDocument doc(AGENTS_RESPONSE_CAP);
+            bool ok = jsonArena.parsed(deserializeJson(doc, response), "agents");
+            if (ok) {
                 JsonArray agents = doc["agents"].as<JsonArray>();
                 *count = 0;
                 for (JsonVariant a : agents) {
                     if (*count >= maxAgents) break;
-                    strlcpy(agentNames[*count], a.as<const char*>(), 16);
+                    strlcpy(agentNames[*count], a.as<const char*>(), AGENT_NAME_MAX + 1);
                     (*count)++;
                 }
             }
+            requestDone();
             https.end();
-            return true;
+            return ok;
         }
 
+        requestDone();
         https.end();
         return false;
     }
 
+    // ========================================================================
+    // QUEUED CARE
+    // ========================================================================
+    // Sends queued events back-to-back over the kept-alive connection.
+    // Stops at the first failure; whatever wasn't sent stays queued.
+    int flushCare(CareQueue* q) {
+        int sent = 0;
+        while (sent < q->count) {
+            const CareEvent& ev = q->events[sent];
+            if (!care(ev.care_type, ev.intensity, ev.E)) break;
+            sent++;
+        }
+        if (sent > 0) {
+            memmove(&q->events[0], &q->events[sent], sizeof(CareEvent) * (q->count - sent));
+            q->count -= sent;
+            LOG_I(CLOUD, "[Cloud] Flushed %d queued care events (%d left)", sent, q->count);
+        }
+        return sent;
+    }
+
+    // Close the TLS session (before sleep or WiFi off)
+    void endSession() {
+        secureClient.stop();
+    }
+
+    // A fresh TLS session to the cloud host and nothing else (/bench tls).
+    // Drops the kept-alive one; the next request opens its own.
+    bool handshake() {
+        if (!initialized) return false;
+        char name[64];
+        uint16_t port;
+        if (!hostPort(name, sizeof(name), port)) return false;
+
+        secureClient.stop();
+        bool ok = secureClient.connect(name, port);
+        secureClient.stop();
+        return ok;
+    }
+
     // Minutes since last successful cloud contact
     float minutesSinceContact() {
         if (status.last_success == 0) return -1;
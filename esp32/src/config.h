@@ -11,9 +11,13 @@
 // ============================================================================
 // HARDWARE VARIANT
 // ============================================================================
-// Build flag -DVARIANT_WOKWI_OVERRIDE selects Wokwi from platformio.ini
+// Build flag -DVARIANT_WOKWI_OVERRIDE selects Wokwi from platformio.ini,
+// -DVARIANT_SENSE_OVERRIDE the XIAO S3 Sense (env:esp32s3_sense)
 #ifdef VARIANT_WOKWI_OVERRIDE
     #define VARIANT_WOKWI
+#elif defined(VARIANT_SENSE_OVERRIDE)
+    #define VARIANT_XIAO_S3
+    #define VARIANT_XIAO_S3_SENSE   // Same pins, 8 MB octal PSRAM in use (memplace.h)
 #else
     // Default: production hardware
     // Uncomment ONE of these if not using build flags:
@@ -33,9 +37,12 @@
 #define FEATURE_BATTERY         // Battery voltage monitoring (ADC)
 #define FEATURE_EEPROM          // I2C EEPROM/FRAM for soul backup
 #define FEATURE_DEEPSLEEP       // Deep sleep for battery life
+#define FEATURE_LIGHTSLEEP      // Light sleep naps between blinks when idle
 #define FEATURE_ANIMATIONS      // Smooth face animations
 #define FEATURE_RICH_OFFLINE    // Extended offline responses
 #define FEATURE_SD              // External SD card for config & history
+// #define FEATURE_TRACE        // Event trace ring and /trace (env:esp32s3_trace)
+// #define FEATURE_METRICS_HTTP // Prometheus scrape endpoint on :9100 (env:esp32s3_metrics)
 
 // Cloud features (new in v2.0)
 #define FEATURE_CLOUD           // Cloud API support (HTTPS)
@@ -69,6 +76,7 @@
     #undef FEATURE_BATTERY
     #undef FEATURE_EEPROM
     #undef FEATURE_DEEPSLEEP
+    #undef FEATURE_LIGHTSLEEP
     #undef FEATURE_SD
     #undef FEATURE_SD_CONFIG
     #undef FEATURE_CHAT_LOG
@@ -85,7 +93,11 @@
     #define PIN_BATTERY     3       // D2/A2 - ADC for LiPo monitoring
     #define PIN_VIBRATION   4       // D3 - Future: haptic motor
     #define USE_LITTLEFS    true
+    #ifdef VARIANT_XIAO_S3_SENSE
+    #define HAS_PSRAM       true    // Bulk buffers to PSRAM (memplace.h)
+    #else
     #define HAS_PSRAM       false   // Regular XIAO S3 (not Sense)
+    #endif
 
     // SD Card SPI (Pololu breakout)
     // XIAO S3 SPI pins: D8=SCK, D9=MISO, D10=MOSI, D7=CS
@@ -115,6 +127,7 @@
 #define I2C_ADDR_OLED       0x3C
 #define I2C_ADDR_EEPROM     0x50    // AT24C256 / FM24C64
 #define I2C_ADDR_EEPROM_ALT 0x57    // Alternate address
+#define I2C_CLOCK_HZ        400000  // Both devices are fast-mode parts
 
 // ============================================================================
 // DISPLAY SETTINGS
@@ -123,6 +136,15 @@
 #define SCREEN_HEIGHT       64
 #define OLED_RESET          -1
 
+// Panel power: contrast presets (config.json "brightness"), idle dim/off
+#define CONTRAST_LOW        0x10
+#define CONTRAST_NORMAL     0x7F
+#define CONTRAST_HIGH       0xCF
+#define CONTRAST_DIM        0x00
+#define DISPLAY_DIM_MS      30000   // 30s idle -> minimum contrast
+#define DISPLAY_OFF_MS      120000  // 2 minutes idle -> panel off
+#define PIXEL_SHIFT_MS      60000   // Move static elements by 1px every minute
+
 // ============================================================================
 // CLOUD API SETTINGS
 // ============================================================================
@@ -169,17 +191,55 @@
 #define BATTERY_R2          100     // Voltage divider R2 (k ohm)
 
 #define SLEEP_TIMEOUT_MS    300000  // 5 minutes idle -> deep sleep
+#define LIGHT_SLEEP_IDLE_MS 20000   // 20s idle -> radio parked, light sleep naps
+#define LIGHT_SLEEP_MIN_MS  100     // Shorter gaps just delay()
+#define LIGHT_SLEEP_MAX_MS  10000   // Upper bound for a single nap
 #define SLEEP_WAKEUP_PIN    1       // GPIO1 (D0/BTN_A) - must be RTC GPIO
 
+// Duty-cycled background sync while in deep sleep
+#define SYNC_WAKE_INTERVAL_H    4       // RTC timer wake every N hours (0 = off)
+#define SYNC_CYCLE_TIMEOUT_MS   20000   // Give up and go back to sleep
+
+// CPU clock (cpufreq.h)
+#define CPU_BOOST_MHZ           240     // TLS, JSON, SD
+#define CPU_IDLE_MHZ            80      // Lowest clock with WiFi, APB unchanged
+#ifndef CPU_MIN_MHZ
+#define CPU_MIN_MHZ             80      // Frame waits with radio off (40 = APB drops too)
+#endif
+
+// Battery policy tiers (policy.h)
+#define POLICY_SAVER_PCT        40
+#define POLICY_LOW_PCT          20
+#define POLICY_CRITICAL_PCT     10
+#define POLICY_RESERVE_PCT      5       // Final save + sync, then sleep
+#define POLICY_FAST_DRAIN_PCT_H 15      // Draining faster -> one tier lower
+#define POLICY_SAMPLE_MS        60000   // Battery sample period
+#define POLICY_HISTORY          30      // Samples in the drain window
+#define POLICY_DRAIN_MIN_SAMPLES 10     // 10 min of history before the drain rate counts
+
+// Current estimates for the per-cycle energy report (XIAO S3 + OLED standby)
+#define CURRENT_AWAKE_MA        40      // CPU on, radio off
+#define CURRENT_WIFI_MA         110     // Radio associating / transferring
+
+// Energy accounting (energy.h): added per subsystem while it is on
+#define CURRENT_WIFI_IDLE_MA    20      // Associated, modem sleep
+#define CURRENT_BOOST_MA        25      // 240 MHz over 80 MHz
+#define CURRENT_OLED_MA         8       // SSD1306 lit, typical face
+#define CURRENT_LIGHT_SLEEP_UA  1500    // Replaces CPU awake while napping
+#define CURRENT_DEEP_SLEEP_UA   100     // RTC domain + regulator quiescent
+#define CHARGE_TLS_UAH          25      // One TLS handshake
+#define BATTERY_CAPACITY_MAH    500
+#define ENERGY_SAVE_INTERVAL_MS 1800000 // Persist totals every 30 minutes
+
 // ============================================================================
 // AUDIO SETTINGS
 // ============================================================================
 #define BUZZER_CHANNEL      0       // LEDC channel for PWM
 #define TONE_LOVE           880     // A5 - love received
 #define TONE_POKE           440     // A4 - poke
-#define TONE_BOOT           523     // C5 - boot chime
 #define TONE_ERROR          220     // A3 - error
-#define TONE_SYNC           660     // E5 - sync complete
+#define TONE_SYNC           660     // E5 - sync started
+// Jingles (boot, sync done, billing, agent, mood) are RTTTL in melody.h
 
 // ============================================================================
 // SOUL SETTINGS
@@ -203,12 +263,17 @@
 // ============================================================================
 #define DEBOUNCE_MS         50
 #define LONG_PRESS_MS       800
+#define DOUBLE_TAP_MS       300     // Second tap window (buttons with a double)
+#define CHORD_MS            1000    // Both buttons: sync on release
+#define FACTORY_RESET_MS    10000   // Both buttons: wipe the soul and restart
 #define BLINK_MIN_MS        2000
 #define BLINK_MAX_MS        6000
 #define SAVE_INTERVAL_MS    60000   // Auto-save every minute
 #define WIFI_RETRY_MS       30000
 #define ANIMATION_FPS       30
 #define AUTO_SYNC_INTERVAL_MS 1800000  // 30 minutes
+#define CONFIG_CHECK_INTERVAL_MS 10000  // config.json watcher + SD hot-plug
+#define SD_RETRY_MAX_MS         300000  // Failed mounts back off, doubling, to this
 
 // ============================================================================
 // EEPROM LAYOUT (for I2C EEPROM/FRAM)
@@ -0,0 +1,191 @@
+/*
+ * Serial Console
+ *
+ * Non-blocking line assembler: poll() takes whatever bytes the UART has,
+ * builds the line in a fixed buffer and dispatches at most one complete
+ * line per call, so a half-typed line never holds up a frame. Lines
+ * starting with '/' go to the command table, anything else to chat.
+ *
+ * Up/down arrows walk the last CONSOLE_HISTORY lines. Echo is off by
+ * default (serial monitors echo locally); /echo turns it on for raw
+ * terminals.
+ */
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <Arduino.h>
+
+#define CONSOLE_LINE_LEN    128
+#define CONSOLE_HISTORY     4
+
+typedef void (*ConsoleHandler)(const char* args);
+
+struct ConsoleCommand {
+    const char* name;           // Including the slash
+    const char* usage;
+    ConsoleHandler fn;
+};
+
+class SerialConsole {
+private:
+    char line[CONSOLE_LINE_LEN];
+    uint8_t len;
+    bool overflow;              // Line too long: dropped up to the next newline
+    bool lastCR;                // Swallow the \n of a \r\n
+    uint8_t escape;             // 0, ESC seen, ESC [ seen
+
+    char history[CONSOLE_HISTORY][CONSOLE_LINE_LEN];
+    uint8_t historyCount;
+    uint8_t historyHead;        // Next slot to write
+    int8_t browse;              // Steps back while using the arrows, -1 = not
+
+    bool echo;
+    const ConsoleCommand* commands;
+    uint8_t commandCount;
+    ConsoleHandler chat;
+
+    void redraw() {
+        if (!echo) return;
+        Serial.print(F("\r\x1b[K"));
+        Serial.write((const uint8_t*)line, len);
+    }
+
+    void recall(int8_t steps) {
+        if (steps < -1 || steps >= historyCount) return;
+        browse = steps;
+        if (steps < 0) {
+            len = 0;
+        } else {
+            uint8_t slot = (historyHead + CONSOLE_HISTORY - 1 - steps) % CONSOLE_HISTORY;
+            len = strlcpy(line, history[slot], sizeof(line));
+        }
+        redraw();
+    }
+
+    void remember(const char* text) {
+        if (historyCount > 0) {
+            uint8_t last = (historyHead + CONSOLE_HISTORY - 1) % CONSOLE_HISTORY;
+            if (strcmp(history[last], text) == 0) return;
+        }
+        strlcpy(history[historyHead], text, CONSOLE_LINE_LEN);
+        historyHead = (historyHead + 1) % CONSOLE_HISTORY;
+        if (historyCount < CONSOLE_HISTORY) historyCount++;
+    }
+
+    void dispatch(char* text) {
+        // Trim
+        while (*text == ' ' || *text == '\t') text++;
+        char* end = text + strlen(text);
+        while (end > text && (end[-1] == ' ' || end[-1] == '\t')) *--end = '\0';
+        if (!*text) return;
+
+        remember(text);
+
+        if (*text != '/') {
+            if (chat) chat(text);
+            return;
+        }
+
+        char* args = text;
+        while (*args && *args != ' ') args++;
+        size_t nameLen = args - text;
+        while (*args == ' ') args++;
+
+        for (uint8_t i = 0; i < commandCount; i++) {
+            if (strlen(commands[i].name) == nameLen &&
+                strncmp(commands[i].name, text, nameLen) == 0) {
+                commands[i].fn(args);
+                return;
+            }
+        }
+        Serial.print(F("[Serial] Unknown command: "));
+        Serial.println(text);
+        Serial.println(F("[Serial] /help lists commands"));
+    }
+
+    // Returns true when a line completed and was dispatched
+    bool feed(char c) {
+        if (escape == 1) {
+            escape = c == '[' ? 2 : 0;
+            return false;
+        }
+        if (escape == 2) {
+            escape = 0;
+            if (c == 'A') recall(browse + 1);
+            else if (c == 'B') recall(browse - 1);
+            return false;
+        }
+
+        if (c == '\n' && lastCR) {
+            lastCR = false;
+            return false;
+        }
+        lastCR = c == '\r';
+
+        if (c == '\r' || c == '\n') {
+            if (echo) Serial.println();
+            bool dropped = overflow;
+            line[len] = '\0';
+            len = 0;
+            overflow = false;
+            browse = -1;
+            if (dropped) {
+                Serial.printf("[Serial] Line over %d chars dropped\n", CONSOLE_LINE_LEN - 1);
+                return false;
+            }
+            dispatch(line);
+            return true;
+        }
+
+        if (c == 0x1b) {
+            escape = 1;
+        } else if (c == '\b' || c == 0x7f) {
+            if (len > 0) {
+                len--;
+                if (echo) Serial.print(F("\b \b"));
+            }
+        } else if (c >= ' ') {
+            if (len < CONSOLE_LINE_LEN - 1) {
+                line[len++] = c;
+                if (echo) Serial.write(c);
+            } else {
+                overflow = true;
+            }
+        }
+        return false;
+    }
+
+public:
+    SerialConsole() : len(0), overflow(false), lastCR(false), escape(0),
+                      historyCount(0), historyHead(0), browse(-1), echo(false),
+                      commands(nullptr), commandCount(0), chat(nullptr) {}
+
+    void begin(const ConsoleCommand* table, uint8_t count, ConsoleHandler chatHandler) {
+        commands = table;
+        commandCount = count;
+        chat = chatHandler;
+    }
+
+    // Returns true if a line was handled (counts as user activity)
+    bool poll() {
+        while (Serial.available() > 0) {
+            if (feed((char)Serial.read())) return true;
+        }
+        return false;
+    }
+
+    void setEcho(bool on) { echo = on; }
+    bool getEcho() { return echo; }
+
+    void printHelp() {
+        for (uint8_t i = 0; i < commandCount; i++) {
+            Serial.printf("  %-8s %s\n", commands[i].name, commands[i].usage);
+        }
+        Serial.println(F("  Anything else is sent to chat. Up/down: history"));
+    }
+};
+
+extern SerialConsole console;
+
+#endif // CONSOLE_H
@@ -0,0 +1,210 @@
+/*
+ * CPU Frequency Scaling
+ *
+ * The CPU idles at CPU_IDLE_MHZ (80 MHz: the lowest clock WiFi runs at,
+ * and APB stays at 80 MHz so I2C, LEDC and UART timing don't move). Work
+ * that is CPU-bound - TLS handshakes, JSON parsing, SD reads - runs inside
+ * a CpuBoost scope at CPU_BOOST_MHZ.
+ *
+ * Below 80 MHz the APB clock follows the CPU. CPU_MIN_MHZ only applies
+ * while the loop is waiting between frames with the radio off, no USB host
+ * attached and no ApbLock held (buzzer output, display and EEPROM I2C
+ * transfers). It defaults to CPU_IDLE_MHZ; the esp32s3_minclock env sets 40.
+ */
+
+#ifndef CPUFREQ_H
+#define CPUFREQ_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "jsonarena.h"
+
+#define CPU_BENCH_HOLD_MS   2000    // Per clock, long enough to read a meter
+#define CPU_BENCH_PARSES    50
+
+static const char CPU_BENCH_JSON[] =
+    "{\"status\":\"ok\",\"tools_available\":42,\"tier\":\"adept\","
+    "\"messages_used\":17,\"messages_limit\":500,"
+    "\"motd\":\"The athanor never cools\",\"agents\":[\"AZOTH\",\"ELYSIAN\","
+    "\"VAJRA\",\"KETHER\"]}";
+// Six members, four agents, and room for every string copied out
+#define CPU_BENCH_JSON_CAP  (JSON_OBJECT_SIZE(6) + JSON_ARRAY_SIZE(4) + sizeof(CPU_BENCH_JSON))
+
+typedef void (*CpuFreqListener)(uint32_t mhz);
+
+class CpuFreq {
+private:
+    uint8_t boostDepth;
+    uint8_t apbLocks;
+    bool radioOn;
+    bool waiting;
+    uint32_t currentMhz;
+    CpuFreqListener listener;
+
+    // Residency per clock, switch count and cost
+    uint32_t residencyMs[3];        // min, idle, boost
+    uint32_t since;
+    uint32_t switches;
+    uint32_t switchUsTotal;
+    uint32_t switchUsMax;
+
+    int slotOf(uint32_t mhz) {
+        if (mhz >= CPU_BOOST_MHZ) return 2;
+        if (mhz >= CPU_IDLE_MHZ) return 1;
+        return 0;
+    }
+
+    bool hostAttached() {
+        #if ARDUINO_USB_CDC_ON_BOOT
+        return (bool)Serial;    // USB-Serial/JTAG needs the PLL
+        #else
+        return false;
+        #endif
+    }
+
+    uint32_t target() {
+        if (boostDepth > 0) return CPU_BOOST_MHZ;
+        if (waiting && !radioOn && apbLocks == 0 && !hostAttached()) return CPU_MIN_MHZ;
+        return CPU_IDLE_MHZ;
+    }
+
+    void apply() {
+        if (currentMhz == 0) return;    // Not started, setup owns the clock
+        uint32_t want = target();
+        if (want == currentMhz) return;
+
+        uint32_t now = millis();
+        residencyMs[slotOf(currentMhz)] += now - since;
+        since = now;
+
+        uint32_t t0 = micros();
+        setCpuFrequencyMhz(want);
+        uint32_t took = micros() - t0;
+
+        currentMhz = want;
+        switches++;
+        switchUsTotal += took;
+        if (took > switchUsMax) switchUsMax = took;
+        if (listener) listener(want);
+    }
+
+public:
+    CpuFreq() : boostDepth(0), apbLocks(0), radioOn(false), waiting(false),
+                currentMhz(0), listener(nullptr), since(0), switches(0), switchUsTotal(0), switchUsMax(0) {
+        memset(residencyMs, 0, sizeof(residencyMs));
+    }
+
+    // Take over from the boot clock (setup runs at full speed)
+    void begin() {
+        currentMhz = getCpuFrequencyMhz();
+        since = millis();
+        apply();
+        Serial.printf("[CPU] %lu MHz idle, %lu MHz boost, APB %lu MHz\n",
+                      (unsigned long)CPU_IDLE_MHZ, (unsigned long)CPU_BOOST_MHZ,
+                      (unsigned long)(getApbFrequency() / 1000000));
+    }
+
+    void boost() {
+        boostDepth++;
+        apply();
+    }
+
+    void unboost() {
+        if (boostDepth > 0) boostDepth--;
+        apply();
+    }
+
+    void lockApb() {
+        apbLocks++;
+        apply();
+    }
+
+    void unlockApb() {
+        if (apbLocks > 0) apbLocks--;
+        apply();
+    }
+
+    void setRadio(bool on) {
+        radioOn = on;
+        apply();
+    }
+
+    // Frame wait in the main loop: the only place CPU_MIN_MHZ can apply
+    void beginWait() {
+        waiting = true;
+        apply();
+    }
+
+    void endWait() {
+        waiting = false;
+        apply();
+    }
+
+    void setListener(CpuFreqListener fn) { listener = fn; }
+    bool isBoosted() { return boostDepth > 0; }
+    uint32_t mhz() { return currentMhz; }
+
+    // Per clock: switch latency in, JSON parse time, then an idle hold so
+    // an external meter can read the current. Restores the managed clock.
+    void runBench() {
+        static const uint32_t clocks[] = { 80, 160, 240 };
+        Serial.println(F("\n[Bench] MHz  switch(us)  parse(us)  (idle hold for meter)"));
+
+        for (uint32_t mhz : clocks) {
+            uint32_t t0 = micros();
+            setCpuFrequencyMhz(mhz);
+            uint32_t switchUs = micros() - t0;
+
+            // From the arena, like the cloud replies this stands in for
+            JsonArenaScope arena;
+            ArenaJsonDocument doc(CPU_BENCH_JSON_CAP);
+            DeserializationError err;
+            t0 = micros();
+            for (int i = 0; i < CPU_BENCH_PARSES; i++) {
+                err = deserializeJson(doc, CPU_BENCH_JSON);
+            }
+            uint32_t parseUs = (micros() - t0) / CPU_BENCH_PARSES;
+            if (!jsonArena.parsed(err, "cpu bench")) break;
+
+            Serial.printf("[Bench] %3lu  %10lu  %9lu\n", (unsigned long)mhz,
+                          (unsigned long)switchUs, (unsigned long)parseUs);
+            Serial.flush();
+            delay(CPU_BENCH_HOLD_MS);
+        }
+
+        setCpuFrequencyMhz(currentMhz);
+    }
+
+    void print() {
+        uint32_t res[3];
+        memcpy(res, residencyMs, sizeof(res));
+        res[slotOf(currentMhz)] += millis() - since;
+
+        Serial.printf("[CPU] Now %lu MHz, %lu switches, avg %lu us, max %lu us\n",
+                      (unsigned long)currentMhz, (unsigned long)switches,
+                      (unsigned long)(switches ? switchUsTotal / switches : 0),
+                      (unsigned long)switchUsMax);
+        if (CPU_MIN_MHZ < CPU_IDLE_MHZ) {
+            Serial.printf("  %3lu MHz: %lu s\n", (unsigned long)CPU_MIN_MHZ, (unsigned long)(res[0] / 1000));
+        }
+        Serial.printf("  %3lu MHz: %lu s\n", (unsigned long)CPU_IDLE_MHZ, (unsigned long)(res[1] / 1000));
+        Serial.printf("  %3lu MHz: %lu s\n", (unsigned long)CPU_BOOST_MHZ, (unsigned long)(res[2] / 1000));
+    }
+};
+
+extern CpuFreq cpu;
+
+// Scoped boost: CpuBoost boost; ... work ...
+struct CpuBoost {
+    CpuBoost() { cpu.boost(); }
+    ~CpuBoost() { cpu.unboost(); }
+};
+
+// Scoped APB hold for clock-sensitive peripherals
+struct ApbLock {
+    ApbLock() { cpu.lockApb(); }
+    ~ApbLock() { cpu.unlockApb(); }
+};
+
+#endif // CPUFREQ_H
@@ -16,6 +16,7 @@
 #include "config.h"
 #include "soul.h"
 #include "hardware.h"
+#include "cpufreq.h"
 
 // CloudStatus struct is defined in cloud.h (included before display.h in main.cpp)
 
@@ -161,6 +162,17 @@ const FaceDef FACES[] = {
     { EYE_NORMAL, EYE_CLOSED, MOUTH_SMILE, 0, 0, 0 },         // WINK
 };
 
+// ============================================================================
+// PANEL POWER
+// ============================================================================
+enum PanelState { PANEL_ON, PANEL_DIM, PANEL_OFF };
+enum Brightness { BRIGHT_LOW, BRIGHT_NORMAL, BRIGHT_HIGH };
+
+static const uint8_t CONTRAST_LEVELS[] = { CONTRAST_LOW, CONTRAST_NORMAL, CONTRAST_HIGH };
+
+// Static elements walk a 2x2 square, one step per PIXEL_SHIFT_MS
+static const int8_t PIXEL_SHIFT[4][2] = { {0, 0}, {1, 0}, {1, 1}, {0, 1} };
+
 // ============================================================================
 // DISPLAY CLASS
 // ============================================================================
@@ -184,10 +196,33 @@ private:
     // Smooth animation
     float eyeOffsetX, eyeOffsetY;  // For look-around animation
     float targetOffsetX, targetOffsetY;
+    bool idle;                     // Napping between blinks: no look-around
+    bool lookAround;               // Idle eye movement (off on low battery)
+
+    // Panel power
+    PanelState panel;
+    uint8_t brightness;
+
+    // Frame buffer out over I2C, with APB held at 80 MHz for the transfer
+    void show() {
+        ApbLock apb;
+        oled->display();
+    }
+
+    void setContrast(uint8_t value) {
+        oled->ssd1306_command(SSD1306_SETCONTRAST);
+        oled->ssd1306_command(value);
+    }
+
+    // Offset for static elements (title bar, status line) against burn-in
+    int8_t shiftX() { return PIXEL_SHIFT[(millis() / PIXEL_SHIFT_MS) % 4][0]; }
+    int8_t shiftY() { return PIXEL_SHIFT[(millis() / PIXEL_SHIFT_MS) % 4][1]; }
 
 public:
     Display() : initialized(false), currentExpr(EXPR_NEUTRAL), targetExpr(EXPR_NEUTRAL),
-                isBlinking(false), blinkFrame(0), eyeOffsetX(0), eyeOffsetY(0) {
+                isBlinking(false), blinkFrame(0), eyeOffsetX(0), eyeOffsetY(0),
+                targetOffsetX(0), targetOffsetY(0), idle(false), lookAround(true),
+                panel(PANEL_ON), brightness(BRIGHT_NORMAL) {
         lastBlink = millis();
         blinkInterval = random(BLINK_MIN_MS, BLINK_MAX_MS);
         messageExpires = 0;
@@ -201,6 +236,8 @@ public:
         }
         oled->setTextColor(SSD1306_WHITE);
         oled->setTextSize(1);
+        setContrast(CONTRAST_LEVELS[brightness]);
+        panel = PANEL_ON;
         initialized = true;
         Serial.println(F("[Display] OLED initialized"));
         return true;
@@ -208,6 +245,31 @@ public:
 
     bool isReady() { return initialized; }
 
+    // ========================================================================
+    // PANEL POWER
+    // ========================================================================
+    void setPanel(PanelState state) {
+        if (!initialized || state == panel) return;
+        if (state == PANEL_OFF) {
+            oled->ssd1306_command(SSD1306_DISPLAYOFF);
+        } else {
+            if (panel == PANEL_OFF) oled->ssd1306_command(SSD1306_DISPLAYON);
+            setContrast(state == PANEL_DIM ? CONTRAST_DIM : CONTRAST_LEVELS[brightness]);
+        }
+        panel = state;
+    }
+
+    PanelState getPanel() { return panel; }
+    bool isLit() { return initialized && panel != PANEL_OFF; }
+
+    void setBrightness(uint8_t level) {
+        if (level > BRIGHT_HIGH) level = BRIGHT_HIGH;
+        brightness = level;
+        if (initialized && panel == PANEL_ON) setContrast(CONTRAST_LEVELS[brightness]);
+    }
+
+    uint8_t getBrightness() { return brightness; }
+
     // ========================================================================
     // EXPRESSION CONTROL
     // ========================================================================
@@ -266,7 +328,7 @@ public:
         // Smooth eye movement (idle animation)
         #ifdef FEATURE_ANIMATIONS
         static unsigned long lastMove = 0;
-        if (now - lastMove > 2000 + random(3000)) {
+        if (!idle && lookAround && now - lastMove > 2000 + random(3000)) {
             targetOffsetX = random(-3, 4);
             targetOffsetY = random(-2, 3);
             lastMove = now;
@@ -276,6 +338,31 @@ public:
         #endif
     }
 
+    // ========================================================================
+    // IDLE SCHEDULING
+    // ========================================================================
+    // Something still moving on screen that needs frames at full rate?
+    bool isAnimating() {
+        if (isBlinking || messageExpires > 0) return true;
+        return fabsf(targetOffsetX - eyeOffsetX) > 0.5f ||
+               fabsf(targetOffsetY - eyeOffsetY) > 0.5f;
+    }
+
+    // Time until the next frame that changes the picture (the next blink)
+    unsigned long msUntilNextChange() {
+        if (panel == PANEL_OFF) return SLEEP_TIMEOUT_MS;  // Nothing to draw
+        if (isAnimating()) return 0;
+        unsigned long elapsed = millis() - lastBlink;
+        return elapsed >= blinkInterval ? 0 : blinkInterval - elapsed;
+    }
+
+    void setIdle(bool on) { idle = on; }
+    void setLookAround(bool on) {
+        lookAround = on;
+        if (!on) targetOffsetX = targetOffsetY = 0;
+    }
+    bool isIdle() { return idle; }
+
     // ========================================================================
     // MESSAGE DISPLAY
     // ========================================================================
@@ -353,14 +440,16 @@ public:
         if (!initialized) return;
 
         oled->clearDisplay();
+        int8_t sx = shiftX();
+        int8_t sy = shiftY();
 
         // Title bar
-        oled->setCursor(0, 0);
+        oled->setCursor(sx, sy);
         oled->print(F("APEX "));
         oled->print(soul.getAgentName());
 
         // Status icons (right side)
-        oled->setCursor(100, 0);
+        oled->setCursor(100 + sx, sy);
         if (hw.battery_available) {
             uint8_t batt = getBatteryPercent();
             if (batt != 255) {
@@ -369,18 +458,18 @@ public:
                 else oled->print(F("!"));
             }
         }
-        oled->setCursor(110, 0);
+        oled->setCursor(110 + sx, sy);
         if (cloudConnected) oled->print(F("C"));
         else if (wifiConnected) oled->print(F("W"));
         else oled->print(F("X"));
 
         // Billing/auth indicators (flash on face screen)
         if (!billingOk && (millis() / 500) % 2 == 0) {
-            oled->setCursor(118, 0);
+            oled->setCursor(118 + sx, sy);
             oled->print(F("$"));
         }
         if (!tokenValid && (millis() / 500) % 2 == 0) {
-            oled->setCursor(118, 0);
+            oled->setCursor(118 + sx, sy);
             oled->print(F("!"));
         }
 
@@ -388,7 +477,7 @@ public:
         if (hw.battery_available) {
             uint8_t batt = getBatteryPercent();
             if (batt != 255 && batt <= 20) {
-                oled->setCursor(85, 0);
+                oled->setCursor(85 + sx, sy);
                 oled->print(batt);
                 oled->print(F("%"));
             }
@@ -410,40 +499,43 @@ public:
                 oled->print(messageText.substring(21, 42));
             }
         } else {
-            // Status line
-            oled->setCursor(0, 56);
+            // Status line: 8 px tall, so 56 is the lowest row that fits
+            oled->setCursor(sx, 55 + sy);
             char buf[24];
             snprintf(buf, sizeof(buf), "E:%.1f %s", soul.getE(), soul.getStateName());
             oled->print(buf);
         }
 
-        oled->display();
+        show();
     }
 
     void renderStatusScreen(Soul& soul, bool wifiConnected, bool cloudConnected,
                             int toolsAvailable, int msgsUsed = 0, int msgsLimit = 0,
-                            const char* tierName = "unknown") {
+                            const char* tierName = "unknown",
+                            const char* powerLine = nullptr) {
         if (!initialized) return;
 
         oled->clearDisplay();
-        oled->setCursor(0, 0);
+        int8_t sx = shiftX();
+        int8_t sy = shiftY();
+        oled->setCursor(sx, sy);
         oled->println(F("=== APEXPOCKET MAX ==="));
 
-        oled->setCursor(0, 12);
+        oled->setCursor(sx, 12 + sy);
         oled->print(F("E: ")); oled->print(soul.getE(), 1);
         oled->print(F(" Fl: ")); oled->println(soul.getFloor(), 1);
 
-        oled->setCursor(0, 22);
+        oled->setCursor(sx, 22 + sy);
         oled->print(F("Peak: ")); oled->print(soul.getPeak(), 1);
         oled->print(F(" ")); oled->println(soul.getStateName());
 
-        oled->setCursor(0, 32);
+        oled->setCursor(sx, 32 + sy);
         oled->print(F("Agent: "));
         oled->print(soul.getAgentName());
         oled->print(F("  v"));
         oled->println(FW_VERSION);
 
-        oled->setCursor(0, 42);
+        oled->setCursor(sx, 42 + sy);
         oled->print(F("Cloud: "));
         if (cloudConnected) {
             oled->println(F("Connected"));
@@ -451,8 +543,10 @@ public:
             oled->println(wifiConnected ? F("Disconnected") : F("No WiFi"));
         }
 
-        oled->setCursor(0, 52);
-        if (msgsLimit > 0) {
+        oled->setCursor(sx, 52 + sy);
+        if (powerLine) {
+            oled->print(powerLine);
+        } else if (msgsLimit > 0) {
             char buf[22];
             snprintf(buf, sizeof(buf), "Msgs: %d/%d (%s)", msgsUsed, msgsLimit, tierName);
             oled->print(buf);
@@ -469,7 +563,7 @@ public:
             }
         }
 
-        oled->display();
+        show();
     }
 
     void renderCloudScreen(CloudStatus* cs, const char* cloudUrl, const char* deviceToken) {
@@ -528,7 +622,7 @@ public:
             oled->print(motdBuf);
         }
 
-        oled->display();
+        show();
     }
 
     void renderAgentScreen(Soul& soul) {
@@ -551,7 +645,7 @@ public:
 
         oled->setCursor(0, 56);
         oled->print(F("[A]Select [B]Back"));
-        oled->display();
+        show();
     }
 
     void renderBootScreen() {
@@ -563,7 +657,7 @@ public:
         oled->println(F("APEXPOCKET MAX"));
         oled->setCursor(20, 35);
         oled->println(F("Initializing..."));
-        oled->display();
+        show();
     }
 
     void renderSleepScreen(Soul& soul) {
@@ -575,7 +669,7 @@ public:
         oled->print(F("E:"));
         oled->print(soul.getE(), 1);
         oled->print(F(" Sleeping..."));
-        oled->display();
+        show();
     }
 
     // Direct access for custom drawing
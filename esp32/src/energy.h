@@ -0,0 +1,281 @@
+/*
+ * Energy Accounting
+ *
+ * Integrates the time each subsystem spends switched on and multiplies it
+ * by the current coefficients in config.h. Rails are additive: CPU awake,
+ * radio and OLED are counted independently, light/deep sleep replace the
+ * CPU rail while they are on. TLS handshakes are counted as events with a
+ * fixed charge each.
+ *
+ * Charge is summed as integer uA x ms and time as integer ms, both 64-bit:
+ * a frame or nap adds a few nAh, which a float total of weeks would round
+ * away, and a 32-bit ms count wraps after 49.7 days.
+ *
+ * Totals live in RTC memory across deep sleep and in LittleFS across power
+ * loss. They restart when the battery reads full at cold boot, so the
+ * figures mean "since last charge".
+ */
+
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <ArduinoJson.h>
+#include <sys/time.h>
+#include "config.h"
+#include "hardware.h"
+
+#define ENERGY_MAGIC    0xE7E7      // Bumped with the layout: an old file is dropped
+#define UAMS_PER_UAH    3600000ULL
+#define ENERGY_FILE     "/energy.bin"
+
+enum EnergyRail {
+    RAIL_CPU,
+    RAIL_LIGHT_SLEEP,
+    RAIL_DEEP_SLEEP,
+    RAIL_WIFI_IDLE,     // Associated, modem sleep
+    RAIL_WIFI_ACTIVE,   // Associating or transferring
+    RAIL_OLED,
+    RAIL_TLS,           // Event rail: handshakes, not time
+    RAIL_CPU_BOOST,     // On top of RAIL_CPU while at CPU_BOOST_MHZ
+    RAIL_COUNT
+};
+
+static const char* const RAIL_NAMES[RAIL_COUNT] = {
+    "cpu", "light_sleep", "deep_sleep", "wifi_idle", "wifi_active", "oled", "tls",
+    "cpu_boost"
+};
+
+struct EnergyTotals {
+    uint16_t magic;
+    bool oledLit;                   // OLED left on through deep sleep
+    uint64_t uAms[RAIL_COUNT];      // Charge, exact: UAMS_PER_UAH per uAh
+    uint64_t onMs[RAIL_COUNT];      // Handshake count for RAIL_TLS
+    uint64_t trackedMs;             // Wall time the totals cover
+    int64_t sleepStartUs;           // Wall clock at deep sleep entry
+};
+
+extern EnergyTotals energyTotals;   // RTC_DATA_ATTR, defined in main.cpp
+
+class EnergyMeter {
+private:
+    bool on[RAIL_COUNT];
+    uint32_t since[RAIL_COUNT];
+    uint32_t lastTick;
+
+    // Current per rail in uA (uAh per event for RAIL_TLS)
+    static uint32_t coefficient(int rail) {
+        switch (rail) {
+            case RAIL_CPU:         return CURRENT_AWAKE_MA * 1000;
+            case RAIL_LIGHT_SLEEP: return CURRENT_LIGHT_SLEEP_UA;
+            case RAIL_DEEP_SLEEP:  return CURRENT_DEEP_SLEEP_UA;
+            case RAIL_WIFI_IDLE:   return CURRENT_WIFI_IDLE_MA * 1000;
+            case RAIL_WIFI_ACTIVE: return (CURRENT_WIFI_MA - CURRENT_AWAKE_MA) * 1000;
+            case RAIL_OLED:        return CURRENT_OLED_MA * 1000;
+            case RAIL_TLS:         return CHARGE_TLS_UAH;
+            case RAIL_CPU_BOOST:   return CURRENT_BOOST_MA * 1000;
+        }
+        return 0;
+    }
+
+    static int64_t wallUs() {
+        struct timeval tv;
+        gettimeofday(&tv, nullptr);
+        return (int64_t)tv.tv_sec * 1000000LL + tv.tv_usec;
+    }
+
+    bool load() {
+        #if USE_LITTLEFS
+        if (!hw.littlefs_available || !LittleFS.exists(ENERGY_FILE)) return false;
+        File f = LittleFS.open(ENERGY_FILE, "r");
+        if (!f) return false;
+        EnergyTotals t;
+        bool ok = f.read((uint8_t*)&t, sizeof(t)) == sizeof(t) && t.magic == ENERGY_MAGIC;
+        f.close();
+        if (ok) energyTotals = t;
+        return ok;
+        #else
+        return false;
+        #endif
+    }
+
+public:
+    EnergyMeter() : lastTick(0) {
+        memset(on, 0, sizeof(on));
+        memset(since, 0, sizeof(since));
+    }
+
+    // Zero the totals (battery swapped/charged, factory reset)
+    void reset() {
+        memset(&energyTotals, 0, sizeof(EnergyTotals));
+        energyTotals.magic = ENERGY_MAGIC;
+    }
+
+    // Call once storage is up. On a wake from deep sleep the RTC totals are
+    // kept and the sleep itself is booked from the wall clock.
+    void begin(bool coldBoot) {
+        uint32_t now = millis();
+        lastTick = now;
+        for (int i = 0; i < RAIL_COUNT; i++) {
+            on[i] = false;
+            since[i] = now;
+        }
+        on[RAIL_CPU] = true;
+
+        if (coldBoot || energyTotals.magic != ENERGY_MAGIC) {
+            uint16_t mv = readBatteryMV();
+            bool full = mv > 0 && mv >= BATTERY_FULL_MV - 50;
+            if (full || !load()) {
+                reset();
+                Serial.println(F("[Energy] Totals reset"));
+            }
+            return;
+        }
+
+        // Time before app start (ROM, bootloader) is booked as sleep too
+        int64_t sleptUs = wallUs() - energyTotals.sleepStartUs - (int64_t)now * 1000;
+        if (energyTotals.sleepStartUs > 0 && sleptUs > 0) {
+            uint32_t sleptMs = (uint32_t)(sleptUs / 1000);
+            add(RAIL_DEEP_SLEEP, sleptMs);
+            if (energyTotals.oledLit) add(RAIL_OLED, sleptMs);
+            energyTotals.trackedMs += sleptMs;
+        }
+        energyTotals.sleepStartUs = 0;
+        on[RAIL_OLED] = energyTotals.oledLit;
+    }
+
+    void set(EnergyRail rail, bool state) {
+        if (on[rail] == state) return;
+        fold();
+        on[rail] = state;
+    }
+
+    // Book an interval measured elsewhere
+    void add(EnergyRail rail, uint32_t ms) {
+        energyTotals.onMs[rail] += ms;
+        energyTotals.uAms[rail] += (uint64_t)ms * coefficient(rail);
+    }
+
+    // Book one event on an event rail
+    void count(EnergyRail rail) {
+        energyTotals.onMs[rail]++;
+        energyTotals.uAms[rail] += coefficient(rail) * UAMS_PER_UAH;
+    }
+
+    // Bring running rails up to now
+    void fold() {
+        uint32_t now = millis();
+        for (int i = 0; i < RAIL_COUNT; i++) {
+            if (on[i] && i != RAIL_TLS) add((EnergyRail)i, now - since[i]);
+            since[i] = now;
+        }
+        energyTotals.trackedMs += now - lastTick;
+        lastTick = now;
+    }
+
+    // Stamp the wall clock so the next wake can book the sleep
+    void beforeDeepSleep(bool oledLit) {
+        fold();
+        energyTotals.oledLit = oledLit;
+        energyTotals.sleepStartUs = wallUs();
+    }
+
+    bool save() {
+        #if USE_LITTLEFS
+        if (!hw.littlefs_available) return false;
+        fold();
+        File f = LittleFS.open(ENERGY_FILE, "w");
+        if (!f) return false;
+        bool ok = f.write((const uint8_t*)&energyTotals, sizeof(EnergyTotals)) == sizeof(EnergyTotals);
+        f.close();
+        return ok;
+        #else
+        return false;
+        #endif
+    }
+
+    // ========================================================================
+    // ESTIMATES
+    // ========================================================================
+    float railMAh(int rail) { return energyTotals.uAms[rail] / (UAMS_PER_UAH * 1000.0); }
+
+    float totalMAh() {
+        uint64_t sum = 0;
+        for (int i = 0; i < RAIL_COUNT; i++) sum += energyTotals.uAms[i];
+        return sum / (UAMS_PER_UAH * 1000.0);
+    }
+
+    float trackedH() { return energyTotals.trackedMs / 3600000.0; }
+
+    // Average draw over the tracked period
+    float averageMA() {
+        float h = trackedH();
+        if (h < 0.01f) return 0;
+        return totalMAh() / h;
+    }
+
+    // Hours left at the average draw, -1 if unknown
+    float remainingHours() {
+        uint8_t pct = getBatteryPercent();
+        float avg = averageMA();
+        if (pct == 255 || avg <= 0) return -1;
+        return (pct / 100.0f) * BATTERY_CAPACITY_MAH / avg;
+    }
+
+    // Status screen line: 0 = total/estimate, 1 = per-subsystem split
+    void formatLine(int page, char* buf, size_t len) {
+        fold();
+        if (page == 0) {
+            float h = remainingHours();
+            if (h >= 0) {
+                snprintf(buf, len, "%.1fmAh %.1fmA ~%.0fh", totalMAh(), averageMA(), h);
+            } else {
+                snprintf(buf, len, "%.1fmAh %.1fmA avg", totalMAh(), averageMA());
+            }
+        } else {
+            float wifi = railMAh(RAIL_WIFI_IDLE) + railMAh(RAIL_WIFI_ACTIVE) + railMAh(RAIL_TLS);
+            float sleep = railMAh(RAIL_LIGHT_SLEEP) + railMAh(RAIL_DEEP_SLEEP);
+            snprintf(buf, len, "C%.0f W%.0f O%.0f S%.0f",
+                     railMAh(RAIL_CPU) + railMAh(RAIL_CPU_BOOST), wifi, railMAh(RAIL_OLED), sleep);
+        }
+    }
+
+    void print() {
+        fold();
+        Serial.println(F("\n[Energy] Rail          time(s)    mAh"));
+        for (int i = 0; i < RAIL_COUNT; i++) {
+            if (i == RAIL_TLS) {
+                Serial.printf("  %-14s %7lu x  %6.2f\n", RAIL_NAMES[i],
+                              (unsigned long)energyTotals.onMs[i], railMAh(i));
+            } else {
+                Serial.printf("  %-14s %9lu  %6.2f\n", RAIL_NAMES[i],
+                              (unsigned long)(energyTotals.onMs[i] / 1000), railMAh(i));
+            }
+        }
+        Serial.printf("  Total %.2f mAh over %.1f h, avg %.2f mA", totalMAh(),
+                      trackedH(), averageMA());
+        float h = remainingHours();
+        if (h >= 0) Serial.printf(", ~%.0f h left", h);
+        Serial.println();
+    }
+
+    // Sync telemetry: mAh per rail plus the estimate (ENERGY_JSON_SIZE)
+    void toJson(JsonObject obj) {
+        fold();
+        for (int i = 0; i < RAIL_COUNT; i++) {
+            obj[RAIL_NAMES[i]] = railMAh(i);
+        }
+        obj["tls_handshakes"] = (uint32_t)energyTotals.onMs[RAIL_TLS];
+        obj["tracked_h"] = trackedH();
+        obj["avg_ma"] = averageMA();
+        obj["remaining_h"] = remainingHours();
+    }
+};
+
+// JSON pool toJson() needs: a member per rail and four totals
+#define ENERGY_JSON_SIZE    JSON_OBJECT_SIZE(RAIL_COUNT + 4)
+
+extern EnergyMeter energy;
+
+#endif // ENERGY_H
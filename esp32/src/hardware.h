@@ -13,13 +13,17 @@
 #include <Arduino.h>
 #include <Wire.h>
 #include "config.h"
+#include "melody.h"
+#include "log.h"
 
 #if USE_LITTLEFS
 #include <LittleFS.h>
 #endif
 
-#ifdef FEATURE_DEEPSLEEP
+#if defined(FEATURE_DEEPSLEEP) || defined(FEATURE_LIGHTSLEEP)
 #include "esp_sleep.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
 #endif
 
 // ============================================================================
@@ -46,8 +50,37 @@ struct HardwareStatus {
 extern HardwareStatus hw;
 
 // ============================================================================
-// I2C SCANNER
+// I2C DISCOVERY
 // ============================================================================
+// Only the OLED and the EEPROM matter, so normal boots probe those addresses
+// directly. The result is cached in RTC slow memory; a wake from deep sleep
+// re-verifies the cached devices instead of walking the whole bus. The full
+// 1..126 scan runs on cold boot or on request (/i2c).
+
+#define I2C_TOPOLOGY_MAGIC  0x12C7
+
+struct I2CTopology {
+    uint16_t magic;
+    bool oled_found;
+    bool eeprom_found;
+    uint8_t eeprom_addr;
+};
+
+extern I2CTopology i2cTopology;     // RTC_DATA_ATTR, defined in main.cpp
+
+inline bool isColdBoot() {
+    #ifdef FEATURE_DEEPSLEEP
+    return esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_UNDEFINED;
+    #else
+    return true;
+    #endif
+}
+
+inline bool probeI2C(uint8_t addr) {
+    Wire.beginTransmission(addr);
+    return Wire.endTransmission() == 0;
+}
+
 inline void scanI2C() {
     Serial.println(F("[I2C] Scanning bus..."));
 
@@ -55,8 +88,7 @@ inline void scanI2C() {
     hw.eeprom_found = false;
 
     for (uint8_t addr = 1; addr < 127; addr++) {
-        Wire.beginTransmission(addr);
-        if (Wire.endTransmission() == 0) {
+        if (probeI2C(addr)) {
             Serial.print(F("  Found: 0x"));
             Serial.println(addr, HEX);
 
@@ -74,20 +106,61 @@ inline void scanI2C() {
     }
 }
 
+// Probe just the known addresses (3 transactions instead of 126)
+inline void probeKnownI2C() {
+    hw.oled_found = probeI2C(I2C_ADDR_OLED);
+    hw.eeprom_found = false;
+    if (probeI2C(I2C_ADDR_EEPROM)) {
+        hw.eeprom_found = true;
+        hw.eeprom_addr = I2C_ADDR_EEPROM;
+    } else if (probeI2C(I2C_ADDR_EEPROM_ALT)) {
+        hw.eeprom_found = true;
+        hw.eeprom_addr = I2C_ADDR_EEPROM_ALT;
+    }
+}
+
+inline void detectI2C(bool fullScan) {
+    Wire.setClock(I2C_CLOCK_HZ);
+
+    if (fullScan) {
+        scanI2C();
+    } else if (i2cTopology.magic == I2C_TOPOLOGY_MAGIC) {
+        // Wake from sleep: confirm the cached devices still answer
+        hw.oled_found = i2cTopology.oled_found && probeI2C(I2C_ADDR_OLED);
+        hw.eeprom_found = i2cTopology.eeprom_found && probeI2C(i2cTopology.eeprom_addr);
+        hw.eeprom_addr = i2cTopology.eeprom_addr;
+        if (hw.oled_found != i2cTopology.oled_found ||
+            hw.eeprom_found != i2cTopology.eeprom_found) {
+            Serial.println(F("[I2C] Cached topology stale, re-probing"));
+            probeKnownI2C();
+        }
+    } else {
+        probeKnownI2C();
+    }
+
+    if (!fullScan) {
+        Serial.printf("[I2C] OLED %s, EEPROM %s\n",
+                      hw.oled_found ? "ok" : "missing",
+                      hw.eeprom_found ? "ok" : "missing");
+    }
+
+    i2cTopology.magic = I2C_TOPOLOGY_MAGIC;
+    i2cTopology.oled_found = hw.oled_found;
+    i2cTopology.eeprom_found = hw.eeprom_found;
+    i2cTopology.eeprom_addr = hw.eeprom_addr;
+}
+
 // Forward declaration
 inline void printHardwareStatus();
 
 // ============================================================================
 // HARDWARE INITIALIZATION
 // ============================================================================
-inline void initHardware() {
-    Serial.println(F("\n[Hardware] Detecting components..."));
-
-    // Get chip info
+inline void initChipInfo() {
     #ifdef ESP32
         strcpy(hw.chip_model, ESP.getChipModel());
         hw.heap_size = ESP.getHeapSize();
-        #ifdef HAS_PSRAM
+        #if HAS_PSRAM
             hw.psram_available = psramFound();
             hw.psram_size = hw.psram_available ? ESP.getPsramSize() : 0;
         #else
@@ -100,14 +173,12 @@ inline void initHardware() {
         hw.psram_available = false;
         hw.psram_size = 0;
     #endif
+}
 
-    // I2C scan
-    Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL);
-    scanI2C();
-
+inline void initPins() {
     // Check buzzer (just configure the pin)
     #ifdef FEATURE_BUZZER
-        pinMode(PIN_BUZZER, OUTPUT);
+        audioBegin(PIN_BUZZER);
         hw.buzzer_available = true;
     #else
         hw.buzzer_available = false;
@@ -138,18 +209,45 @@ inline void initHardware() {
 
     // WiFi check happens during connection
     hw.wifi_available = true;  // Assume yes, verify on connect
+}
 
-    // LittleFS
+inline void mountLittleFS() {
     #if USE_LITTLEFS
         hw.littlefs_available = LittleFS.begin(true);
     #else
         hw.littlefs_available = false;
     #endif
+}
+
+inline void initHardware() {
+    Serial.println(F("\n[Hardware] Detecting components..."));
+
+    // Get chip info
+    initChipInfo();
+
+    // I2C discovery (full scan only on cold boot)
+    Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL);
+    detectI2C(isColdBoot());
+
+    initPins();
+
+    // LittleFS
+    mountLittleFS();
 
     // Print summary
     printHardwareStatus();
 }
 
+// Button wake from deep sleep: cached I2C topology, pins, nothing else.
+// LittleFS is mounted afterwards from the main loop.
+inline void initHardwareFast() {
+    initChipInfo();
+    Wire.begin(PIN_I2C_SDA, PIN_I2C_SCL);
+    detectI2C(false);
+    initPins();
+    hw.littlefs_available = false;
+}
+
 // ============================================================================
 // STATUS DISPLAY
 // ============================================================================
@@ -186,40 +284,32 @@ inline void printHardwareStatus() {
 // ============================================================================
 // BUZZER FUNCTIONS (with fallback)
 // ============================================================================
-inline void playTone(uint16_t freq, uint16_t duration_ms) {
+// All sounds go through the sequencer in audio.h and return immediately.
+inline void playTone(uint16_t freq, uint16_t duration_ms,
+                     SoundPriority prio = PRIO_UI) {
     #ifdef FEATURE_BUZZER
     if (hw.buzzer_available) {
-        tone(PIN_BUZZER, freq, duration_ms);
+        audioTone(freq, duration_ms, prio);
     }
     #endif
 }
 
-inline void playLove() { playTone(TONE_LOVE, 100); }
-inline void playPoke() { playTone(TONE_POKE, 50); }
-inline void playBoot() {
-    playTone(TONE_BOOT, 100);
-    delay(120);
-    playTone(TONE_BOOT * 1.25, 100);
-    delay(120);
-    playTone(TONE_BOOT * 1.5, 150);
-}
-inline void playError() { playTone(TONE_ERROR, 200); }
-inline void playSync() { playTone(TONE_SYNC, 150); }
+inline void playLove() { playTone(TONE_LOVE, 100, PRIO_EVENT); }
+inline void playPoke() { playTone(TONE_POKE, 50, PRIO_EVENT); }
+inline void playError() { playTone(TONE_ERROR, 200, PRIO_ALERT); }
+inline void playSync() { playTone(TONE_SYNC, 150, PRIO_EVENT); }
 
-inline void playMelody(const uint16_t* notes, const uint16_t* durations, int count) {
+inline void playMelody(const MelodyRef& melody, SoundPriority prio = PRIO_EVENT) {
     #ifdef FEATURE_BUZZER
     if (hw.buzzer_available) {
-        for (int i = 0; i < count; i++) {
-            if (notes[i] > 0) {
-                tone(PIN_BUZZER, notes[i], durations[i]);
-            }
-            delay(durations[i] * 1.1);
-        }
-        noTone(PIN_BUZZER);
+        AudioNote seq[AUDIO_QUEUE_LEN];
+        audioPlay(seq, melodyExpand(melody, seq), prio);
     }
     #endif
 }
 
+inline void playBoot() { playMelody(MELODY_BOOT); }
+
 // ============================================================================
 // BATTERY FUNCTIONS (with fallback)
 // ============================================================================
@@ -238,14 +328,17 @@ inline uint16_t readBatteryMV() {
     return 0;  // Unknown
 }
 
-inline uint8_t getBatteryPercent() {
-    uint16_t mv = readBatteryMV();
+inline uint8_t batteryPercentOf(uint16_t mv) {
     if (mv == 0) return 255;  // Unknown
     if (mv >= BATTERY_FULL_MV) return 100;
     if (mv <= BATTERY_EMPTY_MV) return 0;
     return (uint8_t)(((mv - BATTERY_EMPTY_MV) * 100) / (BATTERY_FULL_MV - BATTERY_EMPTY_MV));
 }
 
+inline uint8_t getBatteryPercent() {
+    return batteryPercentOf(readBatteryMV());
+}
+
 inline const char* getBatteryIcon() {
     uint8_t pct = getBatteryPercent();
     if (pct == 255) return "?";
@@ -282,23 +375,59 @@ inline void ledBlink(int count, int onTime = 50, int offTime = 50) {
     #endif
 }
 
+// ============================================================================
+// LIGHT SLEEP
+// ============================================================================
+// Naps between frames while idle. RAM, GPIO state and the OLED's own frame
+// buffer are kept, so the face stays on screen. Either button (level low)
+// or the timer wakes the CPU. Returns the time actually slept.
+inline uint32_t lightSleep(uint32_t ms) {
+    #ifdef FEATURE_LIGHTSLEEP
+    int64_t start = esp_timer_get_time();
+
+    gpio_wakeup_enable((gpio_num_t)PIN_BTN_A, GPIO_INTR_LOW_LEVEL);
+    gpio_wakeup_enable((gpio_num_t)PIN_BTN_B, GPIO_INTR_LOW_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+    esp_sleep_enable_timer_wakeup((uint64_t)ms * 1000ULL);
+
+    esp_light_sleep_start();
+
+    // Don't leak these sources into the deep sleep configuration
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_TIMER);
+    esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_GPIO);
+    gpio_wakeup_disable((gpio_num_t)PIN_BTN_A);
+    gpio_wakeup_disable((gpio_num_t)PIN_BTN_B);
+
+    return (uint32_t)((esp_timer_get_time() - start) / 1000);
+    #else
+    delay(ms);
+    return 0;
+    #endif
+}
+
 // ============================================================================
 // DEEP SLEEP
 // ============================================================================
-inline void enterDeepSleep() {
+inline void enterDeepSleep(bool quiet = false, uint8_t wakeIntervalH = SYNC_WAKE_INTERVAL_H) {
     #ifdef FEATURE_DEEPSLEEP
-    Serial.println(F("[Power] Entering deep sleep..."));
-    Serial.println(F("[Power] Press button to wake"));
+    LOG_I(POWER, "[Power] Entering deep sleep...");
+    LOG_I(POWER, "[Power] Press button to wake");
 
     // Save state before sleep
     // (handled by caller)
 
     // Configure wake-up
     esp_sleep_enable_ext0_wakeup((gpio_num_t)SLEEP_WAKEUP_PIN, 0);  // Wake on LOW
+    if (wakeIntervalH > 0) {
+        esp_sleep_enable_timer_wakeup((uint64_t)wakeIntervalH * 3600ULL * 1000000ULL);
+    }
 
-    // Goodbye
-    playTone(220, 100);
-    delay(150);
+    // Goodbye; anything still queued gets to finish
+    if (!quiet) {
+        playTone(220, 100, PRIO_ALERT);
+    }
+    audioWaitIdle(1000);
+    logger.flush();
 
     esp_deep_sleep_start();
     #endif
@@ -0,0 +1,244 @@
+/*
+ * Heap Telemetry
+ *
+ * Samples free, minimum-ever free and largest free block for internal RAM,
+ * DMA-capable RAM and PSRAM (when fitted) every HEAP_SAMPLE_MS. Hourly lows
+ * of the internal largest block are kept for a day, so fragmentation from
+ * String churn shows up as the largest block sinking while free stays flat.
+ *
+ * Nothing wraps malloc: the allocations worth watching are implicit
+ * (String, HTTPClient, mbedTLS). A HeapScope around a subsystem's work
+ * books the internal free-heap change to its tag - bytes still held after
+ * it closed, and how deep it dipped when it set a new low-water mark.
+ * Nested scopes book the inner bytes to both tags.
+ *
+ * A TLS handshake needs the 16 KB record buffer in one piece and about
+ * HEAP_TLS_FREE overall. checkTls() runs before each new session and
+ * warns when it would likely fail.
+ */
+
+#ifndef HEAPMON_H
+#define HEAPMON_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <esp_heap_caps.h>
+
+#define HEAP_SAMPLE_MS      60000
+#define HEAP_TREND_SLOTS    24          // Hourly lows of the largest block
+#define HEAP_TREND_MS       3600000UL
+#define HEAP_TLS_BLOCK      17408       // mbedTLS input record buffer + overhead
+#define HEAP_TLS_FREE       45056       // Handshake peak, certificate chain included
+
+enum HeapRegion : uint8_t {
+    HEAP_INTERNAL,
+    HEAP_DMA,
+    HEAP_PSRAM,
+    HEAP_REGION_COUNT
+};
+
+static const uint32_t HEAP_REGION_CAPS[HEAP_REGION_COUNT] = {
+    MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT, MALLOC_CAP_DMA, MALLOC_CAP_SPIRAM
+};
+static const char* const HEAP_REGION_NAMES[HEAP_REGION_COUNT] = { "internal", "dma", "psram" };
+
+enum HeapTag : uint8_t {
+    HEAP_TAG_CLOUD,         // Chat, sync, status, care
+    HEAP_TAG_DISPLAY,       // Frame renders
+    HEAP_TAG_STORAGE,       // SD config and chat log, soul saves
+    HEAP_TAG_LINK,          // USB link transfers
+    HEAP_TAG_COUNT
+};
+
+static const char* const HEAP_TAG_NAMES[HEAP_TAG_COUNT] = { "cloud", "display", "storage", "link" };
+
+struct HeapStats {
+    uint32_t free;
+    uint32_t minFree;       // Low-water mark since boot
+    uint32_t largest;       // Largest single allocation possible
+};
+
+struct HeapTagStats {
+    uint32_t calls;
+    int32_t held;           // Net bytes its scopes left allocated
+    uint32_t peak;          // Deepest dip that set a new low-water mark
+};
+
+class HeapMonitor {
+private:
+    HeapStats regions[HEAP_REGION_COUNT];
+    HeapTagStats tags[HEAP_TAG_COUNT];
+    uint32_t trend[HEAP_TREND_SLOTS];
+    uint8_t trendHead;
+    uint8_t trendCount;
+    uint32_t trendStart;
+    uint32_t lastSample;
+    uint32_t tlsWarnings;
+
+public:
+    HeapMonitor() : trendHead(0), trendCount(0), trendStart(0), lastSample(0), tlsWarnings(0) {
+        memset(regions, 0, sizeof(regions));
+        memset(tags, 0, sizeof(tags));
+        memset(trend, 0, sizeof(trend));
+    }
+
+    void begin() {
+        trendStart = millis();
+        trendHead = 0;
+        trendCount = 0;
+        sample();
+    }
+
+    // Call every loop pass; samples once per HEAP_SAMPLE_MS
+    void update() {
+        if (millis() - lastSample >= HEAP_SAMPLE_MS) sample();
+    }
+
+    void sample() {
+        uint32_t now = millis();
+        lastSample = now;
+        for (int i = 0; i < HEAP_REGION_COUNT; i++) {
+            uint32_t caps = HEAP_REGION_CAPS[i];
+            if (heap_caps_get_total_size(caps) == 0) {
+                memset(&regions[i], 0, sizeof(HeapStats));   // No PSRAM fitted
+                continue;
+            }
+            regions[i].free = heap_caps_get_free_size(caps);
+            regions[i].minFree = heap_caps_get_minimum_free_size(caps);
+            regions[i].largest = heap_caps_get_largest_free_block(caps);
+        }
+
+        uint32_t largest = regions[HEAP_INTERNAL].largest;
+        if (trendCount == 0) {
+            trend[trendHead] = largest;
+            trendCount = 1;
+        } else if (now - trendStart >= HEAP_TREND_MS) {
+            trendStart = now;
+            trendHead = (trendHead + 1) % HEAP_TREND_SLOTS;
+            trend[trendHead] = largest;
+            if (trendCount < HEAP_TREND_SLOTS) trendCount++;
+        } else if (largest < trend[trendHead]) {
+            trend[trendHead] = largest;
+        }
+    }
+
+    const HeapStats& stats(HeapRegion r) { return regions[r]; }
+    const HeapTagStats& tagStats(HeapTag t) { return tags[t]; }
+    uint32_t getTlsWarnings() { return tlsWarnings; }
+
+    // Share of free memory not reachable as one block
+    uint8_t fragmentation(HeapRegion r) {
+        const HeapStats& s = regions[r];
+        if (s.free == 0) return 0;
+        return 100 - (uint8_t)((uint64_t)s.largest * 100 / s.free);
+    }
+
+    // Lowest largest-block over the kept hours
+    uint32_t trendLow() {
+        uint32_t low = UINT32_MAX;
+        for (uint8_t i = 0; i < trendCount; i++) low = min(low, trend[i]);
+        return trendCount ? low : 0;
+    }
+
+    bool tlsFits() {
+        const HeapStats& s = regions[HEAP_INTERNAL];
+        return s.largest >= HEAP_TLS_BLOCK && s.free >= HEAP_TLS_FREE;
+    }
+
+    // Before a new TLS session; fresh numbers, a warning if it won't fit
+    bool checkTls() {
+        sample();
+        if (tlsFits()) return true;
+        tlsWarnings++;
+        Serial.printf("[Heap] TLS handshake may fail: largest %lu (need %u), free %lu (need %u)\n",
+                      (unsigned long)regions[HEAP_INTERNAL].largest, HEAP_TLS_BLOCK,
+                      (unsigned long)regions[HEAP_INTERNAL].free, HEAP_TLS_FREE);
+        return false;
+    }
+
+    // HeapScope close: free and low-water mark from when it opened
+    void book(HeapTag tag, uint32_t freeBefore, uint32_t minBefore) {
+        uint32_t caps = HEAP_REGION_CAPS[HEAP_INTERNAL];
+        uint32_t freeAfter = heap_caps_get_free_size(caps);
+        uint32_t minAfter = heap_caps_get_minimum_free_size(caps);
+        HeapTagStats& t = tags[tag];
+        t.calls++;
+        t.held += (int32_t)(freeBefore - freeAfter);
+        if (minAfter < minBefore && freeBefore - minAfter > t.peak) t.peak = freeBefore - minAfter;
+    }
+
+    // Status screen line: internal free/largest and fragmentation
+    void formatLine(char* buf, size_t len) {
+        const HeapStats& s = regions[HEAP_INTERNAL];
+        snprintf(buf, len, "Heap %luk/%luk f%u%%%s", (unsigned long)(s.free / 1024),
+                 (unsigned long)(s.largest / 1024), fragmentation(HEAP_INTERNAL),
+                 tlsFits() ? "" : " !");
+    }
+
+    void print() {
+        sample();
+        Serial.println(F("\n[Heap] Region       free     min  largest  frag"));
+        for (int i = 0; i < HEAP_REGION_COUNT; i++) {
+            const HeapStats& s = regions[i];
+            if (s.free == 0 && s.largest == 0) continue;
+            Serial.printf("  %-9s %8lu %7lu %8lu  %3u%%\n", HEAP_REGION_NAMES[i],
+                          (unsigned long)s.free, (unsigned long)s.minFree,
+                          (unsigned long)s.largest, fragmentation((HeapRegion)i));
+        }
+        Serial.printf("  TLS %s (block %u, free %u), %lu warnings\n",
+                      tlsFits() ? "fits" : "would likely fail", HEAP_TLS_BLOCK, HEAP_TLS_FREE,
+                      (unsigned long)tlsWarnings);
+
+        Serial.print(F("  Largest block, hourly lows:"));
+        for (uint8_t i = 0; i < trendCount; i++) {
+            uint8_t slot = (trendHead + HEAP_TREND_SLOTS - trendCount + 1 + i) % HEAP_TREND_SLOTS;
+            Serial.printf(" %luk", (unsigned long)(trend[slot] / 1024));
+        }
+        Serial.println();
+
+        Serial.println(F("  Tag        calls     held     peak"));
+        for (int i = 0; i < HEAP_TAG_COUNT; i++) {
+            Serial.printf("  %-9s %6lu %8ld %8lu\n", HEAP_TAG_NAMES[i], (unsigned long)tags[i].calls,
+                          (long)tags[i].held, (unsigned long)tags[i].peak);
+        }
+    }
+
+    // Sync telemetry: internal RAM, PSRAM if fitted, bytes held per tag
+    // (HEAP_JSON_SIZE)
+    void toJson(JsonObject obj) {
+        const HeapStats& s = regions[HEAP_INTERNAL];
+        obj["free"] = s.free;
+        obj["min_free"] = s.minFree;
+        obj["largest"] = s.largest;
+        obj["frag_pct"] = fragmentation(HEAP_INTERNAL);
+        obj["largest_24h"] = trendLow();
+        obj["tls_warnings"] = tlsWarnings;
+        if (regions[HEAP_PSRAM].free > 0) {
+            obj["psram_free"] = regions[HEAP_PSRAM].free;
+            obj["psram_largest"] = regions[HEAP_PSRAM].largest;
+        }
+        JsonObject held = obj.createNestedObject("held");
+        for (int i = 0; i < HEAP_TAG_COUNT; i++) held[HEAP_TAG_NAMES[i]] = tags[i].held;
+    }
+};
+
+// JSON pool toJson() needs: nine members, "held" with one per tag
+#define HEAP_JSON_SIZE      (JSON_OBJECT_SIZE(9) + JSON_OBJECT_SIZE(HEAP_TAG_COUNT))
+
+extern HeapMonitor heapMon;
+
+// HeapScope scope(HEAP_TAG_CLOUD); ... work ...
+struct HeapScope {
+    HeapTag tag;
+    uint32_t freeBefore;
+    uint32_t minBefore;
+
+    explicit HeapScope(HeapTag t) : tag(t) {
+        uint32_t caps = HEAP_REGION_CAPS[HEAP_INTERNAL];
+        freeBefore = heap_caps_get_free_size(caps);
+        minBefore = heap_caps_get_minimum_free_size(caps);
+    }
+    ~HeapScope() { heapMon.book(tag, freeBefore, minBefore); }
+};
+
+#endif // HEAPMON_H
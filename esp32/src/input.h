@@ -0,0 +1,330 @@
+/*
+ * Button Input
+ *
+ * GPIO interrupts timestamp every button edge into a lock-free ring (the
+ * ISR is the only producer, the loop the only consumer), so presses made
+ * while the loop is stuck in a TLS handshake or a chat are still seen,
+ * with their real timing. The loop drains the ring and debounces on the
+ * ISR timestamps: a level counts once it held for DEBOUNCE_MS. If the
+ * ring ever fills, the pins are resampled after the drain so a lost
+ * release can't leave a button held.
+ *
+ * Gestures: short, long (fires while held), double (only on buttons that
+ * ask for it - it delays the short), chord (both held >= CHORD_MS, on
+ * release) and factory reset (both held for FACTORY_RESET_MS). A press
+ * filter sees each press first and can swallow it (panel wake).
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <Arduino.h>
+#include "driver/gpio.h"
+#include "config.h"
+
+#define INPUT_RING_LEN      32      // Power of two
+#define INPUT_EVENT_LEN     8
+
+enum Button : uint8_t { BTN_A, BTN_B, BTN_COUNT };
+
+enum Gesture : uint8_t {
+    GESTURE_SHORT,
+    GESTURE_LONG,
+    GESTURE_DOUBLE,
+    GESTURE_CHORD,          // Both buttons; button field is BTN_A
+    GESTURE_FACTORY_RESET,
+};
+
+static const char* const GESTURE_NAMES[] = { "short", "long", "double", "chord", "factory_reset" };
+
+struct InputEvent {
+    Gesture gesture;
+    Button button;
+    uint32_t at;            // millis() of the edge that completed it
+};
+
+struct InputEdge {
+    uint8_t button;
+    uint8_t down;
+    uint32_t at;
+};
+
+// Filled by the ISRs, drained by ButtonInput::update()
+struct InputRing {
+    InputEdge edges[INPUT_RING_LEN];
+    volatile uint8_t head;          // Written by the ISR only
+    volatile uint8_t tail;          // Written by the loop only
+    volatile uint16_t overflows;
+    volatile bool resync;           // An edge was lost: resample after the drain
+    uint8_t lastDown[BTN_COUNT];    // Last level pushed, drops repeats
+};
+
+static InputRing inputRing = {};
+static const uint8_t INPUT_PINS[BTN_COUNT] = { PIN_BTN_A, PIN_BTN_B };
+
+static inline void IRAM_ATTR inputPush(uint8_t button, uint8_t down) {
+    if (down == inputRing.lastDown[button]) return;
+    uint8_t head = inputRing.head;
+    if ((uint8_t)(head - inputRing.tail) >= INPUT_RING_LEN) {
+        inputRing.overflows++;
+        inputRing.resync = true;    // lastDown no longer matches the pin
+        return;
+    }
+    inputRing.edges[head % INPUT_RING_LEN] = { button, down, (uint32_t)millis() };
+    inputRing.lastDown[button] = down;
+    inputRing.head = head + 1;      // Publish after the slot is written
+}
+
+static void IRAM_ATTR inputIsrA() { inputPush(BTN_A, !gpio_get_level((gpio_num_t)PIN_BTN_A)); }
+static void IRAM_ATTR inputIsrB() { inputPush(BTN_B, !gpio_get_level((gpio_num_t)PIN_BTN_B)); }
+
+// Called for each debounced press; return true to swallow it (no gesture)
+typedef bool (*InputPressFilter)(Button button);
+
+class ButtonInput {
+private:
+    struct ButtonState {
+        bool rawDown;           // Latest ISR level, may still be bouncing
+        uint32_t rawAt;
+        bool down;              // Debounced
+        uint32_t downAt;
+        bool consumed;          // Press already used (long, chord, swallowed)
+        bool tapPending;        // Released short, waiting for a second tap
+        uint32_t tapAt;
+        bool secondTap;         // This press is the second of a double
+    };
+
+    ButtonState buttons[BTN_COUNT];
+    uint8_t doubleMask;         // Buttons with a double-tap gesture
+    bool chordActive;
+    bool chordReset;
+    uint32_t chordAt;
+    InputPressFilter pressFilter;
+
+    InputEvent events[INPUT_EVENT_LEN];
+    uint8_t eventHead;
+    uint8_t eventCount;
+
+    void emit(Gesture g, Button b, uint32_t at) {
+        if (eventCount >= INPUT_EVENT_LEN) return;
+        events[(eventHead + eventCount) % INPUT_EVENT_LEN] = { g, b, at };
+        eventCount++;
+    }
+
+    bool hasDouble(Button b) { return doubleMask & (1 << b); }
+
+    void pressed(Button b, uint32_t at) {
+        ButtonState& s = buttons[b];
+        Button other = b == BTN_A ? BTN_B : BTN_A;
+
+        // Waiting tap that didn't get its second press in time
+        s.secondTap = false;
+        if (s.tapPending) {
+            s.tapPending = false;
+            if (at - s.tapAt <= DOUBLE_TAP_MS) s.secondTap = true;
+            else emit(GESTURE_SHORT, b, s.tapAt);
+        }
+
+        s.down = true;
+        s.downAt = at;
+        s.consumed = false;
+        if (pressFilter && pressFilter(b)) s.consumed = true;
+
+        if (chordActive) {
+            s.consumed = true;      // Re-press while the chord is still held
+        } else if (buttons[other].down) {
+            chordActive = true;
+            chordReset = false;
+            chordAt = at;
+            s.consumed = true;
+            buttons[other].consumed = true;
+            buttons[other].tapPending = false;
+        }
+    }
+
+    void released(Button b, uint32_t at) {
+        ButtonState& s = buttons[b];
+        s.down = false;
+
+        if (chordActive) {
+            checkChord(at);
+            Button other = b == BTN_A ? BTN_B : BTN_A;
+            if (!buttons[other].down) {
+                if (!chordReset && at - chordAt >= CHORD_MS) emit(GESTURE_CHORD, BTN_A, at);
+                chordActive = false;
+            }
+            return;
+        }
+        if (s.consumed) return;
+
+        if (at - s.downAt >= LONG_PRESS_MS) {
+            emit(GESTURE_LONG, b, s.downAt + LONG_PRESS_MS);   // Held through a stall
+        } else if (s.secondTap) {
+            emit(GESTURE_DOUBLE, b, at);
+        } else if (hasDouble(b)) {
+            s.tapPending = true;
+            s.tapAt = at;
+        } else {
+            emit(GESTURE_SHORT, b, at);
+        }
+    }
+
+    // Time from an edge to now; 0 if the edge is the newer one
+    static uint32_t since(uint32_t at, uint32_t now) {
+        return (int32_t)(now - at) > 0 ? now - at : 0;
+    }
+
+    void checkChord(uint32_t now) {
+        if (chordActive && !chordReset && since(chordAt, now) >= FACTORY_RESET_MS) {
+            chordReset = true;
+            emit(GESTURE_FACTORY_RESET, BTN_A, chordAt + FACTORY_RESET_MS);
+        }
+    }
+
+    // Time-driven gestures: long while held, expired double-tap windows
+    void tick(uint32_t now) {
+        checkChord(now);
+        for (uint8_t i = 0; i < BTN_COUNT; i++) {
+            ButtonState& s = buttons[i];
+            if (s.down && !s.consumed && since(s.downAt, now) >= LONG_PRESS_MS) {
+                s.consumed = true;
+                emit(GESTURE_LONG, (Button)i, s.downAt + LONG_PRESS_MS);
+            }
+            if (s.tapPending && since(s.tapAt, now) > DOUBLE_TAP_MS) {
+                s.tapPending = false;
+                emit(GESTURE_SHORT, (Button)i, s.tapAt);
+            }
+        }
+    }
+
+    // A raw level that held for DEBOUNCE_MS becomes the debounced level,
+    // timed from its edge
+    void settle(Button b, uint32_t now) {
+        ButtonState& s = buttons[b];
+        if (s.rawDown == s.down || now - s.rawAt < DEBOUNCE_MS) return;
+        tick(s.rawAt);
+        if (s.rawDown) pressed(b, s.rawAt);
+        else released(b, s.rawAt);
+    }
+
+    // Both buttons up to now, the older pending edge first: settling A
+    // before an earlier B edge would tick time backwards past A's press
+    void settleAll(uint32_t now) {
+        Button first = (int32_t)(buttons[BTN_B].rawAt - buttons[BTN_A].rawAt) < 0 ? BTN_B : BTN_A;
+        settle(first, now);
+        settle(first == BTN_A ? BTN_B : BTN_A, now);
+    }
+
+    void setInterrupts(bool on) {
+        for (uint8_t i = 0; i < BTN_COUNT; i++) {
+            if (on) {
+                gpio_set_intr_type((gpio_num_t)INPUT_PINS[i], GPIO_INTR_ANYEDGE);
+                gpio_intr_enable((gpio_num_t)INPUT_PINS[i]);
+            } else {
+                gpio_intr_disable((gpio_num_t)INPUT_PINS[i]);
+            }
+        }
+    }
+
+    void drain() {
+        while (inputRing.tail != inputRing.head) {
+            InputEdge e = inputRing.edges[inputRing.tail % INPUT_RING_LEN];
+            inputRing.tail = inputRing.tail + 1;
+
+            // Both buttons up to this edge, so a release of the other one
+            // isn't seen after a later press of this one
+            settleAll(e.at);
+            buttons[e.button].rawDown = e.down;
+            buttons[e.button].rawAt = e.at;
+        }
+    }
+
+    // Push the current pin levels; only with the ISRs off (one producer)
+    void resample() {
+        for (uint8_t i = 0; i < BTN_COUNT; i++) {
+            inputPush(i, !digitalRead(INPUT_PINS[i]));
+        }
+    }
+
+public:
+    ButtonInput() : doubleMask(0), chordActive(false), chordReset(false), chordAt(0),
+                    pressFilter(nullptr), eventHead(0), eventCount(0) {
+        memset(buttons, 0, sizeof(buttons));
+    }
+
+    // A button already held here (the one that woke us) is swallowed
+    void begin() {
+        uint32_t now = millis();
+        for (uint8_t i = 0; i < BTN_COUNT; i++) {
+            ButtonState& s = buttons[i];
+            s.down = s.rawDown = !digitalRead(INPUT_PINS[i]);
+            s.downAt = s.rawAt = now;
+            s.consumed = s.down;
+            inputRing.lastDown[i] = s.down;
+        }
+        attachInterrupt(digitalPinToInterrupt(PIN_BTN_A), inputIsrA, CHANGE);
+        attachInterrupt(digitalPinToInterrupt(PIN_BTN_B), inputIsrB, CHANGE);
+    }
+
+    // Drain the ISR ring and run the recognizer up to now
+    void update() {
+        drain();
+        // Edges were lost, so the pins may have moved on without us:
+        // sample them as after a nap and take whatever differs
+        if (inputRing.resync) {
+            setInterrupts(false);
+            inputRing.resync = false;
+            resample();
+            setInterrupts(true);
+            drain();
+        }
+        // After the drain, so no edge taken above is newer than now
+        uint32_t now = millis();
+        settleAll(now);
+        tick(now);
+    }
+
+    bool poll(InputEvent& ev) {
+        if (eventCount == 0) return false;
+        ev = events[eventHead];
+        eventHead = (eventHead + 1) % INPUT_EVENT_LEN;
+        eventCount--;
+        return true;
+    }
+
+    // Light sleep: the GPIO wake reprograms the pins as level interrupts,
+    // which would storm the ISR on wake. Off before the nap, back to edges
+    // after, and the level sampled so the waking press isn't lost.
+    void beforeNap() {
+        setInterrupts(false);
+    }
+
+    void afterNap() {
+        resample();
+        setInterrupts(true);
+    }
+
+    void setDoubleTap(Button b, bool on) {
+        if (on) doubleMask |= (1 << b);
+        else doubleMask &= ~(1 << b);
+    }
+
+    void setPressFilter(InputPressFilter fn) { pressFilter = fn; }
+
+    // Held or mid-gesture: keep the loop awake so timing stays exact
+    bool busy() {
+        if (inputRing.tail != inputRing.head) return true;
+        for (uint8_t i = 0; i < BTN_COUNT; i++) {
+            if (buttons[i].down || buttons[i].rawDown || buttons[i].tapPending) return true;
+        }
+        return false;
+    }
+
+    bool isDown(Button b) { return buttons[b].down; }
+    uint32_t chordHeldMs() { return chordActive ? millis() - chordAt : 0; }
+    uint16_t overflows() { return inputRing.overflows; }
+};
+
+extern ButtonInput buttons;
+
+#endif // INPUT_H
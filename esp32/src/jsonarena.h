@@ -0,0 +1,198 @@
+/*
+ * JSON Arena
+ *
+ * Request bodies, responses, config.json and the soul file all take their
+ * document pool from one arena instead of a StaticJsonDocument of a
+ * guessed size on the loop stack. The arena is a bulk buffer (memplace.h),
+ * allocated at first use: in PSRAM on the Sense, internal otherwise. A JsonArenaScope around each request or
+ * file rewinds the arena when it closes; a document released in order
+ * (the last one allocated) hands its bytes back at once, so a request body
+ * is gone before its response is parsed.
+ *
+ * Each document's capacity comes from a schema: its fields and, for
+ * strings copied into the pool, the longest value kept. static_asserts
+ * next to the schemas check that every document fits the arena.
+ *
+ * Running out never goes unnoticed: a parse that hit NoMemory, a built
+ * document that overflowed or an arena that couldn't serve a document is
+ * logged, counted in /metrics and handled as a failure - nothing is read
+ * from a half-filled document. Loop task only.
+ */
+
+#ifndef JSONARENA_H
+#define JSONARENA_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "metrics.h"
+#include "memplace.h"
+#include "log.h"
+
+#define JSON_ARENA_SIZE     2048        // config.json with every WiFi entry is the largest
+#define JSON_SLACK          128         // Parsed documents: fields added on the other side
+#define JSON_ARENA_NONE     0xFFFF      // No allocation below this one
+
+// ============================================================================
+// SCHEMAS
+// ============================================================================
+
+struct JsonField {
+    const char* key;
+    uint16_t maxLen;        // Longest string value copied into the pool, 0 otherwise
+};
+
+constexpr size_t jsonKeyLen(const char* s) { return *s ? 1 + jsonKeyLen(s + 1) : 0; }
+
+// Pool for one object with these fields. Built documents store literals and
+// const char* by pointer, so only char buffers (maxLen) are copied; parsing
+// copies every key and string value.
+template <size_t N>
+constexpr size_t jsonObjectSize(const JsonField (&fields)[N], bool parsed) {
+    size_t size = JSON_OBJECT_SIZE(N);
+    for (size_t i = 0; i < N; i++) {
+        if (parsed) size += JSON_STRING_SIZE(jsonKeyLen(fields[i].key));
+        if (fields[i].maxLen) size += JSON_STRING_SIZE(fields[i].maxLen);
+    }
+    return size;
+}
+
+// ============================================================================
+// ARENA
+// ============================================================================
+
+class JsonArena {
+private:
+    // Each allocation is preceded by the arena state before it, so the
+    // latest can be popped when its document goes away
+    struct Header {
+        uint16_t used;
+        uint16_t top;
+    };
+
+    MemBlock pool;
+    uint16_t used;
+    uint16_t top;           // Offset of the latest allocation's data
+    uint16_t peak;
+
+    Counter parseOverflows{"apex_json_overflows_total", "JSON documents that ran out of pool",
+                           "kind=\"parse\""};
+    Counter buildOverflows{"apex_json_overflows_total", "", "kind=\"build\""};
+    Counter arenaExhausted{"apex_json_overflows_total", "", "kind=\"arena\""};
+    Gauge peakBytes{"apex_json_arena_peak_bytes", "Deepest JSON arena use since boot"};
+
+    uint8_t* at(size_t offset) { return (uint8_t*)pool.ptr + offset; }
+
+public:
+    JsonArena() : pool{ nullptr, 0, MEM_INTERNAL }, used(0), top(JSON_ARENA_NONE), peak(0) {}
+    ~JsonArena() { memPlace.release(pool); }
+
+    void* allocate(size_t size) {
+        if (!pool.ptr) pool = memPlace.alloc(JSON_ARENA_SIZE, MEM_BULK, "JSON arena");
+        if (!pool.ptr) {
+            arenaExhausted.inc();
+            return nullptr;
+        }
+        size_t start = (used + sizeof(Header) + 3) & ~(size_t)3;
+        if (start + size > JSON_ARENA_SIZE) {
+            arenaExhausted.inc();
+            LOG_E(SYS, "[JSON] Arena full: %u bytes wanted, %u free", (unsigned)size,
+                  (unsigned)(JSON_ARENA_SIZE - min(start, (size_t)JSON_ARENA_SIZE)));
+            return nullptr;
+        }
+        Header h = { used, top };
+        memcpy(at(start - sizeof(Header)), &h, sizeof(Header));
+        top = start;
+        used = start + size;
+        if (used > peak) {
+            peak = used;
+            peakBytes.set(peak);
+        }
+        return at(start);
+    }
+
+    bool isTop(void* ptr) { return ptr && top != JSON_ARENA_NONE && (uint8_t*)ptr == at(top); }
+
+    // Only the latest allocation comes back now; the rest at scope close
+    void deallocate(void* ptr) {
+        if (!isTop(ptr)) return;
+        Header h;
+        memcpy(&h, at(top - sizeof(Header)), sizeof(Header));
+        used = h.used;
+        top = h.top;
+    }
+
+    // shrinkToFit: the latest allocation can change size in place
+    void* reallocate(void* ptr, size_t size) {
+        if (!isTop(ptr) || top + size > JSON_ARENA_SIZE) return nullptr;
+        used = top + size;
+        if (used > peak) {
+            peak = used;
+            peakBytes.set(peak);
+        }
+        return ptr;
+    }
+
+    uint16_t mark() { return used; }
+    uint16_t topMark() { return top; }
+    void rewind(uint16_t toUsed, uint16_t toTop) {
+        used = toUsed;
+        top = toTop;
+    }
+
+    uint16_t getUsed() { return used; }
+    uint16_t getPeak() { return peak; }
+
+    // False (logged, counted) when a parse can't be trusted
+    bool parsed(DeserializationError err, const char* what) {
+        if (!err) return true;
+        if (err == DeserializationError::NoMemory) {
+            parseOverflows.inc();
+            LOG_E(SYS, "[JSON] %s: document too small, parse dropped", what);
+        } else {
+            LOG_W(SYS, "[JSON] %s: %s", what, err.c_str());
+        }
+        return false;
+    }
+
+    // False (logged, counted) when a built document lost members
+    bool built(const JsonDocument& doc, const char* what) {
+        if (!doc.overflowed()) return true;
+        buildOverflows.inc();
+        LOG_E(SYS, "[JSON] %s: document too small (%u bytes), not sent", what,
+              (unsigned)doc.capacity());
+        return false;
+    }
+
+    void registerMetrics(MetricsRegistry& reg) {
+        Metric* all[] = { &parseOverflows, &buildOverflows, &arenaExhausted, &peakBytes };
+        for (Metric* m : all) reg.add(m);
+    }
+
+    void print() {
+        Serial.printf("  JSON arena: %u of %u bytes peak, %s\n", peak, JSON_ARENA_SIZE,
+                      pool.ptr ? MEM_REGION_NAMES[pool.region] : "not allocated");
+    }
+};
+
+extern JsonArena jsonArena;
+
+// ArduinoJson allocator over the arena
+struct JsonArenaAllocator {
+    void* allocate(size_t size) { return jsonArena.allocate(size); }
+    void deallocate(void* ptr) { jsonArena.deallocate(ptr); }
+    void* reallocate(void* ptr, size_t size) { return jsonArena.reallocate(ptr, size); }
+};
+
+typedef BasicJsonDocument<JsonArenaAllocator> ArenaJsonDocument;
+
+// JsonArenaScope arena; ArenaJsonDocument doc(CAPACITY); ...
+// Declare the scope first so it closes after its documents.
+struct JsonArenaScope {
+    uint16_t used;
+    uint16_t top;
+
+    JsonArenaScope() : used(jsonArena.mark()), top(jsonArena.topMark()) {}
+    ~JsonArenaScope() { jsonArena.rewind(used, top); }
+};
+
+#endif // JSONARENA_H
@@ -0,0 +1,479 @@
+/*
+ * Host Link
+ *
+ * Framed binary protocol on the USB CDC serial port for getting bulk data
+ * on and off the device (esp32/tools/apexlink.py). The console command
+ * /link switches the port over; BYE or LINK_IDLE_MS without a valid frame
+ * hands it back to the console.
+ *
+ * Frame: A5 5A | type | seq | len (LE16) | payload | CRC-16/CCITT (LE16)
+ * over type..payload. Bytes outside a valid frame are skipped, so stray
+ * log lines don't break the stream.
+ *
+ * Streams (OPEN): the device sends DATA frames carrying their byte offset,
+ * at most LINK_WINDOW frames ahead of the host's cumulative ACK. Without
+ * ACK progress for LINK_ACK_TIMEOUT_MS it goes back to the last acked
+ * offset (go-back-N). END carries the size and is acked with offset
+ * LINK_ACK_END.
+ *
+ * Sources too big for the generator buffer (metrics, the event trace) are
+ * rendered twice into a bulk buffer: once to size it, once to fill it. The
+ * tracer is held for the whole stream, as /trace holds it while printing.
+ */
+
+#ifndef LINK_H
+#define LINK_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <SD.h>
+#include "config.h"
+#include "soul.h"
+#include "metrics.h"
+#include "jsonarena.h"
+#include "memplace.h"
+#include "trace.h"
+#include "log.h"
+
+#define LINK_VERSION        1
+#define LINK_MAGIC0         0xA5
+#define LINK_MAGIC1         0x5A
+#define LINK_MAX_PAYLOAD    512
+#define LINK_CHUNK          (LINK_MAX_PAYLOAD - 4)   // DATA: offset + bytes
+#define LINK_WINDOW         4
+#define LINK_ACK_TIMEOUT_MS 250
+#define LINK_IDLE_MS        5000
+#define LINK_PUMP_MS        20      // Per loop pass while streaming
+#define LINK_GEN_LEN        1024    // Generated sources (listing, status)
+#define LINK_RENDER_SLACK   128     // Metric values that grow between the two renders
+#define LINK_ACK_END        0xFFFFFFFFUL
+
+enum LinkFrameType : uint8_t {
+    // Host -> device
+    LINK_HELLO      = 0x01,
+    LINK_OPEN       = 0x02,     // source, path
+    LINK_ACK        = 0x03,     // next offset expected (LE32)
+    LINK_SOUL_PUT   = 0x04,     // SoulData
+    LINK_BYE        = 0x05,
+    // Device -> host
+    LINK_HELLO_OK   = 0x81,     // version, window, max payload (LE16), fw
+    LINK_OPEN_OK    = 0x82,     // size (LE32)
+    LINK_DATA       = 0x83,     // offset (LE32), bytes
+    LINK_END        = 0x84,     // size (LE32)
+    LINK_OK         = 0x85,
+    LINK_ERROR      = 0xFF,     // code, message
+};
+
+enum LinkSource : uint8_t {
+    LINK_SRC_FILE,              // SD card path
+    LINK_SRC_LIST,              // SD directory: "name\tsize\n" lines
+    LINK_SRC_SOUL,              // Raw SoulData, checksum included
+    LINK_SRC_STATUS,            // JSON snapshot
+    LINK_SRC_METRICS,           // Prometheus text, as /metrics
+    LINK_SRC_TRACE,             // Chrome trace JSON, as /trace (FEATURE_TRACE)
+};
+
+enum LinkError : uint8_t {
+    LINK_ERR_BAD_FRAME = 1,
+    LINK_ERR_NOT_FOUND,
+    LINK_ERR_BUSY,
+    LINK_ERR_REJECTED,
+    LINK_ERR_TOO_BIG,           // Generated source overflowed its buffer
+};
+
+typedef void (*LinkStatusFn)(JsonObject out);
+
+// Counts what is printed and keeps what fits
+class LinkCapture : public Print {
+private:
+    uint8_t* buf;
+    size_t capacity;
+    size_t total;
+
+public:
+    LinkCapture(uint8_t* b, size_t cap) : buf(b), capacity(cap), total(0) {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* data, size_t len) override {
+        if (total < capacity) memcpy(buf + total, data, min(len, capacity - total));
+        total += len;
+        return len;
+    }
+    using Print::write;
+
+    size_t length() { return total; }
+    bool overflowed() { return total > capacity; }
+};
+
+class HostLink {
+private:
+    // Receiver
+    enum RxState : uint8_t { RX_MAGIC0, RX_MAGIC1, RX_HEADER, RX_PAYLOAD, RX_CRC };
+    RxState rxState;
+    uint8_t rxHeader[4];        // type, seq, len
+    uint8_t rxPos;
+    uint16_t rxLen;
+    uint8_t rxPayload[LINK_MAX_PAYLOAD];
+    uint8_t rxCrc[2];
+    uint8_t txSeq;
+
+    bool active;
+    unsigned long lastFrame;
+
+    // Stream being sent
+    bool streaming;
+    LinkSource source;
+    File file;
+    char gen[LINK_GEN_LEN];
+    MemBlock rendered;          // Metrics and trace streams
+    bool traceHeld;
+    uint32_t size;
+    uint32_t base;              // Oldest unacked offset
+    uint32_t next;              // Next offset to send
+    bool endSent;
+    unsigned long lastProgress;
+    uint32_t retransmits;
+
+    Soul* soul;
+    LinkStatusFn statusFn;
+    size_t statusCap;
+
+    static uint16_t crc16(uint16_t crc, const uint8_t* data, size_t len) {
+        while (len--) {
+            crc ^= (uint16_t)(*data++) << 8;
+            for (int i = 0; i < 8; i++) {
+                crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+            }
+        }
+        return crc;
+    }
+
+    static void put32(uint8_t* p, uint32_t v) {
+        p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+    }
+
+    static uint32_t get32(const uint8_t* p) {
+        return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+    }
+
+    void send(uint8_t type, const uint8_t* a, size_t aLen,
+              const uint8_t* b = nullptr, size_t bLen = 0) {
+        uint16_t len = aLen + bLen;
+        uint8_t head[6] = { LINK_MAGIC0, LINK_MAGIC1, type, txSeq++,
+                            (uint8_t)len, (uint8_t)(len >> 8) };
+        uint16_t crc = crc16(0xFFFF, head + 2, 4);
+        crc = crc16(crc, a, aLen);
+        if (bLen) crc = crc16(crc, b, bLen);
+        uint8_t tail[2] = { (uint8_t)crc, (uint8_t)(crc >> 8) };
+
+        Serial.write(head, sizeof(head));
+        if (aLen) Serial.write(a, aLen);
+        if (bLen) Serial.write(b, bLen);
+        Serial.write(tail, sizeof(tail));
+    }
+
+    void sendError(LinkError code, const char* msg) {
+        uint8_t c = code;
+        send(LINK_ERROR, &c, 1, (const uint8_t*)msg, strlen(msg));
+    }
+
+    void closeStream() {
+        if (file) file.close();
+        memPlace.release(rendered);
+        #ifdef FEATURE_TRACE
+        if (traceHeld) tracer.hold(false);
+        #endif
+        traceHeld = false;
+        streaming = false;
+    }
+
+    void render(LinkSource src, Print& out) {
+        if (src == LINK_SRC_METRICS) metrics.writePrometheus(out);
+        #ifdef FEATURE_TRACE
+        else tracer.exportJson(out);
+        #endif
+    }
+
+    // Render a metrics or trace source into `rendered`; false after
+    // sending the error
+    bool renderSource(LinkSource src) {
+        if (src == LINK_SRC_TRACE) {
+            #ifdef FEATURE_TRACE
+            tracer.hold(true);
+            traceHeld = true;
+            #else
+            sendError(LINK_ERR_NOT_FOUND, "trace not in this build");
+            return false;
+            #endif
+        }
+
+        LinkCapture sizing(nullptr, 0);
+        render(src, sizing);
+        size_t capacity = sizing.length() + LINK_RENDER_SLACK;
+        rendered = memPlace.alloc(capacity, MEM_BULK, "link stream");
+        if (!rendered.ptr) {
+            closeStream();
+            sendError(LINK_ERR_BUSY, "no memory");
+            return false;
+        }
+        LinkCapture out((uint8_t*)rendered.ptr, capacity);
+        render(src, out);
+        if (out.overflowed()) {
+            closeStream();
+            sendError(LINK_ERR_BUSY, "changed while rendering");
+            return false;
+        }
+        size = out.length();
+        return true;
+    }
+
+    const uint8_t* streamData() {
+        return rendered.ptr ? (const uint8_t*)rendered.ptr : (const uint8_t*)gen;
+    }
+
+    // Fill gen[] for the generated sources and set size; false once the
+    // error went out
+    bool generate(LinkSource src, const char* path) {
+        if (src == LINK_SRC_SOUL) {
+            SoulData d;
+            soul->exportData(&d);
+            memcpy(gen, &d, sizeof(d));
+            size = sizeof(d);
+            return true;
+        }
+        if (src == LINK_SRC_STATUS) {
+            JsonArenaScope arena;
+            ArenaJsonDocument doc(statusCap);
+            JsonObject out = doc.to<JsonObject>();
+            if (statusFn) statusFn(out);
+            // A cut JSON document is worse than none
+            if (!jsonArena.built(doc, "link status") || measureJson(doc) >= sizeof(gen)) {
+                sendError(LINK_ERR_TOO_BIG, "status");
+                return false;
+            }
+            size = serializeJson(doc, gen, sizeof(gen));
+            return true;
+        }
+
+        // LINK_SRC_LIST: truncated at LINK_GEN_LEN
+        size_t used = 0;
+        File dir = SD.open(path);
+        if (!dir || !dir.isDirectory()) {
+            sendError(LINK_ERR_NOT_FOUND, path);
+            return false;
+        }
+        for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+            int n = snprintf(gen + used, sizeof(gen) - used, "%s%s\t%lu\n", f.name(),
+                             f.isDirectory() ? "/" : "", (unsigned long)f.size());
+            f.close();
+            if (n < 0 || used + n >= sizeof(gen)) break;
+            used += n;
+        }
+        dir.close();
+        size = used;
+        return true;
+    }
+
+    void open(const uint8_t* p, uint16_t len) {
+        if (len < 1) return sendError(LINK_ERR_BAD_FRAME, "no source");
+        closeStream();
+
+        char path[96];
+        size_t pathLen = min((size_t)(len - 1), sizeof(path) - 1);
+        memcpy(path, p + 1, pathLen);
+        path[pathLen] = '\0';
+
+        source = (LinkSource)p[0];
+        if (source == LINK_SRC_FILE) {
+            file = SD.open(path, FILE_READ);
+            if (!file || file.isDirectory()) {
+                if (file) file.close();
+                return sendError(LINK_ERR_NOT_FOUND, path);
+            }
+            size = file.size();
+        } else if (source <= LINK_SRC_STATUS) {
+            if (!generate(source, path)) return;
+        } else if (source <= LINK_SRC_TRACE) {
+            if (!renderSource(source)) return;
+        } else {
+            return sendError(LINK_ERR_BAD_FRAME, "unknown source");
+        }
+
+        uint8_t out[4];
+        put32(out, size);
+        send(LINK_OPEN_OK, out, 4);
+
+        streaming = true;
+        base = next = 0;
+        endSent = false;
+        lastProgress = millis();
+    }
+
+    void ack(uint32_t offset) {
+        if (!streaming) return;
+        if (offset == LINK_ACK_END) {
+            if (endSent) closeStream();
+            return;
+        }
+        if (offset > base && offset <= next) {
+            base = offset;
+            lastProgress = millis();
+        }
+    }
+
+    void soulPut(const uint8_t* p, uint16_t len) {
+        if (len != sizeof(SoulData)) return sendError(LINK_ERR_BAD_FRAME, "size");
+        if (streaming) return sendError(LINK_ERR_BUSY, "streaming");
+        SoulData d;
+        memcpy(&d, p, sizeof(d));
+        if (!soul->importData(&d)) return sendError(LINK_ERR_REJECTED, "checksum or values");
+        soul->save();
+        send(LINK_OK, nullptr, 0);
+    }
+
+    void handle(uint8_t type, const uint8_t* p, uint16_t len) {
+        lastFrame = millis();
+        switch (type) {
+            case LINK_HELLO: {
+                uint8_t out[4] = { LINK_VERSION, LINK_WINDOW,
+                                   (uint8_t)LINK_MAX_PAYLOAD, (uint8_t)(LINK_MAX_PAYLOAD >> 8) };
+                send(LINK_HELLO_OK, out, 4, (const uint8_t*)FW_VERSION, strlen(FW_VERSION));
+                break;
+            }
+            case LINK_OPEN:     open(p, len); break;
+            case LINK_ACK:      if (len == 4) ack(get32(p)); break;
+            case LINK_SOUL_PUT: soulPut(p, len); break;
+            case LINK_BYE:
+                closeStream();
+                send(LINK_OK, nullptr, 0);
+                active = false;
+                Serial.println(F("\n[Link] Closed"));
+                logger.hold(false);
+                break;
+            default:
+                sendError(LINK_ERR_BAD_FRAME, "unknown type");
+        }
+    }
+
+    void receive(uint8_t c) {
+        switch (rxState) {
+            case RX_MAGIC0:
+                if (c == LINK_MAGIC0) rxState = RX_MAGIC1;
+                break;
+            case RX_MAGIC1:
+                rxState = c == LINK_MAGIC1 ? RX_HEADER : (c == LINK_MAGIC0 ? RX_MAGIC1 : RX_MAGIC0);
+                rxPos = 0;
+                break;
+            case RX_HEADER:
+                rxHeader[rxPos++] = c;
+                if (rxPos == 4) {
+                    rxLen = rxHeader[2] | (rxHeader[3] << 8);
+                    rxPos = 0;
+                    if (rxLen > LINK_MAX_PAYLOAD) rxState = RX_MAGIC0;
+                    else rxState = rxLen ? RX_PAYLOAD : RX_CRC;
+                }
+                break;
+            case RX_PAYLOAD:
+                rxPayload[rxPos++] = c;
+                if (rxPos == rxLen) {
+                    rxPos = 0;
+                    rxState = RX_CRC;
+                }
+                break;
+            case RX_CRC:
+                rxCrc[rxPos++] = c;
+                if (rxPos == 2) {
+                    rxState = RX_MAGIC0;
+                    uint16_t crc = crc16(crc16(0xFFFF, rxHeader, 4), rxPayload, rxLen);
+                    if (crc == (rxCrc[0] | (rxCrc[1] << 8))) handle(rxHeader[0], rxPayload, rxLen);
+                }
+                break;
+        }
+    }
+
+    // Send what the window allows; rewind on ACK timeout
+    void pump() {
+        unsigned long now = millis();
+        if (now - lastProgress > LINK_ACK_TIMEOUT_MS && (next > base || endSent)) {
+            next = base;
+            endSent = false;
+            lastProgress = now;
+            retransmits++;
+        }
+
+        while (next < size && next - base < (uint32_t)LINK_WINDOW * LINK_CHUNK) {
+            uint8_t buf[LINK_CHUNK];
+            size_t n = min((uint32_t)LINK_CHUNK, size - next);
+            if (source == LINK_SRC_FILE) {
+                if (!file.seek(next) || file.read(buf, n) != n) {
+                    closeStream();
+                    return sendError(LINK_ERR_NOT_FOUND, "read");
+                }
+            } else {
+                memcpy(buf, streamData() + next, n);
+            }
+            uint8_t off[4];
+            put32(off, next);
+            send(LINK_DATA, off, 4, buf, n);
+            next += n;
+        }
+
+        if (next == size && !endSent) {
+            uint8_t out[4];
+            put32(out, size);
+            send(LINK_END, out, 4);
+            endSent = true;
+        }
+    }
+
+public:
+    HostLink() : rxState(RX_MAGIC0), rxPos(0), rxLen(0), txSeq(0), active(false),
+                 lastFrame(0), streaming(false), source(LINK_SRC_FILE),
+                 rendered{ nullptr, 0, MEM_INTERNAL }, traceHeld(false), size(0), base(0),
+                 next(0), endSent(false), lastProgress(0), retransmits(0),
+                 soul(nullptr), statusFn(nullptr), statusCap(0) {}
+    ~HostLink() { closeStream(); }
+
+    // statusCap: JSON pool for everything status adds
+    void begin(Soul* s, LinkStatusFn status, size_t cap) {
+        soul = s;
+        statusFn = status;
+        statusCap = cap;
+    }
+
+    // Console /link: the port is ours until BYE or idle. Queued log lines
+    // go out first; new ones wait in the ring until the link closes.
+    void start() {
+        logger.flush();
+        logger.hold(true);
+        active = true;
+        rxState = RX_MAGIC0;
+        lastFrame = millis();
+        Serial.println(F("[Link] Ready"));
+    }
+
+    bool isActive() { return active; }
+    bool isStreaming() { return streaming; }
+
+    // Call every loop pass while active. Streams pump for up to
+    // LINK_PUMP_MS so transfers aren't paced by the frame rate.
+    void poll() {
+        unsigned long start = millis();
+        do {
+            while (Serial.available() > 0 && active) receive(Serial.read());
+            if (streaming) pump();
+        } while (streaming && active && millis() - start < LINK_PUMP_MS);
+
+        if (active && millis() - lastFrame > LINK_IDLE_MS) {
+            closeStream();
+            active = false;
+            Serial.printf("\n[Link] Idle, back to console (%lu retransmits)\n",
+                          (unsigned long)retransmits);
+            logger.hold(false);
+        }
+    }
+};
+
+extern HostLink hostLink;
+
+#endif // LINK_H
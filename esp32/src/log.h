@@ -0,0 +1,238 @@
+/*
+ * Logging
+ *
+ * LOG_E/W/I/D(MODULE, fmt, ...) with a compile-time level per module: a
+ * line above LOG_LEVEL_<MODULE> (default LOG_LEVEL) sits behind a constant
+ * false and compiles to nothing, arguments included. Raise one module for
+ * a debug build with e.g. -DLOG_LEVEL_CLOUD=LOG_LEVEL_DEBUG.
+ *
+ * A line is formatted on the spot into a slot of a fixed ring, which takes
+ * microseconds; writing it out at 115200 baud takes ~5 ms, and that part
+ * is left to a low-priority task. Formatting can't be deferred as well:
+ * %s arguments often point into the caller's stack. The ring is a bounded
+ * lock-free queue (any task logs, one reader drains); when it is full the
+ * line is dropped and counted.
+ *
+ * While the USB link owns the port (hold) lines wait in the ring. flush()
+ * drains it from the caller, before deep sleep for instance. Native tests
+ * log synchronously unless LOG_ASYNC is set to 1.
+ */
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define LOG_LEVEL_NONE      0
+#define LOG_LEVEL_ERROR     1
+#define LOG_LEVEL_WARN      2
+#define LOG_LEVEL_INFO      3
+#define LOG_LEVEL_DEBUG     4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL           LOG_LEVEL_INFO
+#endif
+
+// Per-module levels
+#ifndef LOG_LEVEL_SYS
+#define LOG_LEVEL_SYS       LOG_LEVEL       // Boot, buttons, console chat
+#endif
+#ifndef LOG_LEVEL_CLOUD
+#define LOG_LEVEL_CLOUD     LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_WIFI
+#define LOG_LEVEL_WIFI      LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_SD
+#define LOG_LEVEL_SD        LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_SOUL
+#define LOG_LEVEL_SOUL      LOG_LEVEL
+#endif
+#ifndef LOG_LEVEL_POWER
+#define LOG_LEVEL_POWER     LOG_LEVEL
+#endif
+
+#ifndef LOG_ASYNC
+#ifdef NATIVE_TEST
+#define LOG_ASYNC           0
+#else
+#define LOG_ASYNC           1
+#endif
+#endif
+
+#define LOG_SLOTS           32          // Power of two
+#define LOG_LINE_LEN        96          // Longer lines are cut
+#define LOG_TASK_STACK      2048
+#define LOG_TASK_PRIO       1           // Just above idle, like the loop task
+
+// Snapshot of the counters
+struct LogStats {
+    uint32_t lines;
+    uint32_t dropped;       // Ring full
+    uint32_t truncated;     // Longer than LOG_LINE_LEN
+};
+
+class Logger {
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq;      // == write position: free; +1: filled
+        uint8_t len;
+        char text[LOG_LINE_LEN];
+    };
+
+    Slot slots[LOG_SLOTS];
+    std::atomic<uint32_t> writePos;
+    std::atomic<uint32_t> readPos;
+    std::atomic<bool> draining;         // One reader at a time
+    std::atomic<uint32_t> lines;        // Any task may log: counted like the ring
+    std::atomic<uint32_t> dropped;
+    std::atomic<uint32_t> truncated;
+    volatile bool held;
+    TaskHandle_t task;
+
+    void wake() {
+        #if LOG_ASYNC && !defined(NATIVE_TEST)
+        if (task) xTaskNotifyGive(task);
+        #endif
+    }
+
+    static void drainTask(void* arg) {
+        #if LOG_ASYNC && !defined(NATIVE_TEST)
+        Logger* self = (Logger*)arg;
+        for (;;) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            self->drain();
+        }
+        #else
+        (void)arg;
+        #endif
+    }
+
+public:
+    Logger() : task(nullptr) { reset(); }
+
+    void reset() {
+        for (uint32_t i = 0; i < LOG_SLOTS; i++) slots[i].seq.store(i, std::memory_order_relaxed);
+        writePos.store(0, std::memory_order_relaxed);
+        readPos.store(0, std::memory_order_relaxed);
+        draining.store(false, std::memory_order_relaxed);
+        lines.store(0, std::memory_order_relaxed);
+        dropped.store(0, std::memory_order_relaxed);
+        truncated.store(0, std::memory_order_relaxed);
+        held = false;
+    }
+
+    // Start the drain task (after Serial.begin); earlier lines are kept
+    void begin() {
+        #if LOG_ASYNC && !defined(NATIVE_TEST)
+        if (!task) xTaskCreate(drainTask, "log", LOG_TASK_STACK, this, LOG_TASK_PRIO, &task);
+        #endif
+        wake();
+    }
+
+    // Claim a slot, fill it, publish it. False when the ring is full.
+    bool push(const char* text, size_t len) {
+        uint32_t pos = writePos.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots[pos & (LOG_SLOTS - 1)];
+            int32_t diff = (int32_t)(slot->seq.load(std::memory_order_acquire) - pos);
+            if (diff == 0) {
+                if (writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = writePos.load(std::memory_order_relaxed);
+            }
+        }
+        memcpy(slot->text, text, len);
+        slot->len = (uint8_t)len;
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // A published line is waiting
+    bool pending() {
+        uint32_t pos = readPos.load(std::memory_order_relaxed);
+        Slot* slot = &slots[pos & (LOG_SLOTS - 1)];
+        return (int32_t)(slot->seq.load(std::memory_order_acquire) - (pos + 1)) >= 0;
+    }
+
+    // Write out every published line. Returns 0 straight away if another
+    // task is already at it.
+    uint32_t drain(Print& out = Serial) {
+        if (draining.exchange(true, std::memory_order_acquire)) return 0;
+        uint32_t n = 0;
+        while (!held && pending()) {
+            uint32_t pos = readPos.load(std::memory_order_relaxed);
+            Slot* slot = &slots[pos & (LOG_SLOTS - 1)];
+            out.write((const uint8_t*)slot->text, slot->len);
+            slot->seq.store(pos + LOG_SLOTS, std::memory_order_release);
+            readPos.store(pos + 1, std::memory_order_relaxed);
+            n++;
+        }
+        draining.store(false, std::memory_order_release);
+        return n;
+    }
+
+    // Everything out on the wire before returning (deep sleep, link start)
+    void flush() {
+        while (!held && pending()) {
+            if (drain() == 0) delay(1);
+        }
+        Serial.flush();
+    }
+
+    void hold(bool on) {
+        held = on;
+        if (!on) wake();
+    }
+
+    LogStats getStats() {
+        return { lines.load(std::memory_order_relaxed), dropped.load(std::memory_order_relaxed),
+                 truncated.load(std::memory_order_relaxed) };
+    }
+
+    __attribute__((format(printf, 2, 3)))
+    void write(const char* fmt, ...) {
+        char line[LOG_LINE_LEN];
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(line, sizeof(line), fmt, args);
+        va_end(args);
+
+        if (n < 0) return;
+        if (n > (int)sizeof(line) - 2) {
+            n = sizeof(line) - 2;
+            truncated.fetch_add(1, std::memory_order_relaxed);
+        }
+        line[n++] = '\n';
+        lines.fetch_add(1, std::memory_order_relaxed);
+
+        #if LOG_ASYNC
+        if (!push(line, n)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        wake();
+        #else
+        Serial.write((const uint8_t*)line, n);
+        #endif
+    }
+};
+
+extern Logger logger;
+
+#define LOG_AT(mod, level, fmt, ...) \
+    do { if (LOG_LEVEL_##mod >= level) logger.write(fmt, ##__VA_ARGS__); } while (0)
+
+#define LOG_E(mod, fmt, ...)    LOG_AT(mod, LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#define LOG_W(mod, fmt, ...)    LOG_AT(mod, LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#define LOG_I(mod, fmt, ...)    LOG_AT(mod, LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#define LOG_D(mod, fmt, ...)    LOG_AT(mod, LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+
+#endif // LOG_H
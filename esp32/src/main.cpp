@@ -24,16 +24,56 @@
 #include "display.h"
 #include "offline.h"
 #include "sdconfig.h"
+#include "boottime.h"
+#include "wake.h"
+#include "energy.h"
+#include "policy.h"
+#include "cpufreq.h"
+#include "input.h"
+#include "console.h"
+#include "link.h"
+#include "bench.h"
+#include "heapmon.h"
+#include "stackmon.h"
+#include "trace.h"
+#include "log.h"
+#include "metrics.h"
+#include "memplace.h"
+#include "jsonarena.h"
 
 // ============================================================================
 // GLOBAL STATE
 // ============================================================================
 HardwareStatus hw;
+RTC_DATA_ATTR I2CTopology i2cTopology;
+RTC_DATA_ATTR RtcSnapshot rtcSnapshot;
+RTC_DATA_ATTR SyncCycleStats cycleStats;
+RTC_DATA_ATTR CareQueue careQueue;
+RTC_DATA_ATTR EnergyTotals energyTotals;
 Adafruit_SSD1306 oled(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 Display display;
 Soul soul;
 OfflineMode offlineMode;
 CloudClient cloud;
+BootProfiler bootProf;
+EnergyMeter energy;
+PowerPolicy policy;
+CpuFreq cpu;
+ButtonInput buttons;
+SerialConsole console;
+HostLink hostLink;
+HeapMonitor heapMon;
+StackMonitor stackMon;
+Logger logger;
+MetricsRegistry metrics;
+MemPlacement memPlace;
+JsonArena jsonArena;
+#ifdef FEATURE_METRICS_HTTP
+MetricsServer metricsServer;
+#endif
+#ifdef FEATURE_TRACE
+Tracer tracer;
+#endif
 
 // Cloud config (loaded from SD or LittleFS)
 CloudConfig cloudCfg;
@@ -49,38 +89,129 @@ bool wifiConnected = false;
 bool sdAvailable = false;
 unsigned long lastWifiAttempt = 0;
 
-// Button state
-bool btnA_pressed = false;
-bool btnB_pressed = false;
-unsigned long btnA_pressTime = 0;
-unsigned long btnB_pressTime = 0;
-bool btnA_longTriggered = false;
-bool btnB_longTriggered = false;
-unsigned long lastDebounce = 0;
+// Async WiFi connector: candidate index into wifiNets[], wifiNetCount means
+// the hardcoded fallback, -1 when no attempt is in flight
+int wifiTryIndex = -1;
+unsigned long wifiTryStart = 0;
+bool wifiTryHinted = false;     // Attempt used a cached channel/BSSID
+int wifiConnectedIndex = -1;    // Candidate that is currently associated
+bool wifiAnnounce = false;      // Show "WiFi: <ssid>" on the face (boot only)
+bool cloudCheckPending = false; // Run fetchStatus once the link is up
+bool cloudCheckAnnounce = false;
 
 // Idle tracking
 unsigned long lastActivity = 0;
 
-// Auto-sync timer
+// Auto-sync timer; a due sync waits up to SYNC_CYCLE_TIMEOUT_MS for WiFi
 unsigned long lastAutoSync = 0;
+bool autoSyncWaiting = false;
+unsigned long autoSyncWaitStart = 0;
+
+// Config watcher (config.json fingerprint + SD hot-plug)
+SdConfigStamp configStamp;
+unsigned long lastConfigCheck = 0;
+unsigned long sdRetryMs = CONFIG_CHECK_INTERVAL_MS;    // No card: SD.begin blocks
+unsigned long sdRetryAt = 0;
+
+// Fast wake: storage mounts deferred until the face is up
+bool deferredStorageInit = false;
+
+// Energy totals persisted to LittleFS periodically
+unsigned long lastEnergySave = 0;
+
+// Battery reserve: final save + sync, then sleep
+bool finalSyncPending = false;
+unsigned long finalSyncStart = 0;
+
+// Idle timeout: sync before deep sleep, radio resumed for it
+bool sleepSyncPending = false;
+unsigned long sleepSyncStart = 0;
+
+// Sound cues on mood and billing changes (-1 = not seen yet)
+int8_t lastCueState = -1;
+int8_t lastCueBilling = -1;
+
+// Idle light sleep: radio parked, CPU naps between blinks
+bool wifiParked = false;
+int parkedIndex = -1;           // Last association, to resume or wake into, with its hint
+uint8_t parkedBssid[6];
+int32_t parkedChannel = 0;
+unsigned long idleSince = 0;
+uint32_t idleNaps = 0;
+uint32_t idleSleptMs = 0;
+
+// Loop-owned metrics; the rest are read from module state (initMetrics)
+static const uint32_t RENDER_BOUNDS_US[] = { 2000, 5000, 10000, 20000, 33000, 50000, 100000 };
+Histogram renderTime("apex_render_us", "Screen render time", RENDER_BOUNDS_US,
+                     sizeof(RENDER_BOUNDS_US) / sizeof(uint32_t));
+Counter wifiDrops("apex_wifi_drops_total", "Associations lost outside a park");
 
 // ============================================================================
 // FORWARD DECLARATIONS
 // ============================================================================
 void handleButtons();
-bool connectWiFi(const char* ssid, const char* pass);
-bool connectMultiWiFi();
+void initButtons();
+bool onButtonPress(Button button);
+void factoryReset();
+void beginWiFiConnect();
+bool startWiFiAttempt(int index, int32_t channel = 0, const uint8_t* bssid = nullptr);
+void pollWiFi();
+void runCloudCheck();
+void trackRadio();
+void initMemory();
+void initEnergy(bool coldBoot);
+void fastWakeSetup();
+void finishDeferredInit();
+void saveWakeSnapshot();
+void restoreWakeSnapshot();
 String chatWithCloud(const char* message);
 void sendCare(const char* careType, float intensity);
 void syncWithCloud();
+bool pushSync();
+void headlessSyncCycle();
 void checkIdleSleep();
+void idleFrameDelay();
+void checkDisplayPower();
+void checkSoundCues();
+void applyPolicy();
+void checkBatteryPolicy();
+bool wakePanel();
+bool captureWiFiHint();
+void parkWiFi();
+void resumeWiFi();
 void checkAutoSync();
+bool autoSyncDue(unsigned long now);
+bool radioWanted(unsigned long now);
+void checkConfigReload(bool force = false);
+bool reloadConfig();
+void initConsole();
+void initMetrics();
+void consoleChat(const char* text);
+void linkStatus(JsonObject out);
+// linkStatus(): thirteen members, then "power" and "heap"
+#define LINK_STATUS_SIZE (JSON_OBJECT_SIZE(15) + ENERGY_JSON_SIZE + HEAP_JSON_SIZE)
+void syncTelemetry(JsonObject doc);
+void runBenches(const char* only, uint16_t iters);
 
 // ============================================================================
 // SETUP
 // ============================================================================
 void setup() {
+    // Button wake with a valid RTC snapshot: face first, everything else later
+    if (getWakeKind() == WAKE_BUTTON && rtcSnapshotValid()) {
+        fastWakeSetup();
+        return;
+    }
+
+    // Timer wake: headless sync cycle, straight back to sleep
+    if (getWakeKind() == WAKE_TIMER && rtcSnapshotValid()) {
+        headlessSyncCycle();
+    }
+
+    bootProf.begin("serial");
     Serial.begin(115200);
+    logger.begin();
+    initMemory();
     delay(100);
 
     // Boot banner
@@ -89,21 +220,36 @@ void setup() {
     Serial.printf("  APEXPOCKET MAX %s (%s)\n", FW_VERSION, FW_BUILD);
     Serial.println(F("  The athanor never cools"));
     Serial.println(F("==========================================================="));
+    bootProf.end("serial");
 
     // Initialize hardware (scans I2C, configures pins)
+    bootProf.begin("hardware");
     initHardware();
+    initButtons();
+    initConsole();
+    initMetrics();
+    initEnergy(true);
+    policy.update(true);
+    applyPolicy();
+    bootProf.end("hardware");
 
     // Initialize display
+    bootProf.begin("oled");
     if (hw.oled_found) {
         if (display.begin(&oled)) {
             display.renderBootScreen();
         }
     }
+    energy.set(RAIL_OLED, display.isReady());
+    bootProf.end("oled");
 
-    // Play boot chime
-    playBoot();
+    // Start the radio now so RF calibration overlaps the SD read
+    bootProf.begin("wifi_start");
+    WiFi.mode(WIFI_STA);
+    bootProf.end("wifi_start");
 
     // --- SD Card config ---
+    bootProf.begin("sd_config");
     sdAvailable = sdInit();
     hw.sd_available = sdAvailable;
 
@@ -112,13 +258,17 @@ void setup() {
     wifiNetCount = 0;
 
     if (sdAvailable) {
-        if (sdReadConfig(&cloudCfg, wifiNets, &wifiNetCount)) {
+        uint8_t brightness = BRIGHT_NORMAL;
+        bool ok = sdReadConfig(&cloudCfg, wifiNets, &wifiNetCount, &brightness);
+        display.setBrightness(brightness);
+        if (ok) {
             sdSaveConfigToLittleFS(&cloudCfg);
             display.showMessage("SD config loaded", 1000);
             Serial.println(F("[Boot] SD config loaded and cached"));
         } else {
             Serial.println(F("[Boot] SD present but no valid config"));
         }
+        sdConfigStamp(&configStamp);
     }
 
     // Fallback to LittleFS cache if SD didn't provide config
@@ -132,65 +282,31 @@ void setup() {
     }
 
     hw.cloud_configured = cloudCfg.configured;
+    bootProf.end("sd_config");
+
+    // --- WiFi association runs in the background from here (pollWiFi) ---
+    bootProf.begin("wifi");
+    wifiAnnounce = true;
+    beginWiFiConnect();
+
+    // Play boot chime
+    bootProf.begin("chime");
+    playBoot();
+    bootProf.end("chime");
 
     // Load soul from storage
+    bootProf.begin("soul");
     soul.load();
     soul.updateFirmwareVersion();
+    bootProf.end("soul");
 
-    // --- WiFi connection ---
-    WiFi.mode(WIFI_STA);
-    bool wifiOk = false;
-
-    // Try networks from config.json first
-    if (wifiNetCount > 0) {
-        for (int i = 0; i < wifiNetCount; i++) {
-            if (display.isReady()) {
-                char msg[32];
-                snprintf(msg, sizeof(msg), "WiFi: %s", wifiNets[i].ssid);
-                display.showMessage(msg, 500);
-                display.renderFaceScreen(soul, false, false);
-            }
-            if (connectWiFi(wifiNets[i].ssid, wifiNets[i].pass)) {
-                wifiOk = true;
-                break;
-            }
-        }
-    }
-
-    // Fallback to hardcoded WiFi
-    if (!wifiOk && strlen(WIFI_SSID) > 0 && strcmp(WIFI_SSID, "YOUR_WIFI_NAME") != 0) {
-        if (display.isReady()) {
-            display.showMessage("WiFi: default", 500);
-            display.renderFaceScreen(soul, false, false);
-        }
-        wifiOk = connectWiFi(WIFI_SSID, WIFI_PASS);
-    }
-
-    // --- Cloud initialization ---
+    // --- Cloud initialization (status check waits for WiFi in loop) ---
     if (cloudCfg.configured) {
         cloud.init(&cloudCfg);
-
-        if (wifiOk) {
-            display.showMessage("Cloud check...", 1000);
-            if (display.isReady()) {
-                display.renderFaceScreen(soul, true, false);
-            }
-
-            if (cloud.fetchStatus()) {
-                if (strlen(cloud.status.motd) > 0) {
-                    display.showMessage(cloud.status.motd, 2000);
-                } else {
-                    display.showMessage("Cloud connected!", 1500);
-                }
-                Serial.println(F("[Boot] Cloud connection established"));
-            } else {
-                display.showMessage("Cloud offline", 1500);
-                Serial.println(F("[Boot] Cloud unreachable"));
-            }
-        }
     }
 
     // Wake-up animation
+    bootProf.begin("wake_anim");
     if (display.isReady()) {
         Expression wakeSeq[] = { EXPR_SLEEPING, EXPR_SLEEPY, EXPR_BLINK, EXPR_NEUTRAL, EXPR_HAPPY };
         int wakeTimes[] = { 200, 200, 100, 150, 400 };
@@ -198,9 +314,11 @@ void setup() {
             display.setExpression(wakeSeq[i]);
             display.renderFaceScreen(soul, wifiConnected, cloud.isConnected(),
                                      cloud.isBillingOk(), cloud.isTokenValid());
+            pollWiFi();
             delay(wakeTimes[i]);
         }
     }
+    bootProf.end("wake_anim");
 
     // Set expression from soul state
     display.setExpression(display.stateToExpression(soul.getState()));
@@ -208,258 +326,602 @@ void setup() {
     // Ready!
     Serial.println(F("\n[Ready] The furnace burns!"));
     soul.printStatus();
+    bootProf.ready();
+    cpu.begin();
 
     lastActivity = millis();
     lastAutoSync = millis();
 }
 
+// ============================================================================
+// FAST WAKE (ext0 button wake from deep sleep)
+// ============================================================================
+// No banner, boot screen, chime, SD read or wake animation: restore state
+// from RTC memory, draw the face, then let the loop associate WiFi (with the
+// cached channel/BSSID), mount LittleFS and the SD card, and fetch status.
+void fastWakeSetup() {
+    bootProf.begin("fast_wake");
+    Serial.begin(115200);
+    logger.begin();
+    initMemory();
+
+    initHardwareFast();
+    initButtons();      // The press that woke us is still held: swallowed
+    initConsole();
+    initMetrics();
+    initEnergy(false);
+    policy.update(true);
+    applyPolicy();
+    display.setBrightness(rtcSnapshot.brightness);
+    if (hw.oled_found) {
+        display.begin(&oled);
+    }
+    energy.set(RAIL_OLED, display.isReady());
+
+    restoreWakeSnapshot();
+    if (cloudCfg.configured) {
+        cloud.init(&cloudCfg);
+        cloud.status.token_valid = rtcSnapshot.token_valid;
+        cloud.status.billing_ok = rtcSnapshot.billing_ok;
+        cloud.status.tools_available = rtcSnapshot.tools_available;
+        cloud.status.messages_used = rtcSnapshot.messages_used;
+        cloud.status.messages_limit = rtcSnapshot.messages_limit;
+        strlcpy(cloud.status.tier_name, rtcSnapshot.tier_name, sizeof(cloud.status.tier_name));
+    }
+
+    display.setExpression(display.stateToExpression(soul.getState()));
+    display.renderFaceScreen(soul, false, false, cloud.isBillingOk(), cloud.isTokenValid());
+    bootProf.end("fast_wake");
+    bootProf.ready();
+    cpu.begin();
+
+    // Background: WiFi with the cached hint, storage on the next loop pass
+    bootProf.begin("wifi");
+    WiFi.mode(WIFI_STA);
+    lastWifiAttempt = millis();
+    int8_t idx = rtcSnapshot.wifiIndex;
+    if (idx < 0 || !startWiFiAttempt(idx, rtcSnapshot.channel, rtcSnapshot.bssid)) {
+        beginWiFiConnect();
+    }
+
+    deferredStorageInit = true;
+    sdAvailable = false;
+    lastConfigCheck = millis() - CONFIG_CHECK_INTERVAL_MS + 1000;  // SD mount in ~1s
+    rtcSnapshotInvalidate();
+
+    Serial.printf("[Wake] Button wake #%lu, face up in %lu ms\n",
+                  (unsigned long)rtcSnapshot.sleepCount, (unsigned long)bootProf.readyMs());
+    lastActivity = millis();
+    lastAutoSync = millis();
+}
+
+// ============================================================================
+// HEADLESS SYNC CYCLE (RTC timer wake from deep sleep)
+// ============================================================================
+// No OLED, chime or animation. Advance the soul across the sleep interval,
+// flush queued care and sync over one connection, then sleep again. The
+// cycle's time awake and radio-on time are turned into a charge estimate.
+void headlessSyncCycle() {
+    Serial.begin(115200);
+    logger.begin();
+    initMemory();
+    initHardwareFast();
+    initEnergy(false);
+    cpu.begin();
+    restoreWakeSnapshot();
+    rtcSnapshotInvalidate();
+
+    soul.advance(rtcSnapshot.wakeIntervalH * 60.0f);
+    policy.update(true);
+    applyPolicy();
+    bool reserve = policy.reserveReached();
+    Serial.printf("[Cycle] Timer wake #%lu, E=%.2f\n",
+                  (unsigned long)(cycleStats.cycles + 1), soul.getE());
+
+    uint32_t wifiStart = millis();
+    uint32_t wifiMs = 0;
+    bool synced = false;
+
+    if (cloudCfg.configured) {
+        cloud.init(&cloudCfg);
+        cloud.status.token_valid = rtcSnapshot.token_valid;
+        cloud.status.billing_ok = rtcSnapshot.billing_ok;
+
+        if (cloud.isTokenValid()) {
+            WiFi.mode(WIFI_STA);
+            int8_t idx = rtcSnapshot.wifiIndex;
+            if (idx < 0 || !startWiFiAttempt(idx, rtcSnapshot.channel, rtcSnapshot.bssid)) {
+                beginWiFiConnect();
+            }
+            while (!wifiConnected && wifiTryIndex >= 0 &&
+                   millis() - wifiStart < SYNC_CYCLE_TIMEOUT_MS) {
+                pollWiFi();
+                delay(20);
+            }
+
+            if (wifiConnected) {
+                synced = pushSync();
+                if (synced) soul.recordSync();
+                cloud.endSession();
+            }
+            captureWiFiHint();      // Before teardown; a failed attempt keeps the old hint
+            WiFi.disconnect(true);
+            WiFi.mode(WIFI_OFF);
+            wifiConnected = false;
+            wifiTryIndex = -1;
+            trackRadio();
+        }
+        wifiMs = millis() - wifiStart;
+    }
+
+    if (!hw.eeprom_found) mountLittleFS();
+    soul.save();
+    saveWakeSnapshot();
+
+    // esp_timer starts with the app, so ROM/bootloader time isn't included
+    uint32_t awakeMs = (uint32_t)(esp_timer_get_time() / 1000);
+    cycleStats.cycles++;
+    if (synced) cycleStats.synced++;
+    cycleStats.lastAwakeMs = awakeMs;
+    cycleStats.lastWifiMs = wifiMs;
+    cycleStats.lastUAh = cycleChargeUAh(awakeMs, wifiMs);
+    cycleStats.totalUAh += cycleStats.lastUAh;
+
+    Serial.printf("[Cycle] %s, awake %lu ms (WiFi %lu ms), ~%.1f uAh, %lu/%lu synced, %.2f mAh total\n",
+                  synced ? "Synced" : "Not synced",
+                  (unsigned long)awakeMs, (unsigned long)wifiMs, cycleStats.lastUAh,
+                  (unsigned long)cycleStats.synced, (unsigned long)cycleStats.cycles,
+                  cycleStats.totalUAh / 1000.0f);
+
+    // At the reserve this was the final sync: no more timer wakes
+    uint8_t wakeH = reserve ? 0 : policy.knobs().wakeIntervalH;
+    rtcSnapshot.wakeIntervalH = wakeH;
+    rtcSnapshotSeal();
+    energy.beforeDeepSleep(energyTotals.oledLit);  // OLED left as it was
+    enterDeepSleep(true, wakeH);
+}
+
+void finishDeferredInit() {
+    CpuBoost boost;
+    deferredStorageInit = false;
+    mountLittleFS();
+    if (!cloudCfg.configured) {
+        // Config may only exist in the LittleFS cache
+        if (sdLoadConfigFromLittleFS(&cloudCfg)) {
+            hw.cloud_configured = true;
+            cloud.init(&cloudCfg);
+        }
+    }
+}
+
+void saveWakeSnapshot() {
+    soul.exportData(&rtcSnapshot.soul);
+
+    rtcSnapshot.cloudCfg = cloudCfg;
+    rtcSnapshot.token_valid = cloud.status.token_valid;
+    rtcSnapshot.billing_ok = cloud.status.billing_ok;
+    rtcSnapshot.tools_available = cloud.status.tools_available;
+    rtcSnapshot.messages_used = cloud.status.messages_used;
+    rtcSnapshot.messages_limit = cloud.status.messages_limit;
+    strlcpy(rtcSnapshot.tier_name, cloud.status.tier_name, sizeof(rtcSnapshot.tier_name));
+
+    memcpy(rtcSnapshot.wifiNets, wifiNets, sizeof(wifiNets));
+    rtcSnapshot.wifiNetCount = wifiNetCount;
+    // The live association, else the last one seen (parked, or the hint
+    // this wake started with if its attempt failed)
+    captureWiFiHint();
+    rtcSnapshot.wifiIndex = parkedIndex;
+    memcpy(rtcSnapshot.bssid, parkedBssid, sizeof(rtcSnapshot.bssid));
+    rtcSnapshot.channel = parkedChannel;
+
+    rtcSnapshot.configStamp = configStamp;
+    rtcSnapshot.brightness = display.getBrightness();
+    rtcSnapshot.wakeIntervalH = policy.knobs().wakeIntervalH;
+    rtcSnapshot.sleepCount++;
+    rtcSnapshotSeal();
+}
+
+void restoreWakeSnapshot() {
+    if (!soul.importData(&rtcSnapshot.soul)) {
+        LOG_W(SOUL, "[Wake] Soul snapshot invalid, loading from storage");
+        mountLittleFS();
+        soul.load();
+    }
+
+    cloudCfg = rtcSnapshot.cloudCfg;
+    hw.cloud_configured = cloudCfg.configured;
+
+    memcpy(wifiNets, rtcSnapshot.wifiNets, sizeof(wifiNets));
+    wifiNetCount = rtcSnapshot.wifiNetCount;
+    parkedIndex = rtcSnapshot.wifiIndex;
+    memcpy(parkedBssid, rtcSnapshot.bssid, sizeof(parkedBssid));
+    parkedChannel = rtcSnapshot.channel;
+
+    configStamp = rtcSnapshot.configStamp;
+}
+
 // ============================================================================
 // MAIN LOOP
 // ============================================================================
 void loop() {
     unsigned long now = millis();
 
+    // Fast wake: mount storage now that the face is showing
+    if (deferredStorageInit) {
+        finishDeferredInit();
+    }
+
     // Handle button input
     handleButtons();
 
+    // Dim / switch off the panel when idle
+    checkDisplayPower();
+
+    // Battery tier, reserve handling
+    checkBatteryPolicy();
+
+    // Input after an idle stretch brings the radio back
+    if (wifiParked && now - lastActivity < LIGHT_SLEEP_IDLE_MS) {
+        resumeWiFi();
+    }
+
+    // Jingle on mood change or billing limit
+    checkSoundCues();
+
     // Update display animation
     display.update();
 
-    // WiFi reconnection
-    if (!wifiConnected && (now - lastWifiAttempt > WIFI_RETRY_MS)) {
-        if (connectMultiWiFi()) {
-            // Re-check cloud status on reconnect
-            if (cloud.isInitialized() && cloud.isTokenValid()) {
-                cloud.fetchStatus();
-            }
-        }
+    // WiFi association progress / reconnection
+    pollWiFi();
+
+    #ifdef BENCH_ON_BOOT
+    // Once WiFi is up (or given up on), so the TLS bench has a link
+    static bool benched = false;
+    if (!benched && (wifiConnected || now > BENCH_BOOT_WAIT_MS)) {
+        benched = true;
+        runBenches(nullptr, 0);
+    }
+    #endif
+    uint32_t retryMs = policy.knobs().wifiRetryMs;
+    if (!wifiConnected && !wifiParked && wifiTryIndex < 0 && retryMs > 0 &&
+        (now - lastWifiAttempt > retryMs)) {
+        beginWiFiConnect();
+    }
+
+    // Cloud status check after (re)connect
+    if (cloudCheckPending) {
+        runCloudCheck();
     }
 
     // Auto-sync (every 30 minutes if connected)
     checkAutoSync();
 
+    // Pick up config.json edits and SD card swaps
+    checkConfigReload();
+
+    // Heap sample and loop stack check once a minute
+    heapMon.update();
+    stackMon.update();
+
     // Check for idle sleep
     #ifdef FEATURE_DEEPSLEEP
     checkIdleSleep();
     #endif
 
-    // Check serial for chat input
-    if (Serial.available()) {
-        String input = Serial.readStringUntil('\n');
-        input.trim();
-        if (input.length() > 0) {
-            lastActivity = now;
-            Serial.print(F("[You] "));
-            Serial.println(input);
-
-            display.setExpression(EXPR_THINKING);
-            display.showMessage("Thinking...", 10000);
-            display.renderFaceScreen(soul, wifiConnected, cloud.isConnected(),
-                                     cloud.isBillingOk(), cloud.isTokenValid());
-
-            String response = chatWithCloud(input.c_str());
+    // Serial console: commands and chat, never waits for a full line.
+    // In link mode the port carries frames for the host tool instead.
+    if (hostLink.isActive()) {
+        HeapScope heapScope(HEAP_TAG_LINK);
+        hostLink.poll();
+        lastActivity = millis();
+    } else if (console.poll()) {
+        lastActivity = millis();
+    }
 
-            Serial.print(F("["));
-            Serial.print(soul.getAgentName());
-            Serial.print(F("] "));
-            Serial.println(response);
+    // LAN scrape endpoint, up while associated
+    #ifdef FEATURE_METRICS_HTTP
+    metricsServer.setOnline(wifiConnected);
+    metricsServer.poll();
+    #endif
 
-            display.setExpression(display.stateToExpression(soul.getState()));
-            display.showMessage(response.c_str(), 5000);
+    // Render current screen (nothing to push while the panel is off)
+    if (display.isLit()) {
+        HeapScope heapScope(HEAP_TAG_DISPLAY);
+        TRACE_SCOPE(TRACE_FRAME, "render");
+        uint32_t renderStart = micros();
+        switch (currentMode) {
+            case MODE_FACE:
+                display.renderFaceScreen(soul, wifiConnected, cloud.isConnected(),
+                                         cloud.isBillingOk(), cloud.isTokenValid());
+                break;
+            case MODE_STATUS:
+            {
+                // Bottom line cycles: messages/battery, energy total, split, heap
+                char powerLine[22];
+                int page = (millis() / 3000) % 4;
+                if (page == 3) heapMon.formatLine(powerLine, sizeof(powerLine));
+                else if (page > 0) energy.formatLine(page - 1, powerLine, sizeof(powerLine));
+                display.renderStatusScreen(soul, wifiConnected, cloud.isConnected(),
+                                           cloud.status.tools_available,
+                                           cloud.status.messages_used,
+                                           cloud.status.messages_limit,
+                                           cloud.status.tier_name,
+                                           page > 0 ? powerLine : nullptr);
+                break;
+            }
+            case MODE_CLOUD:
+                display.renderCloudScreen(&cloud.status, cloudCfg.cloud_url, cloudCfg.device_token);
+                break;
+            case MODE_AGENTS:
+                display.renderAgentScreen(soul);
+                break;
+            case MODE_SLEEP:
+                display.renderSleepScreen(soul);
+                break;
         }
+        renderTime.observe(micros() - renderStart);
     }
 
-    // Render current screen
-    switch (currentMode) {
-        case MODE_FACE:
-            display.renderFaceScreen(soul, wifiConnected, cloud.isConnected(),
-                                     cloud.isBillingOk(), cloud.isTokenValid());
-            break;
-        case MODE_STATUS:
-            display.renderStatusScreen(soul, wifiConnected, cloud.isConnected(),
-                                       cloud.status.tools_available,
-                                       cloud.status.messages_used,
-                                       cloud.status.messages_limit,
-                                       cloud.status.tier_name);
-            break;
-        case MODE_CLOUD:
-            display.renderCloudScreen(&cloud.status, cloudCfg.cloud_url, cloudCfg.device_token);
-            break;
-        case MODE_AGENTS:
-            display.renderAgentScreen(soul);
-            break;
-        case MODE_SLEEP:
-            display.renderSleepScreen(soul);
-            break;
-    }
-
-    delay(1000 / ANIMATION_FPS);  // Frame rate limiting
+    idleFrameDelay();  // Frame rate limiting, light sleep when idle
 }
 
 // ============================================================================
 // BUTTON HANDLING
 // ============================================================================
+void initButtons() {
+    buttons.setPressFilter(onButtonPress);
+    buttons.setDoubleTap(BTN_B, true);
+    buttons.begin();
+}
+
+// Every press lights the panel; the first one after it went dark only does that
+bool onButtonPress(Button button) {
+    return wakePanel();
+}
+
 void handleButtons() {
-    unsigned long now = millis();
-    if (now - lastDebounce < DEBOUNCE_MS) return;
-
-    bool btnA = !digitalRead(PIN_BTN_A);
-    bool btnB = !digitalRead(PIN_BTN_B);
-
-    // Both buttons held = sync with cloud
-    if (btnA && btnB && !btnA_longTriggered && !btnB_longTriggered) {
-        if (now - btnA_pressTime > 1000 && now - btnB_pressTime > 1000) {
-            btnA_longTriggered = true;
-            btnB_longTriggered = true;
-            lastActivity = now;
-            Serial.println(F("[Sync] Syncing with cloud..."));
+    buttons.update();
+
+    InputEvent ev;
+    while (buttons.poll(ev)) {
+        lastActivity = millis();
+        TRACE_INSTANT(TRACE_INPUT, GESTURE_NAMES[ev.gesture], ev.button);
+
+        if (ev.gesture == GESTURE_FACTORY_RESET) {
+            factoryReset();
+        } else if (ev.gesture == GESTURE_CHORD) {
+            // Both buttons = sync with cloud
+            LOG_I(CLOUD, "[Sync] Syncing with cloud...");
             playSync();
             display.showMessage("Syncing...", 3000);
             syncWithCloud();
-        }
-    }
-
-    // Button A
-    if (btnA && !btnA_pressed) {
-        btnA_pressed = true;
-        btnA_pressTime = now;
-        btnA_longTriggered = false;
-        lastDebounce = now;
-    }
-    if (!btnA && btnA_pressed) {
-        btnA_pressed = false;
-        lastDebounce = now;
-        lastActivity = now;
-        if (!btnA_longTriggered) {
-            // Short press A
+        } else if (ev.button == BTN_A && ev.gesture == GESTURE_SHORT) {
             if (currentMode == MODE_FACE) {
-                Serial.println(F("LOVE!"));
                 ledBlink(2, 30, 30);
                 playLove();
                 soul.applyCare(1.5f);
-                if (wifiConnected && cloud.isInitialized()) {
-                    cloud.care("love", 1.5f, soul.getE());
-                }
+                sendCare("love", 1.5f);
                 display.setExpression(display.stateToExpression(soul.getState()));
                 display.showMessage(offlineMode.getLoveResponse(), 1500);
-                soul.printStatus();
+                LOG_I(SOUL, "LOVE! E: %.2f | %s | Int: %lu", soul.getE(), soul.getStateName(),
+                      (unsigned long)soul.getInteractions());
             } else if (currentMode == MODE_AGENTS) {
                 // Select agent
-                playTone(600, 50);
+                playMelody(MELODY_AGENT);
                 currentMode = MODE_FACE;
                 display.showMessage(soul.getAgentName(), 1500);
                 soul.save();
             } else if (currentMode == MODE_STATUS || currentMode == MODE_CLOUD) {
                 // Nothing on A in status/cloud screens
             }
-        }
-    }
-    if (btnA_pressed && !btnA_longTriggered && (now - btnA_pressTime > LONG_PRESS_MS)) {
-        btnA_longTriggered = true;
-        lastActivity = now;
-        if (currentMode == MODE_FACE) {
-            playTone(440, 100);
-            Serial.println(F("[Chat] Type in Serial monitor..."));
-            display.showMessage("Serial chat mode", 2000);
-        } else if (currentMode == MODE_AGENTS) {
-            // Cycle agent on long A
-            soul.nextAgent();
-            playTone(500, 50);
-        }
-    }
-
-    // Button B
-    if (btnB && !btnB_pressed) {
-        btnB_pressed = true;
-        btnB_pressTime = now;
-        btnB_longTriggered = false;
-        lastDebounce = now;
-    }
-    if (!btnB && btnB_pressed) {
-        btnB_pressed = false;
-        lastDebounce = now;
-        lastActivity = now;
-        if (!btnB_longTriggered) {
-            // Short press B: go back
+        } else if (ev.button == BTN_A && ev.gesture == GESTURE_LONG) {
+            if (currentMode == MODE_FACE) {
+                playTone(440, 100);
+                LOG_I(SYS, "[Chat] Type in Serial monitor...");
+                display.showMessage("Serial chat mode", 2000);
+            } else if (currentMode == MODE_AGENTS) {
+                // Cycle agent on long A
+                soul.nextAgent();
+                playTone(500, 50);
+            }
+        } else if (ev.button == BTN_B && ev.gesture == GESTURE_DOUBLE && currentMode == MODE_FACE) {
+            // Double B on the face: battery glance
+            char glance[24];
+            uint8_t pct = policy.getPercent();
+            float hours = energy.remainingHours();
+            if (pct == 255) snprintf(glance, sizeof(glance), "USB power");
+            else if (hours > 0) snprintf(glance, sizeof(glance), "%u%% ~%.0fh left", pct, hours);
+            else snprintf(glance, sizeof(glance), "Battery %u%%", pct);
+            playTone(500, 30);
+            display.showMessage(glance, 2000);
+        } else if (ev.button == BTN_B && ev.gesture != GESTURE_LONG) {
+            // Short press B (or a double off the face): go back
             if (currentMode == MODE_FACE) {
-                Serial.println(F("*poke*"));
                 playPoke();
                 soul.applyCare(0.5f);
-                if (wifiConnected && cloud.isInitialized()) {
-                    cloud.care("poke", 0.5f, soul.getE());
-                }
+                sendCare("poke", 0.5f);
                 display.setExpression(display.stateToExpression(soul.getState()));
                 display.showMessage(offlineMode.getPokeResponse(), 1000);
-                soul.printStatus();
+                LOG_I(SOUL, "*poke* E: %.2f | %s | Int: %lu", soul.getE(), soul.getStateName(),
+                      (unsigned long)soul.getInteractions());
             } else if (currentMode == MODE_STATUS || currentMode == MODE_CLOUD
                        || currentMode == MODE_AGENTS) {
                 currentMode = MODE_FACE;
                 playTone(300, 50);
             }
-        }
-    }
-    if (btnB_pressed && !btnB_longTriggered && (now - btnB_pressTime > LONG_PRESS_MS)) {
-        btnB_longTriggered = true;
-        lastActivity = now;
-        playTone(350, 100);
-        // Long press B: cycle forward through screens
-        if (currentMode == MODE_FACE) {
-            currentMode = MODE_STATUS;
-        } else if (currentMode == MODE_STATUS) {
-            currentMode = MODE_CLOUD;
-        } else if (currentMode == MODE_CLOUD) {
-            currentMode = MODE_AGENTS;
+        } else if (ev.button == BTN_B && ev.gesture == GESTURE_LONG) {
+            playTone(350, 100);
+            // Long press B: cycle forward through screens
+            if (currentMode == MODE_FACE) {
+                currentMode = MODE_STATUS;
+            } else if (currentMode == MODE_STATUS) {
+                currentMode = MODE_CLOUD;
+            } else if (currentMode == MODE_CLOUD) {
+                currentMode = MODE_AGENTS;
+            }
         }
     }
 }
 
+// Both buttons held for FACTORY_RESET_MS: fresh soul, empty care queue and
+// energy totals, then restart. WiFi/cloud config (SD, LittleFS cache) stays.
+void factoryReset() {
+    LOG_W(SYS, "[Reset] Factory reset");
+    playError();
+    display.setPanel(PANEL_ON);
+    display.showMessage("Factory reset...", 2000);
+    display.renderFaceScreen(soul, wifiConnected, cloud.isConnected(),
+                             cloud.isBillingOk(), cloud.isTokenValid());
+
+    soul.reset();
+    soul.save();
+    memset(&careQueue, 0, sizeof(careQueue));
+    energy.reset();
+    energy.save();
+    rtcSnapshotInvalidate();
+
+    audioWaitIdle(1000);
+    ESP.restart();
+}
+
 // ============================================================================
 // WIFI
 // ============================================================================
-bool connectWiFi(const char* ssid, const char* pass) {
+// Association is non-blocking: beginWiFiConnect() kicks off the first
+// candidate and pollWiFi() (called every frame) walks the list on timeout.
+bool wifiFallbackConfigured() {
+    return strlen(WIFI_SSID) > 0 && strcmp(WIFI_SSID, "YOUR_WIFI_NAME") != 0;
+}
+
+void beginWiFiConnect() {
     lastWifiAttempt = millis();
+    if (!startWiFiAttempt(0)) {
+        offlineMode.connectionFailed();
+        wifiAnnounce = false;
+        bootProf.end("wifi");
+    }
+}
 
-    if (!ssid || strlen(ssid) == 0) {
+bool startWiFiAttempt(int index, int32_t channel, const uint8_t* bssid) {
+    const char* ssid = nullptr;
+    const char* pass = nullptr;
+
+    // Config networks first, then the hardcoded fallback
+    while (index < wifiNetCount && strlen(wifiNets[index].ssid) == 0) index++;
+    if (index < wifiNetCount) {
+        ssid = wifiNets[index].ssid;
+        pass = wifiNets[index].pass;
+    } else if (index == wifiNetCount && wifiFallbackConfigured()) {
+        ssid = WIFI_SSID;
+        pass = WIFI_PASS;
+    } else {
+        wifiTryIndex = -1;
         return false;
     }
 
-    Serial.printf("[WiFi] Connecting to %s\n", ssid);
+    LOG_I(WIFI, "[WiFi] Connecting to %s", ssid);
+    TRACE_INSTANT(TRACE_WIFI, "attempt", index);
+    if (wifiAnnounce && display.isReady()) {
+        char msg[32];
+        snprintf(msg, sizeof(msg), "WiFi: %s", index < wifiNetCount ? ssid : "default");
+        display.showMessage(msg, WIFI_CONNECT_TIMEOUT_MS);
+    }
 
-    WiFi.disconnect(true);
-    delay(100);
-    WiFi.begin(ssid, pass);
+    WiFi.disconnect();
+    WiFi.begin(ssid, pass, channel, bssid);  // Channel/BSSID hint skips the scan
+    wifiTryIndex = index;
+    wifiTryHinted = (bssid != nullptr);
+    wifiTryStart = millis();
+    return true;
+}
 
-    unsigned long start = millis();
-    while (WiFi.status() != WL_CONNECTED && (millis() - start) < WIFI_CONNECT_TIMEOUT_MS) {
-        delay(500);
-        Serial.print(".");
+void pollWiFi() {
+    trackRadio();
+    wl_status_t st = WiFi.status();
+
+    if (wifiTryIndex < 0) {
+        // Idle: notice a dropped link so the retry timer can kick in
+        if (wifiConnected && st != WL_CONNECTED) {
+            wifiConnected = false;
+            wifiDrops.inc();
+            TRACE_INSTANT(TRACE_WIFI, "lost", 0);
+            LOG_W(WIFI, "[WiFi] Connection lost");
+        }
+        return;
     }
 
-    if (WiFi.status() == WL_CONNECTED) {
+    if (st == WL_CONNECTED) {
+        wifiConnectedIndex = wifiTryIndex;
+        wifiTryIndex = -1;
         wifiConnected = true;
         offlineMode.connectionSuccess();
-        Serial.printf("\n[WiFi] Connected: %s\n", WiFi.localIP().toString().c_str());
-        return true;
-    } else {
-        wifiConnected = false;
-        Serial.println(F("\n[WiFi] Failed"));
-        return false;
+        TRACE_INSTANT(TRACE_WIFI, "connected", wifiConnectedIndex);
+        LOG_I(WIFI, "[WiFi] Connected: %s", WiFi.localIP().toString().c_str());
+        bootProf.end("wifi");
+
+        // Re-check cloud status on (re)connect (skipped on low battery)
+        if (cloud.isInitialized() && cloud.isTokenValid() &&
+            (policy.knobs().nonCriticalCloud || wifiAnnounce)) {
+            cloudCheckPending = true;
+            cloudCheckAnnounce = wifiAnnounce;
+        }
+        if (wifiAnnounce) display.clearMessage();
+        wifiAnnounce = false;
+        return;
     }
-}
 
-bool connectMultiWiFi() {
-    // Try config.json networks first
-    for (int i = 0; i < wifiNetCount; i++) {
-        if (connectWiFi(wifiNets[i].ssid, wifiNets[i].pass)) {
-            return true;
+    bool timedOut = millis() - wifiTryStart > WIFI_CONNECT_TIMEOUT_MS;
+    if (timedOut || st == WL_CONNECT_FAILED || st == WL_NO_SSID_AVAIL) {
+        TRACE_INSTANT(TRACE_WIFI, "failed", wifiTryIndex);
+        LOG_W(WIFI, "[WiFi] Failed");
+        // A stale hint falls back to a normal walk of the whole list
+        int next = wifiTryHinted ? 0 : wifiTryIndex + 1;
+        if (!startWiFiAttempt(next)) {
+            wifiConnected = false;
+            offlineMode.connectionFailed();
+            if (wifiAnnounce) display.showMessage("No WiFi", 1500);
+            wifiAnnounce = false;
+            bootProf.end("wifi");
         }
     }
-    // Fallback to hardcoded
-    if (strlen(WIFI_SSID) > 0 && strcmp(WIFI_SSID, "YOUR_WIFI_NAME") != 0) {
-        return connectWiFi(WIFI_SSID, WIFI_PASS);
+}
+
+// First status fetch after a (re)connect. At boot the result is shown on the
+// face, like the old blocking boot sequence did.
+void runCloudCheck() {
+    HeapScope heapScope(HEAP_TAG_CLOUD);
+    StackScope stackScope(STACK_PATH_STATUS);
+    cloudCheckPending = false;
+    bool atBoot = cloudCheckAnnounce;
+    if (atBoot) bootProf.begin("cloud_check");
+
+    if (cloudCheckAnnounce) {
+        display.showMessage("Cloud check...", 1000);
+        display.renderFaceScreen(soul, wifiConnected, false,
+                                 cloud.isBillingOk(), cloud.isTokenValid());
     }
-    offlineMode.connectionFailed();
-    return false;
+
+    bool ok = cloud.fetchStatus();
+    if (ok && careQueue.count > 0) {
+        cloud.flushCare(&careQueue);
+    }
+    if (ok) {
+        LOG_I(CLOUD, "[Boot] Cloud connection established");
+    } else {
+        LOG_W(CLOUD, "[Boot] Cloud unreachable");
+    }
+
+    if (cloudCheckAnnounce) {
+        if (!ok) {
+            display.showMessage("Cloud offline", 1500);
+        } else if (strlen(cloud.status.motd) > 0) {
+            display.showMessage(cloud.status.motd, 2000);
+        } else {
+            display.showMessage("Cloud connected!", 1500);
+        }
+    }
+    cloudCheckAnnounce = false;
+    if (atBoot) bootProf.end("cloud_check");
 }
 
 // ============================================================================
@@ -484,6 +946,8 @@ String chatWithCloud(const char* message) {
     }
 
     // Attempt cloud chat
+    HeapScope heapScope(HEAP_TAG_CLOUD);
+    StackScope stackScope(STACK_PATH_CHAT);
     char response[256];
     char expression[16];
     float careValue;
@@ -515,9 +979,30 @@ String chatWithCloud(const char* message) {
     return offlineMode.getResponse(soul.getState());
 }
 
+// Send now if we can, otherwise queue for the next sync (survives sleep)
 void sendCare(const char* careType, float intensity) {
-    if (!wifiConnected || !cloud.isInitialized()) return;
-    cloud.care(careType, intensity, soul.getE());
+    if (!cloudCfg.configured) return;
+    HeapScope heapScope(HEAP_TAG_CLOUD);
+    if (policy.knobs().nonCriticalCloud && wifiConnected && cloud.isInitialized() &&
+        cloud.care(careType, intensity, soul.getE())) {
+        return;
+    }
+    careQueuePush(&careQueue, careType, intensity, soul.getE());
+}
+
+// Flush queued care, then push the full soul state. Both ride the same
+// kept-alive TLS session.
+bool pushSync() {
+    HeapScope heapScope(HEAP_TAG_CLOUD);
+    StackScope stackScope(STACK_PATH_SYNC);
+    cloud.flushCare(&careQueue);
+    return cloud.sync(
+        soul.getE(), soul.getFloor(), soul.getPeak(),
+        soul.getInteractions(), soul.getTotalCare(),
+        soul.getStateName(), soul.getAgentName(),
+        soul.getCuriosity(), soul.getPlayfulness(), soul.getWisdom(),
+        FW_VERSION
+    );
 }
 
 void syncWithCloud() {
@@ -540,17 +1025,12 @@ void syncWithCloud() {
         return;
     }
 
-    bool ok = cloud.sync(
-        soul.getE(), soul.getFloor(), soul.getPeak(),
-        soul.getInteractions(), soul.getTotalCare(),
-        soul.getStateName(), soul.getAgentName(),
-        soul.getCuriosity(), soul.getPlayfulness(), soul.getWisdom(),
-        FW_VERSION
-    );
+    bool ok = pushSync();
 
     if (ok) {
         soul.recordSync();
         soul.save();
+        playMelody(MELODY_SYNC);
         display.showMessage("Soul synced!", 2000);
     } else if (!cloud.isBillingOk()) {
         display.showMessage("Sync OK (no chat)", 2000);
@@ -565,20 +1045,733 @@ void syncWithCloud() {
 // ============================================================================
 void checkAutoSync() {
     unsigned long now = millis();
-    if (now - lastAutoSync < AUTO_SYNC_INTERVAL_MS) return;
+
+    if (now - lastEnergySave > ENERGY_SAVE_INTERVAL_MS) {
+        lastEnergySave = now;
+        energy.save();
+    }
+    if (!autoSyncDue(now)) {
+        autoSyncWaiting = false;
+        return;
+    }
+
+    // Due: bring a parked radio back and wait for it, so an idle pocket
+    // still syncs. The timer only moves on once a sync was tried.
+    if (!wifiConnected) {
+        if (!autoSyncWaiting) {
+            autoSyncWaiting = true;
+            autoSyncWaitStart = now;
+            if (wifiParked) resumeWiFi();
+            else if (wifiTryIndex < 0) beginWiFiConnect();
+        }
+        if (now - autoSyncWaitStart <= SYNC_CYCLE_TIMEOUT_MS) return;
+        LOG_W(CLOUD, "[Auto-sync] No WiFi, skipped until the next interval");
+    } else {
+        LOG_I(CLOUD, "[Auto-sync] Periodic sync...");
+        if (pushSync()) soul.recordSync();
+    }
+    autoSyncWaiting = false;
     lastAutoSync = now;
+}
 
-    if (wifiConnected && cloud.isInitialized() && cloud.isTokenValid()) {
-        Serial.println(F("[Auto-sync] Periodic sync..."));
-        cloud.sync(
-            soul.getE(), soul.getFloor(), soul.getPeak(),
-            soul.getInteractions(), soul.getTotalCare(),
-            soul.getStateName(), soul.getAgentName(),
-            soul.getCuriosity(), soul.getPlayfulness(), soul.getWisdom(),
-            FW_VERSION
-        );
-        soul.recordSync();
+bool autoSyncDue(unsigned long now) {
+    uint32_t interval = policy.knobs().syncIntervalMs;
+    return interval != 0 && now - lastAutoSync >= interval &&
+           cloud.isInitialized() && cloud.isTokenValid();
+}
+
+// ============================================================================
+// BENCHMARKS
+// ============================================================================
+// /bench <name|all> [iters], or all of them once after boot with
+// -DBENCH_ON_BOOT (env:esp32s3_bench). The run holds CPU_BOOST_MHZ. The
+// storage benches rewrite the soul as it is; chat lines go to a scratch
+// file that is removed afterwards.
+#define BENCH_CHAT_FILE     "/bench_chat.txt"
+
+Soul benchSoul;                 // Scratch copy for the equation bench
+String benchBody;
+
+struct BenchCase {
+    const char* name;
+    uint16_t iters;             // Default; storage and TLS are slow
+    void (*run)();
+    bool (*ready)();            // nullptr: always runs
+};
+
+// update() is a no-op within one millisecond and may save: time its math
+void benchSoulStep() {
+    benchSoul.integrate(0.5f, 0.1f, 1.0f / 60.0f);
+    benchSoul.evolvePersonality(0.5f, 1.0f / 60.0f);
+}
+
+// Draw and push; "oled" is the push alone
+void benchFace() {
+    display.renderFaceScreen(soul, wifiConnected, cloud.isConnected(),
+                             cloud.isBillingOk(), cloud.isTokenValid());
+}
+
+void benchOled() { oled.display(); }
+
+void benchEeprom() {
+    #ifdef FEATURE_EEPROM
+    soul.saveToEEPROM();
+    #endif
+}
+
+void benchLittleFS() {
+    #if USE_LITTLEFS
+    soul.saveToLittleFS();
+    #endif
+}
+
+void benchSyncJson() {
+    cloud.buildSyncBody(benchBody, soul.getE(), soul.getFloor(), soul.getPeak(),
+                        soul.getInteractions(), soul.getTotalCare(),
+                        soul.getStateName(), soul.getAgentName(),
+                        soul.getCuriosity(), soul.getPlayfulness(), soul.getWisdom(),
+                        FW_VERSION);
+}
+
+void benchTls() { cloud.handshake(); }
+
+void benchSdLog() {
+    sdAppendChat(BENCH_CHAT_FILE, soul.getAgentName(), "how are you today?",
+                 "Flourishing, thank you for asking.", soul.getE());
+}
+
+// Placement: a TLS-record-sized copy within internal RAM and within PSRAM.
+// The json and sdlog benches of an esp32s3 and an esp32s3_sense capture
+// show what the bulk buffers pay for living in PSRAM.
+#define BENCH_COPY_BYTES    16384
+
+MemBlock benchCopy[MEM_REGION_COUNT][2];    // Source, destination; freed after the run
+
+void benchCopyIn(MemRegion r) { memcpy(benchCopy[r][1].ptr, benchCopy[r][0].ptr, BENCH_COPY_BYTES); }
+void benchCopySram() { benchCopyIn(MEM_INTERNAL); }
+void benchCopyPsram() { benchCopyIn(MEM_PSRAM); }
+
+bool benchCopyReady(MemRegion r) {
+    for (MemBlock& b : benchCopy[r]) {
+        if (!b.ptr) b = memPlace.alloc(BENCH_COPY_BYTES, r == MEM_PSRAM ? MEM_BULK : MEM_HOT, "bench copy");
+        if (!b.ptr || b.region != r) return false;
+    }
+    return true;
+}
+
+bool benchHasDisplay() { return display.isReady(); }
+bool benchHasEeprom() { return hw.eeprom_found; }
+bool benchHasCloud() { return cloud.isInitialized(); }
+bool benchHasLink() { return wifiConnected && cloud.isInitialized(); }
+bool benchHasSd() { return sdAvailable; }
+bool benchHasSramCopy() { return benchCopyReady(MEM_INTERNAL); }
+bool benchHasPsramCopy() { return benchCopyReady(MEM_PSRAM); }
+
+static const BenchCase BENCH_CASES[] = {
+    { "soul",       200, benchSoulStep,   nullptr },
+    { "face",       100, benchFace,       benchHasDisplay },
+    { "oled",       100, benchOled,       benchHasDisplay },
+    { "eeprom",      10, benchEeprom,     benchHasEeprom },
+    { "littlefs",    10, benchLittleFS,   nullptr },
+    { "json",       200, benchSyncJson,   benchHasCloud },
+    { "tls",          5, benchTls,        benchHasLink },
+    { "sdlog",       50, benchSdLog,      benchHasSd },
+    { "copy_sram",  200, benchCopySram,   benchHasSramCopy },
+    { "copy_psram", 200, benchCopyPsram,  benchHasPsramCopy },
+};
+
+// only: one bench by name, nullptr for all. iters 0: each bench's default.
+void runBenches(const char* only, uint16_t iters) {
+    CpuBoost boost;
+    benchSoul = soul;
+    benchHeader(Serial, cpu.mhz());
+
+    for (const BenchCase& b : BENCH_CASES) {
+        if (only && strcmp(only, b.name) != 0) continue;
+        if (b.ready && !b.ready()) {
+            Serial.printf("BENCH_SKIP %s\n", b.name);
+            continue;
+        }
+        benchRun(b.name, iters ? iters : b.iters, b.run);
+    }
+    if (sdAvailable) SD.remove(BENCH_CHAT_FILE);
+    for (auto& pair : benchCopy) {
+        for (MemBlock& b : pair) memPlace.release(b);
+    }
+}
+
+// ============================================================================
+// SERIAL CONSOLE
+// ============================================================================
+void cmdHelp(const char* args) {
+    console.printHelp();
+}
+
+void cmdStatus(const char* args) {
+    Serial.printf("[Status] %s (%s), up %lu s, mode %d\n", FW_VERSION, FW_BUILD,
+                  millis() / 1000, (int)currentMode);
+    soul.printStatus();
+    if (wifiConnected) {
+        Serial.printf("  WiFi: %s (%d dBm)\n", WiFi.SSID().c_str(), (int)WiFi.RSSI());
+    } else {
+        Serial.printf("  WiFi: %s\n", wifiParked ? "parked" : "down");
+    }
+    Serial.printf("  Cloud: %s, token %s, billing %s, %u care queued\n",
+                  cloud.isInitialized() ? "configured" : "off",
+                  cloud.isTokenValid() ? "ok" : "invalid",
+                  cloud.isBillingOk() ? "ok" : "limit", careQueue.count);
+    Serial.printf("  Power: %s tier, battery %u%%, %lu MHz, panel %d\n",
+                  policy.knobs().name, policy.getPercent(),
+                  (unsigned long)cpu.mhz(), (int)display.getPanel());
+    Serial.printf("  Heap: %lu free\n", (unsigned long)ESP.getFreeHeap());
+    LogStats log = logger.getStats();
+    Serial.printf("  Log: %lu lines, %lu dropped, %lu cut\n", (unsigned long)log.lines,
+                  (unsigned long)log.dropped, (unsigned long)log.truncated);
+}
+
+void cmdSync(const char* args) {
+    Serial.println(F("[Sync] Syncing with cloud..."));
+    syncWithCloud();
+}
+
+// /agent lists, /agent next cycles, /agent <name|index> selects
+void cmdAgent(const char* args) {
+    if (!*args) {
+        for (int i = 0; i < Soul::NUM_AGENTS; i++) {
+            Serial.printf("  %d %s%s\n", i, Soul::AGENTS[i],
+                          strcmp(Soul::AGENTS[i], soul.getAgentName()) == 0 ? " *" : "");
+        }
+        return;
+    }
+    if (strcmp(args, "next") == 0) {
+        soul.nextAgent();
+    } else {
+        int pick = -1;
+        for (int i = 0; i < Soul::NUM_AGENTS; i++) {
+            if (strcasecmp(args, Soul::AGENTS[i]) == 0) pick = i;
+        }
+        if (pick < 0 && isdigit((unsigned char)args[0])) pick = atoi(args);
+        if (pick < 0 || pick >= Soul::NUM_AGENTS) {
+            Serial.printf("[Agent] No agent '%s'\n", args);
+            return;
+        }
+        soul.setAgent(pick);
+    }
+    soul.save();
+    playMelody(MELODY_AGENT);
+    display.showMessage(soul.getAgentName(), 1500);
+    Serial.printf("[Agent] %s\n", soul.getAgentName());
+}
+
+// /bench [cpu], /bench all [iters], /bench <name> [iters]
+void cmdBench(const char* args) {
+    char name[16] = "cpu";
+    int iters = 0;
+    sscanf(args, "%15s %d", name, &iters);
+    if (iters < 0) iters = 0;
+
+    if (strcmp(name, "cpu") == 0) {
+        cpu.runBench();
+        return;
+    }
+    if (strcmp(name, "all") == 0) {
+        runBenches(nullptr, iters);
+        return;
+    }
+    for (const BenchCase& b : BENCH_CASES) {
+        if (strcmp(name, b.name) == 0) {
+            runBenches(b.name, iters);
+            return;
+        }
+    }
+    Serial.print(F("[Bench] Suites: cpu all"));
+    for (const BenchCase& b : BENCH_CASES) Serial.printf(" %s", b.name);
+    Serial.println();
+}
+
+void cmdLog(const char* args) {
+    int lines = *args ? atoi(args) : 10;
+    if (lines <= 0) lines = 10;
+    if (!sdAvailable || !sdPrintChatTail(Serial, lines)) {
+        Serial.println(F("[Log] No chat log today"));
+    }
+}
+
+void cmdEnergy(const char* args) { energy.print(); }
+void cmdCpu(const char* args) { cpu.print(); }
+void cmdHeap(const char* args) {
+    heapMon.print();
+    memPlace.print();
+    jsonArena.print();
+}
+void cmdStack(const char* args) { stackMon.print(); }
+void cmdMetrics(const char* args) { metrics.writePrometheus(Serial); }
+
+void cmdTrace(const char* args) {
+    #ifdef FEATURE_TRACE
+    if (strcmp(args, "clear") == 0) {
+        tracer.clear();
+        Serial.println(F("[Trace] Cleared"));
+        return;
     }
+    Serial.printf("[Trace] %u events (%lu overwritten), JSON for ui.perfetto.dev:\n",
+                  tracer.size(), (unsigned long)tracer.getOverwritten());
+    tracer.exportJson(Serial);
+    #else
+    Serial.println(F("[Trace] Not in this build (env:esp32s3_trace)"));
+    #endif
+}
+void cmdI2c(const char* args) { detectI2C(true); }
+
+void cmdReload(const char* args) {
+    Serial.println(F("[Config] Checking config.json..."));
+    checkConfigReload(true);
+}
+
+void cmdBright(const char* args) {
+    if (strcmp(args, "low") == 0) display.setBrightness(BRIGHT_LOW);
+    else if (strcmp(args, "normal") == 0) display.setBrightness(BRIGHT_NORMAL);
+    else if (strcmp(args, "high") == 0) display.setBrightness(BRIGHT_HIGH);
+    Serial.printf("[Display] Brightness %d (low/normal/high)\n", display.getBrightness());
+}
+
+void cmdLink(const char* args) {
+    hostLink.start();
+}
+
+void cmdEcho(const char* args) {
+    console.setEcho(strcmp(args, "off") != 0);
+    Serial.printf("[Serial] Echo %s\n", console.getEcho() ? "on" : "off");
+}
+
+static const ConsoleCommand CONSOLE_COMMANDS[] = {
+    { "/help",   "this list",                       cmdHelp },
+    { "/status", "firmware, soul, link, power",     cmdStatus },
+    { "/sync",   "sync with the cloud now",         cmdSync },
+    { "/agent",  "[next|name|index] list or pick",  cmdAgent },
+    { "/bench",  "[cpu|all|name] [n] benchmarks",   cmdBench },
+    { "/log",    "[lines] tail today's chat log",   cmdLog },
+    { "/energy", "charge per subsystem",            cmdEnergy },
+    { "/cpu",    "clock residency",                 cmdCpu },
+    { "/heap",   "free, largest block, per tag",    cmdHeap },
+    { "/stack",  "task and path stack peaks",       cmdStack },
+    { "/trace",  "[clear] event trace as JSON",     cmdTrace },
+    { "/metrics", "Prometheus text exposition",     cmdMetrics },
+    { "/bright", "[low|normal|high] OLED contrast", cmdBright },
+    { "/reload", "re-read config.json",             cmdReload },
+    { "/i2c",    "full I2C scan",                   cmdI2c },
+    { "/echo",   "[on|off] echo typed input",       cmdEcho },
+    { "/link",   "binary link for tools/apexlink.py", cmdLink },
+};
+
+void initConsole() {
+    console.begin(CONSOLE_COMMANDS, sizeof(CONSOLE_COMMANDS) / sizeof(CONSOLE_COMMANDS[0]),
+                  consoleChat);
+    hostLink.begin(&soul, linkStatus, LINK_STATUS_SIZE);
+}
+
+// Registry for /metrics and the LAN exporter. Module state is read at
+// scrape time; the cloud client and the loop own their own counters.
+void initMetrics() {
+    if (metrics.size()) return;
+
+    static Gauge uptime("apex_uptime_seconds", "Time since boot",
+                        []() -> double { return millis() / 1000; });
+    static Gauge soulE("apex_soul_energy", "Soul E", []() -> double { return soul.getE(); });
+    static Gauge soulFloor("apex_soul_floor", "Soul E floor",
+                           []() -> double { return soul.getFloor(); });
+    static Counter interactions("apex_soul_interactions_total", "Love and poke events",
+                                []() -> double { return soul.getInteractions(); });
+    static Counter chats("apex_soul_chats_total", "Cloud chats over the soul's life",
+                         []() -> double { return soul.getTotalChats(); });
+    static Counter syncs("apex_soul_syncs_total", "Cloud syncs over the soul's life",
+                         []() -> double { return soul.getTotalSyncs(); });
+
+    static Gauge failures("apex_cloud_consecutive_failures", "Failed cloud calls in a row",
+                          []() -> double { return cloud.status.consecutive_failures; });
+    static Gauge backoff("apex_cloud_backoff_ms", "Current retry backoff",
+                         []() -> double { return cloud.status.backoff_ms; });
+    static Gauge msgUsed("apex_cloud_messages_used", "Chat messages used this period",
+                         []() -> double { return cloud.status.messages_used; });
+    static Gauge msgLimit("apex_cloud_messages_limit", "Chat message allowance",
+                          []() -> double { return cloud.status.messages_limit; });
+    static Gauge careQueued("apex_care_queue_depth", "Care events waiting for the cloud",
+                            []() -> double { return careQueue.count; });
+    static Counter careDropped("apex_care_dropped_total", "Care events lost to a full queue",
+                               []() -> double { return careQueue.dropped; });
+
+    static Gauge heapFree("apex_heap_free_bytes", "Internal heap free",
+                          []() -> double { return heap_caps_get_free_size(HEAP_REGION_CAPS[HEAP_INTERNAL]); });
+    static Gauge heapMin("apex_heap_min_free_bytes", "Internal heap low-water mark",
+                         []() -> double { return heap_caps_get_minimum_free_size(HEAP_REGION_CAPS[HEAP_INTERNAL]); });
+    static Gauge heapLargest("apex_heap_largest_block_bytes", "Largest internal allocation possible",
+                             []() -> double { return heap_caps_get_largest_free_block(HEAP_REGION_CAPS[HEAP_INTERNAL]); });
+
+    static Gauge wifiUp("apex_wifi_connected", "Associated to an access point",
+                        []() -> double { return wifiConnected; });
+    static Gauge rssi("apex_wifi_rssi_dbm", "Signal strength, 0 when not associated",
+                      []() -> double { return WiFi.RSSI(); });
+    static Gauge battery("apex_battery_percent", "Battery charge",
+                         []() -> double { return policy.getPercent(); });
+    static Gauge cpuMhz("apex_cpu_mhz", "CPU clock", []() -> double { return cpu.mhz(); });
+    static Counter logLines("apex_log_lines_total", "Log lines written",
+                            []() -> double { return logger.getStats().lines; });
+    static Counter logDropped("apex_log_dropped_total", "Log lines lost to a full ring",
+                              []() -> double { return logger.getStats().dropped; });
+
+    static Gauge hwOled("apex_hw_present", "Part found at boot",
+                        []() -> double { return hw.oled_found; }, "part=\"oled\"");
+    static Gauge hwEeprom("apex_hw_present", "", []() -> double { return hw.eeprom_found; },
+                          "part=\"eeprom\"");
+    static Gauge hwSd("apex_hw_present", "", []() -> double { return hw.sd_available; },
+                      "part=\"sd\"");
+    static Gauge hwBattery("apex_hw_present", "", []() -> double { return hw.battery_available; },
+                           "part=\"battery\"");
+
+    Metric* own[] = { &uptime, &soulE, &soulFloor, &interactions, &chats, &syncs,
+                      &failures, &backoff, &msgUsed, &msgLimit, &careQueued, &careDropped };
+    for (Metric* m : own) metrics.add(m);
+    cloud.registerMetrics(metrics);
+    memPlace.registerMetrics(metrics);
+    jsonArena.registerMetrics(metrics);
+
+    Metric* system[] = { &heapFree, &heapMin, &heapLargest, &wifiUp, &rssi, &wifiDrops,
+                         &battery, &cpuMhz, &logLines, &logDropped, &renderTime,
+                         &hwOled, &hwEeprom, &hwSd, &hwBattery };
+    for (Metric* m : system) metrics.add(m);
+
+    #ifdef FEATURE_METRICS_HTTP
+    static Counter scrapes("apex_metrics_scrapes_total", "HTTP scrapes answered",
+                           []() -> double { return metricsServer.getScrapes(); });
+    metrics.add(&scrapes);
+    #endif
+}
+
+// Host link status snapshot: soul, link, power, heap
+void linkStatus(JsonObject out) {
+    out["fw"] = FW_VERSION;
+    out["uptime_s"] = millis() / 1000;
+    out["heap_free"] = ESP.getFreeHeap();
+    out["E"] = soul.getE();
+    out["state"] = soul.getStateName();
+    out["agent"] = soul.getAgentName();
+    out["interactions"] = soul.getInteractions();
+    out["wifi"] = wifiConnected;
+    out["billing_ok"] = cloud.isBillingOk();
+    out["care_queued"] = careQueue.count;
+    out["tier"] = policy.knobs().name;
+    out["battery_pct"] = policy.getPercent();
+    out["cpu_mhz"] = cpu.mhz();
+    energy.toJson(out.createNestedObject("power"));
+    heapMon.toJson(out.createNestedObject("heap"));
+}
+
+// Plain text from the console: one chat round-trip
+void consoleChat(const char* text) {
+    wakePanel();
+    Serial.print(F("[You] "));
+    Serial.println(text);
+
+    display.setExpression(EXPR_THINKING);
+    display.showMessage("Thinking...", 10000);
+    display.renderFaceScreen(soul, wifiConnected, cloud.isConnected(),
+                             cloud.isBillingOk(), cloud.isTokenValid());
+
+    String response = chatWithCloud(text);
+
+    Serial.print(F("["));
+    Serial.print(soul.getAgentName());
+    Serial.print(F("] "));
+    Serial.println(response);
+
+    display.setExpression(display.stateToExpression(soul.getState()));
+    display.showMessage(response.c_str(), 5000);
+}
+
+// ============================================================================
+// CONFIG HOT-RELOAD
+// ============================================================================
+void checkConfigReload(bool force) {
+    unsigned long now = millis();
+    if (!force && now - lastConfigCheck < CONFIG_CHECK_INTERVAL_MS) return;
+    lastConfigCheck = now;
+    CpuBoost boost;  // SD mount, config.json hash and parse
+    HeapScope heapScope(HEAP_TAG_STORAGE);
+    StackScope stackScope(STACK_PATH_CONFIG);
+
+    // Hot-plug: card pulled since last check
+    if (sdAvailable && !sdCardPresent()) {
+        LOG_I(SD, "[SD] Card removed");
+        sdUnmount();
+        sdAvailable = false;
+        hw.sd_available = false;
+        memset(&configStamp, 0, sizeof(configStamp));
+        return;
+    }
+
+    // Hot-plug: card inserted (or boot mount failed). Without a card-detect
+    // pin each try is a full SD.begin() timeout, so misses back off.
+    if (!sdAvailable) {
+        if (!force && (long)(now - sdRetryAt) < 0) return;
+        if (!sdInit(false)) {
+            sdRetryAt = now + sdRetryMs;
+            sdRetryMs = min(sdRetryMs * 2, (unsigned long)SD_RETRY_MAX_MS);
+            return;
+        }
+        sdRetryMs = CONFIG_CHECK_INTERVAL_MS;
+        LOG_I(SD, "[SD] Card inserted");
+        sdAvailable = true;
+        hw.sd_available = true;
+    }
+
+    SdConfigStamp stamp;
+    sdConfigStamp(&stamp);
+    if (!stamp.present || !sdConfigChanged(&stamp, &configStamp)) {
+        configStamp = stamp;
+        return;
+    }
+
+    LOG_I(SD, "[Config] config.json changed, reloading");
+    if (reloadConfig()) {
+        configStamp = stamp;
+    }
+}
+
+// Apply a re-read config.json in place. The cloud client is re-initialized
+// only when URL/token/device id changed, and WiFi only drops the current
+// association when that network is no longer listed (or its password moved).
+bool reloadConfig() {
+    CloudConfig newCfg;
+    WifiNetwork newNets[MAX_WIFI_NETWORKS];
+    int newCount = 0;
+    memset(&newCfg, 0, sizeof(newCfg));
+    memset(newNets, 0, sizeof(newNets));
+
+    uint8_t brightness = display.getBrightness();
+    bool ok = sdReadConfig(&newCfg, newNets, &newCount, &brightness);
+    if (brightness != display.getBrightness()) {
+        display.setBrightness(brightness);
+        LOG_I(SD, "[Config] Brightness %d", brightness);
+    }
+    if (!ok) {
+        LOG_W(SD, "[Config] Reload failed, keeping current config");
+        return false;
+    }
+
+    bool cloudChanged = strcmp(newCfg.cloud_url, cloudCfg.cloud_url) != 0 ||
+                        strcmp(newCfg.device_token, cloudCfg.device_token) != 0 ||
+                        strcmp(newCfg.device_id, cloudCfg.device_id) != 0 ||
+                        newCfg.configured != cloudCfg.configured;
+
+    bool wifiChanged = newCount != wifiNetCount ||
+                       memcmp(newNets, wifiNets, sizeof(wifiNets)) != 0;
+
+    if (cloudChanged) {
+        cloudCfg = newCfg;
+        hw.cloud_configured = cloudCfg.configured;
+        sdSaveConfigToLittleFS(&cloudCfg);
+        cloud.resetStatus();
+        cloud.init(&cloudCfg);
+        LOG_I(SD, "[Config] Cloud config applied");
+    }
+
+    if (wifiChanged) {
+        memcpy(wifiNets, newNets, sizeof(wifiNets));
+        wifiNetCount = newCount;
+        parkedIndex = -1;           // Hint indexes the old list
+
+        bool keepLink = false;
+        if (wifiConnected) {
+            String current = WiFi.SSID();
+            for (int i = 0; i < wifiNetCount; i++) {
+                if (current == wifiNets[i].ssid) {
+                    // Same SSID still listed; keep it unless the password moved
+                    keepLink = (WiFi.psk() == wifiNets[i].pass);
+                    break;
+                }
+            }
+        }
+
+        if (!keepLink && (wifiConnected || wifiTryIndex >= 0)) {
+            LOG_I(SD, "[Config] WiFi list changed, reconnecting");
+            WiFi.disconnect();
+            wifiConnected = false;
+            wifiTryIndex = -1;
+        }
+        if (!wifiConnected) {
+            lastWifiAttempt = millis() - WIFI_RETRY_MS - 1;  // Retry on next loop
+        }
+        LOG_I(SD, "[Config] WiFi networks: %d", wifiNetCount);
+    }
+
+    if (cloudChanged && wifiConnected && cloud.isInitialized()) {
+        cloud.fetchStatus();
+    }
+
+    if (cloudChanged || wifiChanged) {
+        display.showMessage("Config reloaded", 1500);
+    } else {
+        LOG_I(SD, "[Config] No relevant changes");
+    }
+    return true;
+}
+
+// ============================================================================
+// DISPLAY POWER
+// ============================================================================
+// Full contrast while in use, minimum contrast after DISPLAY_DIM_MS, panel
+// off after DISPLAY_OFF_MS. The loop stops rendering while it's off.
+void checkDisplayPower() {
+    if (!display.isReady()) return;
+    unsigned long idleFor = millis() - lastActivity;
+    PanelState want = PANEL_ON;
+    if (idleFor >= DISPLAY_OFF_MS) want = PANEL_OFF;
+    else if (idleFor >= DISPLAY_DIM_MS) want = PANEL_DIM;
+
+    // Serial activity also brings it back; buttons go through wakePanel()
+    if (want != display.getPanel()) {
+        display.setPanel(want);
+        energy.set(RAIL_OLED, display.isLit());
+        if (want == PANEL_OFF) LOG_D(POWER, "[Display] Panel off");
+    }
+}
+
+// Button press edge: restore the panel. Returns true if it was off, in
+// which case the press is swallowed.
+bool wakePanel() {
+    PanelState was = display.getPanel();
+    lastActivity = millis();
+    if (was == PANEL_ON) return false;
+    display.setPanel(PANEL_ON);
+    energy.set(RAIL_OLED, true);
+    return was == PANEL_OFF;
+}
+
+// ============================================================================
+// SOUND CUES
+// ============================================================================
+static_assert(sizeof(STATE_MELODIES) / sizeof(STATE_MELODIES[0]) == STATE_COUNT,
+              "STATE_MELODIES needs one melody per AffectiveState");
+
+// Mood jingles only while the panel is lit, so slow decay crossing a state
+// boundary at night stays silent. The first call just records the state.
+void checkSoundCues() {
+    int8_t state = soul.getState();
+    if (state != lastCueState) {
+        if (lastCueState >= 0 && display.isLit()) {
+            playMelody(STATE_MELODIES[state]);
+        }
+        lastCueState = state;
+    }
+
+    int8_t billing = cloud.isBillingOk() ? 1 : 0;
+    if (billing != lastCueBilling) {
+        if (lastCueBilling == 1) playMelody(MELODY_BILLING, PRIO_ALERT);
+        lastCueBilling = billing;
+    }
+}
+
+// ============================================================================
+// BATTERY POLICY
+// ============================================================================
+void applyPolicy() {
+    const PolicyKnobs& k = policy.knobs();
+    audioSetVolume(k.volume);
+    display.setLookAround(k.idleAnimations);
+}
+
+// Re-sample the battery once a minute. At the reserve threshold save the
+// soul, get one last sync out (bringing the radio up if needed), then go to
+// deep sleep with only the button armed.
+void checkBatteryPolicy() {
+    if (policy.update()) {
+        applyPolicy();
+    }
+
+    if (policy.reserveReached()) {
+        LOG_W(POWER, "[Policy] Battery reserve, final save + sync");
+        soul.save();
+        display.showMessage("Battery low!", 3000);
+        finalSyncPending = true;
+        finalSyncStart = millis();
+        if (wifiParked) resumeWiFi();
+        else if (!wifiConnected && wifiTryIndex < 0) beginWiFiConnect();
+    }
+
+    if (!finalSyncPending) return;
+
+    bool canSync = wifiConnected && cloud.isInitialized() && cloud.isTokenValid();
+    bool timedOut = millis() - finalSyncStart > SYNC_CYCLE_TIMEOUT_MS;
+    if (!canSync && !timedOut) return;
+
+    finalSyncPending = false;
+    if (canSync && pushSync()) soul.recordSync();
+    soul.save();
+    cloud.endSession();
+    saveWakeSnapshot();
+
+    rtcSnapshot.wakeIntervalH = 0;
+    rtcSnapshotSeal();
+    display.setPanel(PANEL_OFF);
+    energy.set(RAIL_OLED, false);
+    energy.beforeDeepSleep(false);
+    energy.save();
+    enterDeepSleep(true, 0);
+}
+
+// ============================================================================
+// ENERGY ACCOUNTING
+// ============================================================================
+void onCloudRequest(bool starting, bool handshake) {
+    // TLS handshake and JSON parsing run at full clock
+    if (starting) {
+        cpu.boost();
+        energy.set(RAIL_WIFI_IDLE, false);
+        energy.set(RAIL_WIFI_ACTIVE, true);
+        if (handshake) {
+            energy.count(RAIL_TLS);
+            heapMon.checkTls();
+        }
+    } else {
+        cpu.unboost();
+        trackRadio();
+    }
+}
+
+void onCpuFreq(uint32_t mhz) {
+    energy.set(RAIL_CPU_BOOST, mhz >= CPU_BOOST_MHZ);
+}
+
+// Sync payload extras: charge per subsystem, heap health
+#define SYNC_TELEMETRY_SIZE (JSON_OBJECT_SIZE(2) + ENERGY_JSON_SIZE + HEAP_JSON_SIZE)
+
+void syncTelemetry(JsonObject doc) {
+    energy.toJson(doc.createNestedObject("power"));
+    heapMon.toJson(doc.createNestedObject("heap"));
+}
+
+// Placement policy before anything asks for a bulk buffer (memplace.h)
+void initMemory() {
+    memPlace.begin();
+    #ifdef FEATURE_TRACE
+    tracer.begin();
+    #endif
+}
+
+void initEnergy(bool coldBoot) {
+    energy.begin(coldBoot);
+    lastEnergySave = millis();
+    cloud.setRequestHook(onCloudRequest);
+    cloud.setTelemetryProvider(syncTelemetry, SYNC_TELEMETRY_SIZE);
+    heapMon.begin();
+    cpu.setListener(onCpuFreq);
+}
+
+// Radio rails follow the connector state
+void trackRadio() {
+    energy.set(RAIL_WIFI_ACTIVE, wifiTryIndex >= 0);
+    energy.set(RAIL_WIFI_IDLE, wifiConnected && wifiTryIndex < 0);
+    cpu.setRadio(WiFi.getMode() != WIFI_OFF);
 }
 
 // ============================================================================
@@ -587,24 +1780,181 @@ void checkAutoSync() {
 void checkIdleSleep() {
     #ifdef FEATURE_DEEPSLEEP
     unsigned long now = millis();
-    if (now - lastActivity > SLEEP_TIMEOUT_MS) {
-        Serial.println(F("[Power] Idle timeout, entering sleep..."));
-
-        // Sync before sleep if possible
-        if (wifiConnected && cloud.isInitialized() && cloud.isTokenValid()) {
-            cloud.sync(
-                soul.getE(), soul.getFloor(), soul.getPeak(),
-                soul.getInteractions(), soul.getTotalCare(),
-                soul.getStateName(), soul.getAgentName(),
-                soul.getCuriosity(), soul.getPlayfulness(), soul.getWisdom(),
-                FW_VERSION
-            );
+    if (now - lastActivity <= SLEEP_TIMEOUT_MS) {
+        sleepSyncPending = false;
+        return;
+    }
+
+    // Sync before sleep: the radio is usually parked by now, so bring it
+    // back (as the battery reserve does) and give it SYNC_CYCLE_TIMEOUT_MS.
+    // Tiers without auto-sync only sync if still associated.
+    bool cloudReady = cloud.isInitialized() && cloud.isTokenValid();
+    if (cloudReady && !wifiConnected && policy.knobs().syncIntervalMs != 0) {
+        if (!sleepSyncPending) {
+            sleepSyncPending = true;
+            sleepSyncStart = now;
+            if (wifiParked) resumeWiFi();
+            else if (wifiTryIndex < 0) beginWiFiConnect();
         }
+        if (now - sleepSyncStart <= SYNC_CYCLE_TIMEOUT_MS) return;
+    }
+    sleepSyncPending = false;
+
+    LOG_I(POWER, "[Power] Idle timeout, entering sleep...");
+
+    if (wifiConnected && cloudReady && pushSync()) soul.recordSync();
+    cloud.endSession();
+
+    soul.save();
+    saveWakeSnapshot();
+    display.setPanel(PANEL_ON);
+    display.renderSleepScreen(soul);
+    delay(1000);
+    display.setPanel(PANEL_OFF);
+    energy.set(RAIL_OLED, false);
+    energy.beforeDeepSleep(false);
+    energy.save();
+    enterDeepSleep(false, policy.knobs().wakeIntervalH);
+    #endif
+}
 
-        soul.save();
-        display.renderSleepScreen(soul);
-        delay(1000);
-        enterDeepSleep();
+// ============================================================================
+// IDLE LIGHT SLEEP
+// ============================================================================
+// After LIGHT_SLEEP_IDLE_MS without input on the face screen the eyes stop
+// wandering and the CPU light-sleeps until the next blink or a button press.
+// Manual light sleep doesn't keep the WiFi association alive, so the radio
+// is parked on purpose and resumed (channel/BSSID hinted) on the next input.
+// It stays up (and the loop doesn't nap) while something needs it: a due
+// auto-sync, the pre-sleep or battery reserve sync, or the LAN metrics
+// endpoint. Those paths resume a parked radio themselves.
+
+// How long the loop may nap right now; 0 means keep the full frame rate
+unsigned long idleNapBudget(unsigned long now) {
+    #ifdef FEATURE_LIGHTSLEEP
+    if (!display.isIdle()) return 0;
+
+    #if ARDUINO_USB_CDC_ON_BOOT
+    if (Serial) return 0;   // Host attached: keep the console responsive
+    #endif
+
+    // A held button would fire the level wake straight away, and gesture
+    // timing (long press, double tap window) needs the loop running
+    if (buttons.busy()) return 0;
+    if (hostLink.isActive()) return 0;  // UART drops bytes while napping
+    if (wifiTryIndex >= 0 || cloudCheckPending || deferredStorageInit) return 0;
+    if (audioBusy()) return 0;  // LEDC stops in light sleep
+    if (wifiConnected) return 0;  // Radio kept up on purpose, see radioWanted()
+
+    unsigned long budget = display.msUntilNextChange();
+
+    // $ and ! indicators flash at 2 Hz
+    if (display.isLit() && (!cloud.isBillingOk() || !cloud.isTokenValid())) {
+        budget = min(budget, 500 - now % 500);
+    }
+
+    // Don't oversleep the deep sleep timeout
+    unsigned long idleFor = now - lastActivity;
+    budget = idleFor < SLEEP_TIMEOUT_MS ? min(budget, SLEEP_TIMEOUT_MS - idleFor) : 0;
+
+    budget = min(budget, (unsigned long)LIGHT_SLEEP_MAX_MS);
+    return budget >= LIGHT_SLEEP_MIN_MS ? budget : 0;
+    #else
+    return 0;
+    #endif
+}
+
+// Reasons to keep the radio up while idle instead of parking it
+bool radioWanted(unsigned long now) {
+    if (finalSyncPending || sleepSyncPending || autoSyncWaiting) return true;
+    if (autoSyncDue(now)) return true;
+    #ifdef FEATURE_METRICS_HTTP
+    if (metricsServer.isListening()) return true;   // LAN scrapes need it
+    #endif
+    return false;
+}
+
+void idleFrameDelay() {
+    unsigned long now = millis();
+    bool idle = (currentMode == MODE_FACE || !display.isLit()) &&
+                now - lastActivity >= LIGHT_SLEEP_IDLE_MS;
+
+    if (idle != display.isIdle()) {
+        display.setIdle(idle);
+        if (idle) {
+            idleSince = now;
+            idleNaps = 0;
+            idleSleptMs = 0;
+        } else if (idleNaps > 0) {
+            LOG_D(POWER, "[Power] Idle %lu ms, %lu naps, %lu ms light sleep",
+                  now - idleSince, (unsigned long)idleNaps,
+                  (unsigned long)idleSleptMs);
+        }
+    }
+
+    #ifdef FEATURE_LIGHTSLEEP
+    if (idle && !wifiParked && !cloudCheckPending && !radioWanted(now)) {
+        parkWiFi();
     }
     #endif
+
+    unsigned long napMs = idleNapBudget(now);
+    if (napMs > 0) {
+        energy.set(RAIL_CPU, false);
+        energy.set(RAIL_LIGHT_SLEEP, true);
+        buttons.beforeNap();
+        TRACE_BEGIN(TRACE_POWER, "light_sleep");
+        idleSleptMs += lightSleep(napMs);
+        TRACE_END(TRACE_POWER, "light_sleep");
+        buttons.afterNap();
+        energy.set(RAIL_LIGHT_SLEEP, false);
+        energy.set(RAIL_CPU, true);
+        idleNaps++;
+    } else {
+        // The clock may drop during the wait, unless the buzzer's LEDC
+        // output is running
+        bool buzzing = audioBusy();
+        if (buzzing) cpu.lockApb();
+        cpu.beginWait();
+        delay(1000 / policy.knobs().fps);
+        cpu.endWait();
+        if (buzzing) cpu.unlockApb();
+    }
+}
+
+// Remember the current association (network, BSSID, channel) for the next
+// resume or wake. Not associated: the previous hint stays.
+bool captureWiFiHint() {
+    if (!wifiConnected || WiFi.status() != WL_CONNECTED) return false;
+    uint8_t* bssid = WiFi.BSSID();
+    if (!bssid) return false;
+    memcpy(parkedBssid, bssid, sizeof(parkedBssid));
+    parkedChannel = WiFi.channel();
+    parkedIndex = wifiConnectedIndex;
+    return true;
+}
+
+void parkWiFi() {
+    captureWiFiHint();
+    cloud.endSession();
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_OFF);
+    wifiTryIndex = -1;
+    wifiConnected = false;
+    wifiParked = true;
+    trackRadio();
+    bootProf.end("wifi");
+    TRACE_INSTANT(TRACE_WIFI, "park", 0);
+    LOG_I(POWER, "[Power] Idle, radio parked");
+}
+
+void resumeWiFi() {
+    TRACE_INSTANT(TRACE_WIFI, "resume", 0);
+    wifiParked = false;
+    WiFi.mode(WIFI_STA);
+    lastWifiAttempt = millis();
+    if (parkedIndex >= 0 && startWiFiAttempt(parkedIndex, parkedChannel, parkedBssid)) {
+        return;
+    }
+    beginWiFiConnect();
 }
@@ -0,0 +1,204 @@
+/*
+ * RTTTL Melodies
+ *
+ * Melodies are written as RTTTL strings ("name:d=8,o=5,b=120:c,e,4g") and
+ * parsed by the compiler into 2-byte note events, so each jingle costs a
+ * few bytes of flash and no parsing at runtime. A malformed string fails
+ * the build at the offending melody (rtttlSyntaxError in the notes).
+ *
+ * Notes span C4..B7; p is a rest. Durations 1..32, dotted allowed.
+ */
+
+#ifndef MELODY_H
+#define MELODY_H
+
+#include <Arduino.h>
+#include "audio.h"
+
+#define MELODY_MAX_NOTES    (AUDIO_QUEUE_LEN / 2)   // Each note + its gap
+#define MELODY_LEN_WHOLE    64                      // Length units per whole note
+
+// One note event: pitch index and length in 1/64 whole notes
+struct PackedNote {
+    uint8_t pitch;              // 0 = rest, 1..48 = C4..B7
+    uint8_t len;
+};
+
+template <size_t N>
+struct Melody {
+    uint16_t bpm;
+    PackedNote notes[N];
+};
+
+// Octaves 4..7, C to B
+static const uint16_t MELODY_PITCH_HZ[48] = {
+     262,  277,  294,  311,  330,  349,  370,  392,  415,  440,  466,  494,
+     523,  554,  587,  622,  659,  698,  740,  784,  831,  880,  932,  988,
+    1047, 1109, 1175, 1245, 1319, 1397, 1480, 1568, 1661, 1760, 1865, 1976,
+    2093, 2217, 2349, 2489, 2637, 2794, 2960, 3136, 3322, 3520, 3729, 3951,
+};
+
+// ============================================================================
+// COMPILE-TIME PARSER
+// ============================================================================
+// Deliberately not constexpr: reaching it during constant evaluation is
+// what turns a bad melody into a compile error.
+inline void rtttlSyntaxError() {}
+
+namespace rtttl {
+
+struct Header {
+    uint8_t duration;
+    uint8_t octave;
+    uint16_t bpm;
+    const char* body;
+};
+
+constexpr bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+constexpr uint16_t readNumber(const char*& s) {
+    uint16_t n = 0;
+    while (isDigit(*s)) n = n * 10 + (*s++ - '0');
+    return n;
+}
+
+constexpr Header header(const char* s) {
+    Header h = { 4, 6, 63, nullptr };   // RTTTL defaults
+    while (*s && *s != ':') s++;        // Name
+    if (*s != ':') rtttlSyntaxError();
+    s++;
+    while (*s && *s != ':') {
+        char key = *s++;
+        if (*s++ != '=') rtttlSyntaxError();
+        uint16_t value = readNumber(s);
+        if (key == 'd') h.duration = value;
+        else if (key == 'o') h.octave = value;
+        else if (key == 'b') h.bpm = value;
+        else rtttlSyntaxError();
+        if (*s == ',') s++;
+    }
+    if (*s != ':') rtttlSyntaxError();
+    h.body = s + 1;
+    return h;
+}
+
+constexpr size_t count(const char* s) {
+    const char* body = header(s).body;
+    if (!*body) rtttlSyntaxError();
+    size_t n = 1;
+    for (; *body; body++) {
+        if (*body == ',') n++;
+    }
+    return n;
+}
+
+constexpr uint8_t lengthOf(uint16_t duration, bool dotted) {
+    if (duration == 0 || duration > 32 || (duration & (duration - 1))) rtttlSyntaxError();
+    uint8_t len = MELODY_LEN_WHOLE / duration;
+    return dotted ? len + len / 2 : len;
+}
+
+constexpr uint8_t semitone(char c) {
+    switch (c) {
+        case 'c': return 0;
+        case 'd': return 2;
+        case 'e': return 4;
+        case 'f': return 5;
+        case 'g': return 7;
+        case 'a': return 9;
+        case 'b': return 11;
+        default: rtttlSyntaxError(); return 0;
+    }
+}
+
+template <size_t N>
+constexpr Melody<N> parse(const char* s) {
+    Header h = header(s);
+    Melody<N> m = {};
+    m.bpm = h.bpm;
+
+    const char* p = h.body;
+    for (size_t i = 0; i < N; i++) {
+        uint16_t duration = isDigit(*p) ? readNumber(p) : h.duration;
+        char name = *p++;
+        bool sharp = false, dotted = false;
+        if (*p == '#') { sharp = true; p++; }
+        if (*p == '.') { dotted = true; p++; }
+        uint16_t octave = isDigit(*p) ? readNumber(p) : h.octave;
+        if (*p == '.') { dotted = true; p++; }
+        if (*p == ',') p++;
+        else if (*p) rtttlSyntaxError();
+
+        m.notes[i].len = lengthOf(duration, dotted);
+        if (name == 'p') {
+            m.notes[i].pitch = 0;
+        } else {
+            if (octave < 4 || octave > 7) rtttlSyntaxError();
+            uint8_t pitch = (octave - 4) * 12 + semitone(name) + (sharp ? 1 : 0) + 1;
+            if (pitch > 48) rtttlSyntaxError();     // b#7 is past the table
+            m.notes[i].pitch = pitch;
+        }
+    }
+    return m;
+}
+
+} // namespace rtttl
+
+// Parsed into flash; static_assert keeps it within the audio queue
+#define MELODY(name, str) \
+    static constexpr auto name = rtttl::parse<rtttl::count(str)>(str); \
+    static_assert(sizeof(name.notes) / sizeof(PackedNote) <= MELODY_MAX_NOTES, \
+                  #name " is too long for the audio queue")
+
+// Size-erased view, so melodies of any length fit in one table
+struct MelodyRef {
+    uint16_t bpm;
+    uint8_t count;
+    const PackedNote* notes;
+
+    template <size_t N>
+    constexpr MelodyRef(const Melody<N>& m) : bpm(m.bpm), count(N), notes(m.notes) {}
+};
+
+// ============================================================================
+// MELODIES
+// ============================================================================
+MELODY(MELODY_BOOT,     "boot:d=8,o=5,b=300:c,32p,e,32p,g.");
+MELODY(MELODY_SYNC,     "sync:d=16,o=6,b=200:e,g,8c7");
+MELODY(MELODY_BILLING,  "billing:d=8,o=5,b=120:e,c,4a4");
+MELODY(MELODY_AGENT,    "agent:d=16,o=6,b=240:c,e,g");
+
+// One per AffectiveState, darker and slower at the bottom of the scale
+MELODY(MELODY_PROTECTING,   "protecting:d=8,o=4,b=90:a,f,4d");
+MELODY(MELODY_GUARDED,      "guarded:d=8,o=4,b=110:c5,a,4b");
+MELODY(MELODY_TENDER,       "tender:d=8,o=5,b=100:e,g,4a");
+MELODY(MELODY_WARM,         "warm:d=8,o=5,b=120:c,e,g,4c6");
+MELODY(MELODY_FLOURISHING,  "flourishing:d=16,o=5,b=140:c,e,g,c6,8e6");
+MELODY(MELODY_RADIANT,      "radiant:d=16,o=6,b=160:c,e,g,e,8c7");
+MELODY(MELODY_TRANSCENDENT, "transcendent:d=16,o=6,b=180:c,g,e7,g,c7,p,4c7");
+
+static constexpr MelodyRef STATE_MELODIES[] = {
+    MELODY_PROTECTING, MELODY_GUARDED, MELODY_TENDER, MELODY_WARM,
+    MELODY_FLOURISHING, MELODY_RADIANT, MELODY_TRANSCENDENT,
+};
+
+// ============================================================================
+// PLAYER
+// ============================================================================
+// Expand into sequencer notes: 90% tone + 10% gap, rests as-is
+inline uint8_t melodyExpand(const MelodyRef& m, AudioNote* out) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < m.count && n + 2 <= AUDIO_QUEUE_LEN; i++) {
+        uint16_t ms = (uint32_t)m.notes[i].len * (60000UL * 4 / MELODY_LEN_WHOLE) / m.bpm;
+        uint8_t pitch = m.notes[i].pitch;
+        if (pitch == 0) {
+            out[n++] = { 0, ms };
+        } else {
+            out[n++] = { MELODY_PITCH_HZ[pitch - 1], (uint16_t)(ms - ms / 10) };
+            out[n++] = { 0, (uint16_t)(ms / 10) };
+        }
+    }
+    return n;
+}
+
+#endif // MELODY_H
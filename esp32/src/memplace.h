@@ -0,0 +1,146 @@
+/*
+ * Memory Placement
+ *
+ * Which RAM a large buffer lives in. Internal SRAM is fast and scarce
+ * (~320 KB, shared with WiFi, lwIP and TLS); the Sense's 8 MB of octal
+ * PSRAM is plentiful but sits behind the data cache, so a miss costs a
+ * bus transaction. The policy follows from that:
+ *
+ *   MEM_HOT   the OLED framebuffer, the soul, task stacks, anything read
+ *             every frame or by DMA: always internal
+ *   MEM_BULK  buffers written once and read a few times per request (JSON
+ *             arena, trace ring, chat log lines): PSRAM when fitted,
+ *             internal otherwise
+ *
+ * Our own buffers ask alloc() with their class. Buffers allocated by
+ * libraries go through plain malloc(); with PSRAM, begin() lowers the size
+ * from which malloc() tries PSRAM first to MEM_EXTMEM_MIN. That catches
+ * mbedTLS's 16 KB record buffers and large HTTP response Strings while the
+ * 1 KB framebuffer and small, frequent allocations stay internal.
+ *
+ * PSRAM is used only in builds that have it (HAS_PSRAM, env:esp32s3_sense)
+ * and only when the chip found it at boot; anything else places every
+ * class internally, so the policy is picked per build variant.
+ */
+
+#ifndef MEMPLACE_H
+#define MEMPLACE_H
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "config.h"
+#include "metrics.h"
+#include "log.h"
+
+#ifndef HAS_PSRAM
+#define HAS_PSRAM           false
+#endif
+
+#define MEM_EXTMEM_MIN      2048        // malloc()s this big try PSRAM first; above the framebuffer
+#define MEM_CAPS_INTERNAL   (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+#define MEM_CAPS_PSRAM      (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+
+enum MemClass : uint8_t {
+    MEM_HOT,                // Per frame, ISR or DMA: internal only
+    MEM_BULK,               // Large, touched a few times per request: PSRAM if fitted
+};
+
+enum MemRegion : uint8_t {
+    MEM_INTERNAL,
+    MEM_PSRAM,
+    MEM_REGION_COUNT
+};
+
+static const char* const MEM_REGION_NAMES[MEM_REGION_COUNT] = { "internal", "psram" };
+
+// What alloc() handed out; give the same block back to release()
+struct MemBlock {
+    void* ptr;              // nullptr: no room anywhere
+    uint32_t size;
+    MemRegion region;
+};
+
+class MemPlacement {
+private:
+    bool psram;             // Build has it and the chip found it
+    uint32_t held[MEM_REGION_COUNT];
+    uint32_t fallbacks;     // Bulk blocks PSRAM couldn't take
+
+    Gauge internalBytes{"apex_mem_placed_bytes", "Buffer bytes held, by where the policy put them",
+                        "region=\"internal\""};
+    Gauge psramBytes{"apex_mem_placed_bytes", "", "region=\"psram\""};
+    Counter fallbackCount{"apex_mem_psram_fallbacks_total", "Bulk buffers placed internally, PSRAM full"};
+
+    void account(MemRegion region, int32_t bytes) {
+        held[region] += bytes;
+        (region == MEM_PSRAM ? psramBytes : internalBytes).set(held[region]);
+    }
+
+public:
+    MemPlacement() : psram(false), fallbacks(0) { memset(held, 0, sizeof(held)); }
+
+    // Once at boot, before the first bulk buffer
+    void begin() {
+        #if HAS_PSRAM
+        psram = psramFound();
+        if (psram) {
+            heap_caps_malloc_extmem_enable(MEM_EXTMEM_MIN);
+            LOG_I(SYS, "[Mem] PSRAM %lu KB: bulk buffers and malloc >= %u bytes go there",
+                  (unsigned long)(heap_caps_get_total_size(MEM_CAPS_PSRAM) / 1024), MEM_EXTMEM_MIN);
+        } else {
+            LOG_W(SYS, "[Mem] PSRAM build, none found: everything internal");
+        }
+        #else
+        psram = false;
+        #endif
+    }
+
+    bool hasPsram() { return psram; }
+
+    MemBlock alloc(size_t size, MemClass cls, const char* what) {
+        MemBlock b = { nullptr, (uint32_t)size, MEM_INTERNAL };
+        if (cls == MEM_BULK && psram) {
+            b.ptr = heap_caps_malloc(size, MEM_CAPS_PSRAM);
+            if (b.ptr) {
+                b.region = MEM_PSRAM;
+            } else {
+                fallbacks++;
+                fallbackCount.inc();
+                LOG_W(SYS, "[Mem] %s: %u bytes not in PSRAM, trying internal", what, (unsigned)size);
+            }
+        }
+        if (!b.ptr) b.ptr = heap_caps_malloc(size, MEM_CAPS_INTERNAL);
+        if (!b.ptr) {
+            LOG_E(SYS, "[Mem] %s: no room for %u bytes", what, (unsigned)size);
+            return b;
+        }
+        account(b.region, size);
+        LOG_D(SYS, "[Mem] %s: %u bytes %s", what, (unsigned)size, MEM_REGION_NAMES[b.region]);
+        return b;
+    }
+
+    void release(MemBlock& b) {
+        if (!b.ptr) return;
+        heap_caps_free(b.ptr);
+        account(b.region, -(int32_t)b.size);
+        b.ptr = nullptr;
+    }
+
+    uint32_t getHeld(MemRegion region) { return held[region]; }
+    uint32_t getFallbacks() { return fallbacks; }
+
+    void registerMetrics(MetricsRegistry& reg) {
+        Metric* all[] = { &internalBytes, &psramBytes, &fallbackCount };
+        for (Metric* m : all) reg.add(m);
+    }
+
+    void print() {
+        Serial.printf("  Placement: %lu bytes internal, %lu PSRAM%s, %lu fallbacks\n",
+                      (unsigned long)held[MEM_INTERNAL], (unsigned long)held[MEM_PSRAM],
+                      psram ? "" : " (none)", (unsigned long)fallbacks);
+    }
+};
+
+extern MemPlacement memPlace;
+
+#endif // MEMPLACE_H
@@ -0,0 +1,285 @@
+/*
+ * Metrics
+ *
+ * Counters, gauges and fixed-bucket histograms in one registry, printed as
+ * Prometheus text (exposition format 0.0.4) by /metrics. With
+ * FEATURE_METRICS_HTTP the same text is served on the LAN at
+ * http://<ip>:METRICS_HTTP_PORT/metrics, so a local Prometheus can scrape
+ * a whole fleet of pockets.
+ *
+ * A metric is a plain object owned by the module it describes, and the
+ * registry keeps pointers to up to METRICS_MAX of them: registering and
+ * updating never allocate. Counters and gauges update atomically from any
+ * task; a histogram belongs to the task that observes it. State a module
+ * already keeps (soul stats, cloud status, heap) is registered with a read
+ * function and sampled at scrape time rather than mirrored.
+ *
+ * Metrics that share a name (one per label set) are added one after the
+ * other; HELP and TYPE are printed once per name.
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "config.h"
+#include "log.h"
+
+#ifdef FEATURE_METRICS_HTTP
+#include <WiFi.h>
+#endif
+
+#define METRICS_MAX         48
+#define METRICS_MAX_BUCKETS 8           // Bounds per histogram, +Inf not counted
+#define METRICS_HTTP_PORT   9100        // Prometheus exporter convention
+#define METRICS_HTTP_WAIT_MS 200        // Request head from a scraper on the LAN
+#define METRICS_CHUNK       512         // Response bytes per TCP write
+
+enum MetricType : uint8_t {
+    METRIC_COUNTER,
+    METRIC_GAUGE,
+    METRIC_HISTOGRAM,
+};
+
+static const char* const METRIC_TYPE_NAMES[] = { "counter", "gauge", "histogram" };
+
+// Scrape-time value of state kept elsewhere
+typedef double (*MetricReadFn)();
+
+class Metric {
+public:
+    const char* name;       // apex_<subsystem>_<what>[_unit][_total]
+    const char* help;
+    const char* labels;     // key="value",... or nullptr
+    MetricType type;
+
+    Metric(const char* n, const char* h, const char* l, MetricType t)
+        : name(n), help(h), labels(l), type(t) {}
+    virtual ~Metric() {}
+
+    virtual void writeSamples(Print& out) = 0;
+
+protected:
+    // name[suffix]{labels[,extra]} value
+    void writeSample(Print& out, const char* suffix, const char* extra, double value) {
+        out.print(name);
+        if (suffix) out.print(suffix);
+        if (labels || extra) {
+            out.print('{');
+            if (labels) out.print(labels);
+            if (labels && extra) out.print(',');
+            if (extra) out.print(extra);
+            out.print('}');
+        }
+        out.printf(" %.10g\n", value);
+    }
+};
+
+class Counter : public Metric {
+private:
+    std::atomic<uint32_t> count;
+    MetricReadFn read;
+
+public:
+    Counter(const char* name, const char* help, const char* labels = nullptr)
+        : Metric(name, help, labels, METRIC_COUNTER), count(0), read(nullptr) {}
+    Counter(const char* name, const char* help, MetricReadFn fn, const char* labels = nullptr)
+        : Metric(name, help, labels, METRIC_COUNTER), count(0), read(fn) {}
+
+    void inc(uint32_t n = 1) { count.fetch_add(n, std::memory_order_relaxed); }
+    double value() { return read ? read() : count.load(std::memory_order_relaxed); }
+
+    void writeSamples(Print& out) override { writeSample(out, nullptr, nullptr, value()); }
+};
+
+class Gauge : public Metric {
+private:
+    std::atomic<float> current;
+    MetricReadFn read;
+
+public:
+    Gauge(const char* name, const char* help, const char* labels = nullptr)
+        : Metric(name, help, labels, METRIC_GAUGE), current(0), read(nullptr) {}
+    Gauge(const char* name, const char* help, MetricReadFn fn, const char* labels = nullptr)
+        : Metric(name, help, labels, METRIC_GAUGE), current(0), read(fn) {}
+
+    void set(float v) { current.store(v, std::memory_order_relaxed); }
+    double value() { return read ? read() : current.load(std::memory_order_relaxed); }
+
+    void writeSamples(Print& out) override { writeSample(out, nullptr, nullptr, value()); }
+};
+
+// Upper bounds ascending, in the unit the name says (ms, us, bytes)
+class Histogram : public Metric {
+private:
+    const uint32_t* bounds;
+    uint8_t nBounds;
+    uint32_t buckets[METRICS_MAX_BUCKETS + 1];     // Last one: above every bound
+    uint32_t count;
+    uint64_t sum;
+
+public:
+    Histogram(const char* name, const char* help, const uint32_t* b, uint8_t n,
+              const char* labels = nullptr)
+        : Metric(name, help, labels, METRIC_HISTOGRAM), bounds(b),
+          nBounds(min(n, (uint8_t)METRICS_MAX_BUCKETS)), count(0), sum(0) {
+        memset(buckets, 0, sizeof(buckets));
+    }
+
+    void observe(uint32_t v) {
+        uint8_t i = 0;
+        while (i < nBounds && v > bounds[i]) i++;
+        buckets[i]++;
+        count++;
+        sum += v;
+    }
+
+    uint32_t getCount() { return count; }
+    uint64_t getSum() { return sum; }
+    uint32_t bucket(uint8_t i) { return buckets[i]; }
+
+    // Prometheus buckets are cumulative: le="500" counts everything <= 500
+    void writeSamples(Print& out) override {
+        char le[20];
+        uint32_t cumulative = 0;
+        for (uint8_t i = 0; i < nBounds; i++) {
+            cumulative += buckets[i];
+            snprintf(le, sizeof(le), "le=\"%lu\"", (unsigned long)bounds[i]);
+            writeSample(out, "_bucket", le, cumulative);
+        }
+        writeSample(out, "_bucket", "le=\"+Inf\"", count);
+        writeSample(out, "_sum", nullptr, (double)sum);
+        writeSample(out, "_count", nullptr, count);
+    }
+};
+
+class MetricsRegistry {
+private:
+    Metric* metrics[METRICS_MAX];
+    uint8_t count;
+
+public:
+    MetricsRegistry() : count(0) {}
+
+    bool add(Metric* m) {
+        if (count >= METRICS_MAX) {
+            LOG_W(SYS, "[Metrics] Registry full, %s left out", m->name);
+            return false;
+        }
+        metrics[count++] = m;
+        return true;
+    }
+
+    uint8_t size() { return count; }
+
+    void writePrometheus(Print& out) {
+        const char* last = nullptr;
+        for (uint8_t i = 0; i < count; i++) {
+            Metric* m = metrics[i];
+            if (!last || strcmp(last, m->name) != 0) {
+                out.printf("# HELP %s %s\n", m->name, m->help);
+                out.printf("# TYPE %s %s\n", m->name, METRIC_TYPE_NAMES[m->type]);
+                last = m->name;
+            }
+            m->writeSamples(out);
+        }
+    }
+};
+
+extern MetricsRegistry metrics;
+
+// Collects small writes into one TCP segment's worth
+class ChunkedPrint : public Print {
+private:
+    Print& out;
+    uint8_t buf[METRICS_CHUNK];
+    size_t len;
+
+public:
+    explicit ChunkedPrint(Print& target) : out(target), len(0) {}
+    ~ChunkedPrint() { flush(); }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* data, size_t size) override {
+        for (size_t i = 0; i < size; i++) {
+            if (len == sizeof(buf)) flush();
+            buf[len++] = data[i];
+        }
+        return size;
+    }
+    using Print::write;
+
+    void flush() override {
+        if (len) out.write(buf, len);
+        len = 0;
+    }
+};
+
+#ifdef FEATURE_METRICS_HTTP
+
+// Scrape endpoint. Accepting is non-blocking and polled from the loop, so
+// nothing runs while no scraper is connected; a request is answered in one
+// go and the connection closed. Listens only while WiFi is associated.
+class MetricsServer {
+private:
+    WiFiServer server;
+    bool listening;
+    uint32_t scrapes;
+
+public:
+    MetricsServer() : server(METRICS_HTTP_PORT), listening(false), scrapes(0) {}
+
+    // Follow the association: call on connect and on drop/park
+    void setOnline(bool online) {
+        if (online == listening) return;
+        listening = online;
+        if (online) {
+            server.begin();
+            server.setNoDelay(true);
+            LOG_I(SYS, "[Metrics] http://%s:%u/metrics", WiFi.localIP().toString().c_str(),
+                  METRICS_HTTP_PORT);
+        } else {
+            server.end();
+        }
+    }
+
+    bool isListening() { return listening; }
+    uint32_t getScrapes() { return scrapes; }
+
+    void poll() {
+        if (!listening) return;
+        WiFiClient client = server.available();
+        if (!client) return;
+        handle(client);
+        client.stop();
+    }
+
+    // One request: GET /metrics gets the registry, anything else a 404.
+    // Returns the status code sent.
+    int handle(Stream& client) {
+        client.setTimeout(METRICS_HTTP_WAIT_MS);
+        String request = client.readStringUntil('\n');
+        String header;
+        do {
+            header = client.readStringUntil('\n');
+        } while (header.length() > 1);      // Headers end at a bare "\r"
+
+        bool metricsPath = request.startsWith("GET /metrics ") || request.startsWith("GET /metrics?");
+        ChunkedPrint out(client);
+        if (!metricsPath) {
+            out.print(F("HTTP/1.1 404 Not Found\r\nContent-Type: text/plain\r\n"
+                        "Connection: close\r\n\r\nTry /metrics\n"));
+            return 404;
+        }
+        scrapes++;
+        out.print(F("HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\n"
+                    "Connection: close\r\n\r\n"));
+        metrics.writePrometheus(out);
+        return 200;
+    }
+};
+
+#endif // FEATURE_METRICS_HTTP
+
+#endif // METRICS_H
@@ -13,6 +13,7 @@
 #include <Arduino.h>
 #include "config.h"
 #include "soul.h"
+#include "log.h"
 
 // ============================================================================
 // RESPONSE POOLS BY STATE
@@ -170,9 +171,9 @@ public:
 
     void setOffline(bool offline) {
         if (offline && !isOffline) {
-            Serial.println(F("[Offline] Entering offline mode"));
+            LOG_W(CLOUD, "[Offline] Entering offline mode");
         } else if (!offline && isOffline) {
-            Serial.println(F("[Offline] Back online!"));
+            LOG_I(CLOUD, "[Offline] Back online!");
             consecutiveFailures = 0;
         }
         isOffline = offline;
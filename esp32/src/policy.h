@@ -0,0 +1,153 @@
+/*
+ * Battery-Aware Runtime Policy
+ *
+ * Picks a power tier from battery level and discharge rate, and exposes
+ * the knobs the main loop uses: frame rate, sync and WiFi retry
+ * intervals, idle animations, non-critical cloud calls, buzzer volume
+ * and the deep-sleep sync wake interval. A fast drain, once there are ten
+ * minutes of samples to fit it from, pushes the tier one step down early.
+ *
+ * At the reserve threshold the caller gets one "final save" request: the
+ * soul is saved and synced while there is still charge to do it safely.
+ */
+
+#ifndef POLICY_H
+#define POLICY_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "hardware.h"
+#include "log.h"
+
+enum PowerTier { TIER_NORMAL, TIER_SAVER, TIER_LOW, TIER_CRITICAL };
+
+struct PolicyKnobs {
+    const char* name;
+    uint8_t fps;
+    uint32_t syncIntervalMs;
+    uint32_t wifiRetryMs;
+    uint8_t wakeIntervalH;      // Deep sleep sync wakes (0 = off)
+    bool idleAnimations;        // Eye look-around
+    bool nonCriticalCloud;      // Immediate care, status check on reconnect
+    uint8_t volume;             // Buzzer, 0 = muted
+};
+
+// Interval 0 = never (no auto-sync, no WiFi retries, no timer wakes)
+static const PolicyKnobs POLICY_TIERS[] = {
+    // name       fps            sync ms                retry ms       wake h                    anim   cloud  vol
+    { "normal",   ANIMATION_FPS, AUTO_SYNC_INTERVAL_MS, WIFI_RETRY_MS, SYNC_WAKE_INTERVAL_H,     true,  true,  100 },
+    { "saver",    20,            3600000,               60000,         SYNC_WAKE_INTERVAL_H * 2, true,  true,  60 },
+    { "low",      10,            7200000,               300000,        SYNC_WAKE_INTERVAL_H * 3, false, false, 30 },
+    { "critical", 5,             0,                     0,             0,                        false, false, 0 },
+};
+
+static_assert(POLICY_DRAIN_MIN_SAMPLES >= 2 && POLICY_DRAIN_MIN_SAMPLES <= POLICY_HISTORY,
+              "drain window must fit the history");
+
+class PowerPolicy {
+private:
+    PowerTier tier;
+    uint8_t percent;            // 255 = unknown
+    float drainPctH;            // Positive while discharging
+
+    // Battery history, one sample per POLICY_SAMPLE_MS
+    uint16_t history[POLICY_HISTORY];
+    uint8_t historyCount;
+    uint8_t historyHead;
+    unsigned long lastSample;
+
+    bool reserveHandled;
+
+    // Average a few ADC reads, the raw value jitters by tens of mV
+    static uint16_t sampleMV() {
+        uint32_t sum = 0;
+        for (int i = 0; i < 4; i++) sum += readBatteryMV();
+        return sum / 4;
+    }
+
+    PowerTier tierFor(uint8_t pct, float drain) {
+        if (pct == 255) return TIER_NORMAL;
+        PowerTier t = TIER_NORMAL;
+        if (pct <= POLICY_CRITICAL_PCT) t = TIER_CRITICAL;
+        else if (pct <= POLICY_LOW_PCT) t = TIER_LOW;
+        else if (pct <= POLICY_SAVER_PCT) t = TIER_SAVER;
+
+        if (drain > POLICY_FAST_DRAIN_PCT_H && t < TIER_CRITICAL) {
+            t = (PowerTier)(t + 1);
+        }
+        return t;
+    }
+
+    // Least-squares slope of the smoothed mV over the window, in percent
+    // per hour. Endpoints would be at the mercy of the 1% steps and load
+    // sag: one step a minute apart reads as 60%/h.
+    void updateDrain() {
+        if (historyCount < POLICY_DRAIN_MIN_SAMPLES) {
+            drainPctH = 0;
+            return;
+        }
+        uint8_t oldest = (historyHead + POLICY_HISTORY - historyCount) % POLICY_HISTORY;
+        float meanX = (historyCount - 1) / 2.0f;
+        float meanY = 0;
+        for (uint8_t i = 0; i < historyCount; i++) {
+            meanY += history[(oldest + i) % POLICY_HISTORY];
+        }
+        meanY /= historyCount;
+
+        float sxy = 0, sxx = 0;
+        for (uint8_t i = 0; i < historyCount; i++) {
+            float dx = i - meanX;
+            sxy += dx * (history[(oldest + i) % POLICY_HISTORY] - meanY);
+            sxx += dx * dx;
+        }
+        float mvPerH = (sxy / sxx) * (3600000.0f / POLICY_SAMPLE_MS);
+        drainPctH = -mvPerH * 100.0f / (BATTERY_FULL_MV - BATTERY_EMPTY_MV);
+    }
+
+public:
+    PowerPolicy() : tier(TIER_NORMAL), percent(255), drainPctH(0),
+                    historyCount(0), historyHead(0), lastSample(0),
+                    reserveHandled(false) {}
+
+    // Sample the battery and re-pick the tier. Returns true on a tier change.
+    bool update(bool force = false) {
+        unsigned long now = millis();
+        if (!force && lastSample != 0 && now - lastSample < POLICY_SAMPLE_MS) return false;
+        lastSample = now;
+
+        uint16_t mv = sampleMV();
+        percent = batteryPercentOf(mv);
+        if (mv > 0) {
+            history[historyHead] = mv;
+            historyHead = (historyHead + 1) % POLICY_HISTORY;
+            if (historyCount < POLICY_HISTORY) historyCount++;
+        }
+        updateDrain();
+
+        // Charged back above the reserve: arm the final save again
+        if (percent != 255 && percent > POLICY_RESERVE_PCT + 5) reserveHandled = false;
+
+        PowerTier next = tierFor(percent, drainPctH);
+        if (next == tier) return false;
+        tier = next;
+        LOG_I(POWER, "[Policy] Battery %u%% (%.1f%%/h) -> %s",
+              percent, drainPctH, POLICY_TIERS[tier].name);
+        return true;
+    }
+
+    // True once when the battery reaches the reserve threshold
+    bool reserveReached() {
+        if (reserveHandled || percent == 255 || percent > POLICY_RESERVE_PCT) return false;
+        reserveHandled = true;
+        return true;
+    }
+
+    const PolicyKnobs& knobs() { return POLICY_TIERS[tier]; }
+    PowerTier getTier() { return tier; }
+    uint8_t getPercent() { return percent; }
+    float getDrain() { return drainPctH; }
+};
+
+extern PowerPolicy policy;
+
+#endif // POLICY_H
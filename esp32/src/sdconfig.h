@@ -4,6 +4,7 @@
  * Reads config.json from SD card for cloud credentials and WiFi networks.
  * Backs up config to LittleFS for operation without SD card.
  * Logs chat history to SD card (one file per day).
+ * Fingerprints config.json so edits can be applied without a reboot.
  *
  * config.json schema:
  * {
@@ -16,6 +17,9 @@
  *     {"ssid": "WorkWiFi", "pass": "password2"}
  *   ]
  * }
+ *
+ * Up to CONFIG_WIFI_ENTRIES wifi entries fit the parse; the first
+ * MAX_WIFI_NETWORKS with an SSID are used.
  */
 
 #ifndef SDCONFIG_H
@@ -27,6 +31,9 @@
 #include <SD.h>
 #include "config.h"
 #include "cloud.h"
+#include "trace.h"
+#include "log.h"
+#include "jsonarena.h"
 
 #if USE_LITTLEFS
 #include <LittleFS.h>
@@ -36,49 +43,97 @@
 // SD CARD INITIALIZATION
 // ============================================================================
 
-inline bool sdInit() {
+inline bool sdInit(bool verbose = true) {
     #ifdef FEATURE_SD_CARD
     SPI.begin(PIN_SD_SCK, PIN_SD_MISO, PIN_SD_MOSI, PIN_SD_CS);
     if (!SD.begin(PIN_SD_CS)) {
-        Serial.println(F("[SD] Card init failed or not present"));
+        if (verbose) LOG_W(SD, "[SD] Card init failed or not present");
         return false;
     }
     uint64_t cardSize = SD.cardSize() / (1024 * 1024);
-    Serial.printf("[SD] Card mounted, size: %llu MB\n", cardSize);
+    LOG_I(SD, "[SD] Card mounted, size: %llu MB", cardSize);
     return true;
     #else
-    Serial.println(F("[SD] SD card feature not enabled"));
+    if (verbose) LOG_I(SD, "[SD] SD card feature not enabled");
     return false;
     #endif
 }
 
+// Card still answering? A removed card fails the root directory open.
+inline bool sdCardPresent() {
+    #ifdef FEATURE_SD_CARD
+    if (SD.cardType() == CARD_NONE) return false;
+    File root = SD.open("/");
+    bool ok = root && root.isDirectory();
+    if (root) root.close();
+    return ok;
+    #else
+    return false;
+    #endif
+}
+
+inline void sdUnmount() {
+    #ifdef FEATURE_SD_CARD
+    SD.end();
+    #endif
+}
+
+// ============================================================================
+// DOCUMENT SCHEMAS
+// ============================================================================
+#define CONFIG_WIFI_ENTRIES 8
+
+static constexpr JsonField CONFIG_FILE[] = {
+    { "cloud_url", sizeof(CloudConfig::cloud_url) }, { "device_token", TOKEN_MAX_LEN },
+    { "device_id", DEVICE_ID_MAX_LEN }, { "api_version", 7 }, { "brightness", 6 },
+    { "wifi", 0 },
+};
+static constexpr JsonField CONFIG_WIFI_ENTRY[] = {
+    { "ssid", sizeof(WifiNetwork::ssid) }, { "pass", sizeof(WifiNetwork::pass) },
+};
+// LittleFS copy of the cloud part
+static constexpr JsonField CONFIG_CACHE[] = {
+    { "cloud_url", sizeof(CloudConfig::cloud_url) }, { "device_token", TOKEN_MAX_LEN },
+    { "device_id", DEVICE_ID_MAX_LEN }, { "configured", 0 },
+};
+
+static constexpr size_t CONFIG_FILE_CAP = jsonObjectSize(CONFIG_FILE, true) +
+    JSON_ARRAY_SIZE(CONFIG_WIFI_ENTRIES) +
+    CONFIG_WIFI_ENTRIES * jsonObjectSize(CONFIG_WIFI_ENTRY, true) + JSON_SLACK;
+static constexpr size_t CONFIG_CACHE_CAP = jsonObjectSize(CONFIG_CACHE, true) + JSON_SLACK;
+
+static_assert(CONFIG_FILE_CAP <= JSON_ARENA_SIZE, "config.json must fit the JSON arena");
+
 // ============================================================================
 // CONFIG.JSON READER
 // ============================================================================
 
-inline bool sdReadConfig(CloudConfig* cloudCfg, WifiNetwork* networks, int* networkCount) {
+// brightness (optional): 0 low, 1 normal, 2 high - left alone if absent
+inline bool sdReadConfig(CloudConfig* cloudCfg, WifiNetwork* networks, int* networkCount,
+                         uint8_t* brightness = nullptr) {
     #ifndef FEATURE_SD_CARD
     return false;
     #endif
+    TRACE_SCOPE(TRACE_STORAGE, "config_read");
 
     if (!SD.exists(CONFIG_FILENAME)) {
-        Serial.println(F("[SD] No config.json found"));
+        LOG_I(SD, "[SD] No config.json found");
         return false;
     }
 
     File f = SD.open(CONFIG_FILENAME, FILE_READ);
     if (!f) {
-        Serial.println(F("[SD] Failed to open config.json"));
+        LOG_E(SD, "[SD] Failed to open config.json");
         return false;
     }
 
-    StaticJsonDocument<1024> doc;
+    JsonArenaScope arena;
+    ArenaJsonDocument doc(CONFIG_FILE_CAP);
     DeserializationError err = deserializeJson(doc, f);
     f.close();
 
-    if (err) {
-        Serial.print(F("[SD] JSON parse error: "));
-        Serial.println(err.c_str());
+    if (!jsonArena.parsed(err, "config.json")) {
+        LOG_E(SD, "[SD] JSON parse error: %s", err.c_str());
         return false;
     }
 
@@ -95,9 +150,9 @@ inline bool sdReadConfig(CloudConfig* cloudCfg, WifiNetwork* networks, int* netw
     // Config is valid if we have at least a token
     cloudCfg->configured = (strlen(cloudCfg->device_token) > 0);
 
-    Serial.printf("[SD] Cloud URL: %s\n", cloudCfg->cloud_url);
-    Serial.printf("[SD] Device ID: %.8s...\n", cloudCfg->device_id);
-    Serial.printf("[SD] Token: %.12s...\n", cloudCfg->device_token);
+    LOG_I(SD, "[SD] Cloud URL: %s", cloudCfg->cloud_url);
+    LOG_D(SD, "[SD] Device ID: %.8s...", cloudCfg->device_id);
+    LOG_D(SD, "[SD] Token: %.12s...", cloudCfg->device_token);
 
     // Read WiFi networks (optional array)
     *networkCount = 0;
@@ -112,38 +167,93 @@ inline bool sdReadConfig(CloudConfig* cloudCfg, WifiNetwork* networks, int* netw
             if (strlen(ssid) > 0) {
                 strlcpy(networks[*networkCount].ssid, ssid, sizeof(networks[0].ssid));
                 strlcpy(networks[*networkCount].pass, pass, sizeof(networks[0].pass));
-                Serial.printf("[SD] WiFi %d: %s\n", *networkCount + 1, ssid);
+                LOG_I(SD, "[SD] WiFi %d: %s", *networkCount + 1, ssid);
                 (*networkCount)++;
             }
         }
     }
 
     if (*networkCount == 0) {
-        Serial.println(F("[SD] No WiFi networks in config, using defaults"));
+        LOG_W(SD, "[SD] No WiFi networks in config, using defaults");
+    }
+
+    const char* bright = doc["brightness"] | "";
+    if (brightness && strlen(bright) > 0) {
+        if (strcmp(bright, "low") == 0) *brightness = 0;
+        else if (strcmp(bright, "high") == 0) *brightness = 2;
+        else *brightness = 1;
     }
 
     return cloudCfg->configured;
 }
 
+// ============================================================================
+// CONFIG CHANGE DETECTION
+// ============================================================================
+// Cheap fingerprint of config.json so the watcher only re-parses on change.
+// Size and mtime catch most edits; the FNV-1a hash catches editors that
+// keep the size and don't touch the FAT timestamp.
+
+struct SdConfigStamp {
+    bool present;
+    size_t size;
+    time_t mtime;
+    uint32_t hash;
+};
+
+inline bool sdConfigStamp(SdConfigStamp* stamp) {
+    memset(stamp, 0, sizeof(SdConfigStamp));
+    #ifdef FEATURE_SD_CARD
+    File f = SD.open(CONFIG_FILENAME, FILE_READ);
+    if (!f) return false;
+
+    stamp->present = true;
+    stamp->size = f.size();
+    stamp->mtime = f.getLastWrite();
+
+    uint32_t hash = 2166136261UL;
+    uint8_t buf[64];
+    size_t n;
+    while ((n = f.read(buf, sizeof(buf))) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            hash = (hash ^ buf[i]) * 16777619UL;
+        }
+    }
+    f.close();
+    stamp->hash = hash;
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+inline bool sdConfigChanged(const SdConfigStamp* a, const SdConfigStamp* b) {
+    return a->present != b->present || a->size != b->size ||
+           a->mtime != b->mtime || a->hash != b->hash;
+}
+
 // ============================================================================
 // LITTLEFS CONFIG BACKUP
 // ============================================================================
 
 inline void sdSaveConfigToLittleFS(CloudConfig* cfg) {
     #if USE_LITTLEFS
-    StaticJsonDocument<256> doc;
+    TRACE_SCOPE(TRACE_STORAGE, "config_cache");
+    JsonArenaScope arena;
+    ArenaJsonDocument doc(jsonObjectSize(CONFIG_CACHE, false));
     doc["cloud_url"] = cfg->cloud_url;
     doc["device_token"] = cfg->device_token;
     doc["device_id"] = cfg->device_id;
     doc["configured"] = cfg->configured;
+    if (!jsonArena.built(doc, "config cache")) return;
 
     File f = LittleFS.open(CLOUD_CONFIG_FILE, "w");
     if (f) {
         serializeJson(doc, f);
         f.close();
-        Serial.println(F("[SD] Config backed up to LittleFS"));
+        LOG_D(SD, "[SD] Config backed up to LittleFS");
     } else {
-        Serial.println(F("[SD] Failed to backup config to LittleFS"));
+        LOG_E(SD, "[SD] Failed to backup config to LittleFS");
     }
     #endif
 }
@@ -151,18 +261,19 @@ inline void sdSaveConfigToLittleFS(CloudConfig* cfg) {
 inline bool sdLoadConfigFromLittleFS(CloudConfig* cfg) {
     #if USE_LITTLEFS
     if (!LittleFS.exists(CLOUD_CONFIG_FILE)) {
-        Serial.println(F("[SD] No cached config in LittleFS"));
+        LOG_I(SD, "[SD] No cached config in LittleFS");
         return false;
     }
 
     File f = LittleFS.open(CLOUD_CONFIG_FILE, "r");
     if (!f) return false;
 
-    StaticJsonDocument<256> doc;
+    JsonArenaScope arena;
+    ArenaJsonDocument doc(CONFIG_CACHE_CAP);
     DeserializationError err = deserializeJson(doc, f);
     f.close();
 
-    if (err) return false;
+    if (!jsonArena.parsed(err, "config cache")) return false;
 
     const char* url = doc["cloud_url"] | DEFAULT_CLOUD_URL;
     strlcpy(cfg->cloud_url, url, sizeof(cfg->cloud_url));
@@ -176,8 +287,8 @@ inline bool sdLoadConfigFromLittleFS(CloudConfig* cfg) {
     cfg->configured = doc["configured"] | false;
 
     if (cfg->configured) {
-        Serial.println(F("[SD] Loaded config from LittleFS cache"));
-        Serial.printf("[SD] Cloud URL: %s\n", cfg->cloud_url);
+        LOG_I(SD, "[SD] Loaded config from LittleFS cache");
+        LOG_I(SD, "[SD] Cloud URL: %s", cfg->cloud_url);
     }
 
     return cfg->configured;
@@ -190,23 +301,19 @@ inline bool sdLoadConfigFromLittleFS(CloudConfig* cfg) {
 // CHAT HISTORY LOGGING
 // ============================================================================
 
-inline bool sdLogChat(const char* agent, const char* message,
-                      const char* response, float E) {
-    #if !defined(FEATURE_CHAT_LOG) || !defined(FEATURE_SD_CARD)
-    return false;
-    #endif
-
-    // Ensure history directory exists
-    if (!SD.exists(HISTORY_DIR)) {
-        SD.mkdir(HISTORY_DIR);
-    }
-
-    // Build filename: /history/YYYY-MM-DD.txt
-    // Without RTC, use millis-based day counter from boot
-    // (Real timestamps would need NTP, which we add later)
+// Build filename: /history/YYYY-MM-DD.txt
+// Without RTC, use millis-based day counter from boot
+// (Real timestamps would need NTP, which we add later)
+inline void sdChatLogName(char* buf, size_t len) {
     unsigned long days = millis() / 86400000UL;
-    char filename[32];
-    snprintf(filename, sizeof(filename), "%s/day_%04lu.txt", HISTORY_DIR, days);
+    snprintf(buf, len, "%s/day_%04lu.txt", HISTORY_DIR, days);
+}
+
+// Append one exchange to a chat log, moving the file aside to
+// <name>_old.txt first once it passes MAX_HISTORY_FILE_KB
+inline bool sdAppendChat(const char* filename, const char* agent, const char* message,
+                         const char* response, float E) {
+    TRACE_SCOPE(TRACE_STORAGE, "chat_log");
 
     // Check file size - truncate if over limit
     if (SD.exists(filename)) {
@@ -217,31 +324,95 @@ inline bool sdLogChat(const char* agent, const char* message,
             if (sz > MAX_HISTORY_FILE_KB * 1024) {
                 // File too large, start a new one
                 char newName[40];
-                snprintf(newName, sizeof(newName), "%s/day_%04lu_old.txt", HISTORY_DIR, days);
+                size_t base = strlen(filename);
+                if (base > 4 && strcmp(filename + base - 4, ".txt") == 0) base -= 4;
+                snprintf(newName, sizeof(newName), "%.*s_old.txt", (int)base, filename);
                 SD.rename(filename, newName);
             }
         }
     }
 
+    // Format: [MM:SS] AGENT> User: message | Response: response | E=X.X
+    static const char* const fmt = "[%02lu:%02lu] %s> User: %s | Response: %s | E=%.1f\n";
+    unsigned long secs = (millis() / 1000) % 86400;
+    unsigned long mins = (secs / 60) % 60;
+    secs = secs % 60;
+
+    // With PSRAM the line is built in a bulk buffer there and goes to the
+    // card in one write. Without, a per-line buffer would only churn the
+    // internal heap: stream it instead.
+    MemBlock line = { nullptr, 0, MEM_INTERNAL };
+    int len = 0;
+    if (memPlace.hasPsram()) {
+        len = snprintf(nullptr, 0, fmt, mins, secs, agent, message, response, E);
+        if (len < 0) return false;
+        line = memPlace.alloc(len + 1, MEM_BULK, "chat log line");
+        if (line.ptr) snprintf((char*)line.ptr, len + 1, fmt, mins, secs, agent, message, response, E);
+    }
+
     File f = SD.open(filename, FILE_APPEND);
     if (!f) {
-        Serial.println(F("[SD] Failed to open history file"));
+        LOG_E(SD, "[SD] Failed to open history file");
+        memPlace.release(line);
         return false;
     }
+    if (line.ptr) {
+        f.write((const uint8_t*)line.ptr, len);
+        memPlace.release(line);
+    } else {
+        f.printf("[%02lu:%02lu] %s> User: ", mins, secs, agent);
+        f.print(message);
+        f.print(" | Response: ");
+        f.print(response);
+        f.printf(" | E=%.1f\n", E);
+    }
+    f.close();
 
-    // Format: [MM:SS] AGENT> User: message | Response: response | E=X.X
-    unsigned long secs = (millis() / 1000) % 86400;
-    unsigned long mins = secs / 60;
-    secs = secs % 60;
+    return true;
+}
 
-    f.printf("[%02lu:%02lu] %s> User: ", mins % 60, secs, agent);
-    f.print(message);
-    f.print(" | Response: ");
-    f.print(response);
-    f.printf(" | E=%.1f\n", E);
+inline bool sdLogChat(const char* agent, const char* message,
+                      const char* response, float E) {
+    #if !defined(FEATURE_CHAT_LOG) || !defined(FEATURE_SD_CARD)
+    return false;
+    #endif
+
+    // Ensure history directory exists
+    if (!SD.exists(HISTORY_DIR)) {
+        SD.mkdir(HISTORY_DIR);
+    }
+
+    char filename[32];
+    sdChatLogName(filename, sizeof(filename));
+    return sdAppendChat(filename, agent, message, response, E);
+}
+
+// Last few lines of today's chat log (console /log). Reads at most 1 KB
+// from the end of the file.
+inline bool sdPrintChatTail(Print& out, int lines) {
+    #ifdef FEATURE_SD_CARD
+    char filename[32];
+    sdChatLogName(filename, sizeof(filename));
+    if (!SD.exists(filename)) return false;
+    File f = SD.open(filename, FILE_READ);
+    if (!f) return false;
+
+    char buf[1024];
+    size_t size = f.size();
+    f.seek(size > sizeof(buf) - 1 ? size - (sizeof(buf) - 1) : 0);
+    size_t n = f.read((uint8_t*)buf, sizeof(buf) - 1);
     f.close();
+    buf[n] = '\0';
 
+    // Back over `lines` line ends; the last one closes the final line
+    char* p = buf + n;
+    int seen = 0;
+    while (p > buf && !(p[-1] == '\n' && ++seen > lines)) p--;
+    out.print(p);
     return true;
+    #else
+    return false;
+    #endif
 }
 
 #endif // SDCONFIG_H
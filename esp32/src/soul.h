@@ -14,6 +14,10 @@
 #include <ArduinoJson.h>
 #include "config.h"
 #include "hardware.h"
+#include "cpufreq.h"
+#include "trace.h"
+#include "log.h"
+#include "jsonarena.h"
 
 #ifdef USE_LITTLEFS
 #include <LittleFS.h>
@@ -29,7 +33,8 @@ enum AffectiveState {
     STATE_WARM,
     STATE_FLOURISHING,
     STATE_RADIANT,
-    STATE_TRANSCENDENT
+    STATE_TRANSCENDENT,
+    STATE_COUNT
 };
 
 // ============================================================================
@@ -66,6 +71,13 @@ struct SoulData {
     uint32_t checksum;
 };
 
+// LittleFS /soul.json
+static constexpr JsonField SOUL_FILE[] = {
+    { "E", 0 }, { "E_floor", 0 }, { "E_peak", 0 }, { "interactions", 0 }, { "total_care", 0 },
+    { "birth_time", 0 }, { "agent", 0 }, { "curiosity", 0 }, { "playfulness", 0 }, { "wisdom", 0 },
+};
+static constexpr size_t SOUL_FILE_CAP = jsonObjectSize(SOUL_FILE, true) + JSON_SLACK;
+
 // ============================================================================
 // SOUL CLASS
 // ============================================================================
@@ -76,9 +88,9 @@ private:
     unsigned long lastSave;
     bool dirty;  // Needs saving
 
-    uint32_t calculateChecksum() {
+    static uint32_t checksumOf(const SoulData& d) {
         // Simple checksum of soul data
-        uint8_t* ptr = (uint8_t*)&data;
+        const uint8_t* ptr = (const uint8_t*)&d;
         uint32_t sum = 0;
         for (size_t i = 0; i < sizeof(SoulData) - sizeof(uint32_t); i++) {
             sum += ptr[i] * (i + 1);
@@ -86,6 +98,26 @@ private:
         return sum ^ 0xA9EF;  // APEX in valid hex
     }
 
+    uint32_t calculateChecksum() {
+        return checksumOf(data);
+    }
+
+    // v in [lo, hi]; NaN becomes lo
+    static float bounded(float v, float lo, float hi) {
+        return v >= lo ? min(v, hi) : lo;
+    }
+
+    // Pull stored values into the ranges the equation keeps them in
+    void clampValues() {
+        data.E_floor = bounded(data.E_floor, INITIAL_FLOOR, MAX_E);
+        data.E = bounded(data.E, data.E_floor, MAX_E);
+        data.E_peak = bounded(data.E_peak, data.E, MAX_E);
+        data.curiosity = bounded(data.curiosity, 0.0f, 1.0f);
+        data.playfulness = bounded(data.playfulness, 0.0f, 1.0f);
+        data.wisdom = bounded(data.wisdom, 0.0f, 1.0f);
+        data.firmwareVersion[sizeof(data.firmwareVersion) - 1] = '\0';
+    }
+
 public:
     // Agents
     static const char* AGENTS[];
@@ -131,6 +163,36 @@ public:
 
         if (dt <= 0 || dt > 60) return;  // Sanity check
 
+        integrate(care, damage, dt);
+
+        // Update care tracking
+        if (care > 0) {
+            data.totalCare += care;
+            data.lastCareTime = now;
+            dirty = true;
+        }
+
+        // Evolve personality
+        evolvePersonality(care, dt);
+
+        // Auto-save periodically
+        if (now - lastSave > SAVE_INTERVAL_MS) {
+            save();
+        }
+    }
+
+    // Carry the equation across time spent in deep sleep, where millis()
+    // doesn't advance. No care, no damage: the floor keeps rising toward E.
+    void advance(float minutes) {
+        while (minutes > 0) {
+            float step = min(minutes, 60.0f);
+            integrate(0.0f, 0.0f, step);
+            minutes -= step;
+        }
+        dirty = true;
+    }
+
+    void integrate(float care, float damage, float dt) {
         // The Love-Equation
         float dE = beta() * (care - damage) * data.E * dt;
         data.E += dE;
@@ -149,21 +211,6 @@ public:
         if (data.E > data.E_peak) {
             data.E_peak = data.E;
         }
-
-        // Update care tracking
-        if (care > 0) {
-            data.totalCare += care;
-            data.lastCareTime = now;
-            dirty = true;
-        }
-
-        // Evolve personality
-        evolvePersonality(care, dt);
-
-        // Auto-save periodically
-        if (now - lastSave > SAVE_INTERVAL_MS) {
-            save();
-        }
     }
 
     void evolvePersonality(float care, float dt) {
@@ -278,10 +325,34 @@ public:
         strlcpy(data.firmwareVersion, FW_VERSION, sizeof(data.firmwareVersion));
     }
 
+    // ========================================================================
+    // RTC SNAPSHOT (fast wake from deep sleep)
+    // ========================================================================
+    void exportData(SoulData* out) {
+        data.checksum = calculateChecksum();
+        memcpy(out, &data, sizeof(SoulData));
+    }
+
+    // A link upload only has to carry a self-consistent checksum, so the
+    // contents are checked as well: an agent past AGENTS[] is refused and
+    // the values are clamped.
+    bool importData(const SoulData* in) {
+        if (checksumOf(*in) != in->checksum) return false;
+        if (in->agentIndex >= NUM_AGENTS) return false;
+        memcpy(&data, in, sizeof(SoulData));
+        clampValues();
+        data.lastCareTime = millis();
+        lastUpdate = millis();
+        lastSave = millis();
+        dirty = false;
+        return true;
+    }
+
     // ========================================================================
     // PERSISTENCE - LittleFS
     // ========================================================================
     bool save() {
+        TRACE_SCOPE(TRACE_STORAGE, "soul_save");
         lastSave = millis();
         dirty = false;
 
@@ -292,7 +363,7 @@ public:
         #ifdef FEATURE_EEPROM
         if (hw.eeprom_found) {
             if (saveToEEPROM()) {
-                Serial.println(F("[Soul] Saved to EEPROM"));
+                LOG_D(SOUL, "[Soul] Saved to EEPROM");
                 return true;
             }
         }
@@ -305,7 +376,7 @@ public:
         }
         #endif
 
-        Serial.println(F("[Soul] No storage available!"));
+        LOG_E(SOUL, "[Soul] No storage available!");
         return false;
     }
 
@@ -314,7 +385,7 @@ public:
         #ifdef FEATURE_EEPROM
         if (hw.eeprom_found) {
             if (loadFromEEPROM()) {
-                Serial.println(F("[Soul] Loaded from EEPROM"));
+                LOG_I(SOUL, "[Soul] Loaded from EEPROM");
                 return true;
             }
         }
@@ -329,7 +400,7 @@ public:
         }
         #endif
 
-        Serial.println(F("[Soul] No saved state, starting fresh"));
+        LOG_I(SOUL, "[Soul] No saved state, starting fresh");
         reset();
         return false;
     }
@@ -339,7 +410,8 @@ public:
     // ========================================================================
     #if USE_LITTLEFS
     bool saveToLittleFS() {
-        StaticJsonDocument<512> doc;
+        JsonArenaScope arena;
+        ArenaJsonDocument doc(jsonObjectSize(SOUL_FILE, false));
         doc["E"] = data.E;
         doc["E_floor"] = data.E_floor;
         doc["E_peak"] = data.E_peak;
@@ -350,12 +422,13 @@ public:
         doc["curiosity"] = data.curiosity;
         doc["playfulness"] = data.playfulness;
         doc["wisdom"] = data.wisdom;
+        if (!jsonArena.built(doc, "soul.json")) return false;
 
         File f = LittleFS.open("/soul.json", "w");
         if (f) {
             serializeJson(doc, f);
             f.close();
-            Serial.println(F("[Soul] Saved to LittleFS"));
+            LOG_D(SOUL, "[Soul] Saved to LittleFS");
             return true;
         }
         return false;
@@ -366,8 +439,9 @@ public:
 
         File f = LittleFS.open("/soul.json", "r");
         if (f) {
-            StaticJsonDocument<512> doc;
-            if (!deserializeJson(doc, f)) {
+            JsonArenaScope arena;
+            ArenaJsonDocument doc(SOUL_FILE_CAP);
+            if (jsonArena.parsed(deserializeJson(doc, f), "soul.json")) {
                 data.E = doc["E"] | INITIAL_E;
                 data.E_floor = doc["E_floor"] | INITIAL_FLOOR;
                 data.E_peak = doc["E_peak"] | data.E;
@@ -378,11 +452,12 @@ public:
                 data.curiosity = doc["curiosity"] | 0.1f;
                 data.playfulness = doc["playfulness"] | 0.1f;
                 data.wisdom = doc["wisdom"] | 0.0f;
+                if (data.agentIndex >= NUM_AGENTS) data.agentIndex = 0;
+                clampValues();
                 data.lastCareTime = millis();
                 lastUpdate = millis();
                 f.close();
-                Serial.print(F("[Soul] Loaded from LittleFS, E="));
-                Serial.println(data.E);
+                LOG_I(SOUL, "[Soul] Loaded from LittleFS, E=%.2f", data.E);
                 return true;
             }
             f.close();
@@ -419,7 +494,7 @@ public:
         uint32_t magic = 0;
         eepromRead(EEPROM_MAGIC_ADDR, (uint8_t*)&magic, 4);
         if (magic != EEPROM_MAGIC) {
-            Serial.println(F("[EEPROM] No valid data"));
+            LOG_W(SOUL, "[EEPROM] No valid data");
             return false;
         }
 
@@ -428,27 +503,19 @@ public:
         eepromRead(EEPROM_SOUL_ADDR, (uint8_t*)&loaded, sizeof(SoulData));
 
         // Verify checksum
-        uint32_t savedChecksum = loaded.checksum;
-        loaded.checksum = 0;
-        uint8_t* ptr = (uint8_t*)&loaded;
-        uint32_t sum = 0;
-        for (size_t i = 0; i < sizeof(SoulData) - sizeof(uint32_t); i++) {
-            sum += ptr[i] * (i + 1);
-        }
-        sum ^= 0xA9EF;  // APEX in valid hex
-
-        if (sum == savedChecksum) {
+        if (checksumOf(loaded) == loaded.checksum) {
             memcpy(&data, &loaded, sizeof(SoulData));
             data.lastCareTime = millis();
             lastUpdate = millis();
             return true;
         }
 
-        Serial.println(F("[EEPROM] Checksum mismatch"));
+        LOG_W(SOUL, "[EEPROM] Checksum mismatch");
         return false;
     }
 
     void eepromWrite(uint16_t addr, uint8_t* data, size_t len) {
+        ApbLock apb;
         for (size_t i = 0; i < len; i += 16) {
             size_t chunk = min((size_t)16, len - i);
             Wire.beginTransmission(hw.eeprom_addr);
@@ -463,6 +530,7 @@ public:
     }
 
     void eepromRead(uint16_t addr, uint8_t* data, size_t len) {
+        ApbLock apb;
         for (size_t i = 0; i < len; i += 16) {
             size_t chunk = min((size_t)16, len - i);
             Wire.beginTransmission(hw.eeprom_addr);
@@ -0,0 +1,191 @@
+/*
+ * Stack Watermarks
+ *
+ * Two views of stack use, both printed by /stack:
+ *
+ * Tasks: FreeRTOS fills every task stack with 0xA5 at creation and the
+ * high-water mark is how much of that fill was never overwritten. The
+ * loop task and the system tasks our callbacks run on are read by name.
+ *
+ * Paths: the loop task's mark only ever grows, so it can't say which call
+ * got it there. A StackScope re-fills the free part of the loop stack
+ * below the caller, and on close scans for the deepest byte the path
+ * touched. Chat, sync, config and status each keep their own peak. The
+ * task mark is read before the re-fill wipes it. Scopes don't nest; an
+ * inner one does nothing.
+ *
+ * The loop stack size is a build flag (ARDUINO_LOOP_STACK_SIZE). /stack
+ * suggests one from the deepest path seen plus STACK_MARGIN_PCT, so it
+ * can be set from measurements taken with the heaviest paths exercised.
+ */
+
+#ifndef STACKMON_H
+#define STACKMON_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#ifndef ARDUINO_LOOP_STACK_SIZE
+#define ARDUINO_LOOP_STACK_SIZE 8192
+#endif
+
+#define STACK_FILL          0xA5        // FreeRTOS tskSTACK_FILL_BYTE
+#define STACK_PAINT_GUARD   256         // Left alone below the caller (memset's own frame)
+#define STACK_MARGIN_PCT    25
+#define STACK_WARN_BYTES    1024        // Loop headroom that gets a serial warning
+#define STACK_CHECK_MS      60000
+
+enum StackPath : uint8_t {
+    STACK_PATH_CHAT,        // Chat round-trip, chat log append
+    STACK_PATH_SYNC,        // Care flush and soul sync
+    STACK_PATH_CONFIG,      // config.json hash, parse, apply
+    STACK_PATH_STATUS,      // Cloud status check
+    STACK_PATH_COUNT
+};
+
+static const char* const STACK_PATH_NAMES[STACK_PATH_COUNT] = { "chat", "sync", "config", "status" };
+
+// Tasks worth watching; sizes are what the core creates them with (0 = not known)
+struct StackTask {
+    const char* name;
+    uint32_t size;
+};
+
+static const StackTask STACK_TASKS[] = {
+    { "loopTask",       ARDUINO_LOOP_STACK_SIZE },
+#ifdef CONFIG_ESP_TIMER_TASK_STACK_SIZE
+    { "esp_timer",      CONFIG_ESP_TIMER_TASK_STACK_SIZE },     // Audio sequencer callbacks
+#else
+    { "esp_timer",      0 },
+#endif
+    { "arduino_events", 4096 },                                 // WiFi event callbacks
+#ifdef CONFIG_LWIP_TCPIP_TASK_STACK_SIZE
+    { "tiT",            CONFIG_LWIP_TCPIP_TASK_STACK_SIZE },    // lwIP
+#else
+    { "tiT",            0 },
+#endif
+};
+
+#define STACK_TASK_COUNT (sizeof(STACK_TASKS) / sizeof(STACK_TASKS[0]))
+
+struct StackPathStats {
+    uint32_t runs;
+    uint32_t depth;         // Deepest below the scope's caller
+    uint32_t peak;          // Loop stack in use at that point
+};
+
+// Current frame, near enough for painting
+static inline uint8_t* stackPointer() {
+    #ifdef NATIVE_TEST
+    return mockStackPointer();
+    #else
+    return (uint8_t*)__builtin_frame_address(0);
+    #endif
+}
+
+class StackMonitor {
+private:
+    StackPathStats paths[STACK_PATH_COUNT];
+    uint8_t* active;        // Caller's frame of the open scope, if any
+    uint32_t loopMark;      // Task mark as of the last re-fill
+    uint32_t lastCheck;
+    bool warned;
+
+    static uint8_t* loopBase() { return pxTaskGetStackStart(nullptr); }
+    static uint8_t* loopTop() { return loopBase() + ARDUINO_LOOP_STACK_SIZE; }
+
+public:
+    StackMonitor() : active(nullptr), loopMark(0), lastCheck(0), warned(false) {
+        memset(paths, 0, sizeof(paths));
+    }
+
+    const StackPathStats& pathStats(StackPath p) { return paths[p]; }
+
+    // Deepest the loop stack has been since boot: task mark, older marks
+    // wiped by a re-fill, path peaks
+    uint32_t loopPeak() {
+        uint32_t mark = ARDUINO_LOOP_STACK_SIZE - uxTaskGetStackHighWaterMark(nullptr);
+        uint32_t peak = max(loopMark, mark);
+        for (int i = 0; i < STACK_PATH_COUNT; i++) peak = max(peak, paths[i].peak);
+        return peak;
+    }
+
+    // Peak plus margin, rounded up to 1 KB
+    uint32_t suggestedLoopSize() {
+        uint32_t want = loopPeak() + loopPeak() * STACK_MARGIN_PCT / 100;
+        return (want + 1023) & ~1023UL;
+    }
+
+    // Scope open: fill the free stack below the caller. False when nested.
+    bool enter() {
+        if (active) return false;
+        uint8_t* sp = stackPointer();
+        uint8_t* base = loopBase();
+        if (sp - STACK_PAINT_GUARD <= base) return false;
+        active = sp;
+        loopMark = loopPeak();
+        memset(base, STACK_FILL, sp - STACK_PAINT_GUARD - base);
+        return true;
+    }
+
+    // Scope close: the first overwritten byte from the bottom is the deepest
+    void leave(StackPath path) {
+        uint8_t* base = loopBase();
+        uint8_t* p = base;
+        while (p < active && *p == STACK_FILL) p++;
+
+        StackPathStats& s = paths[path];
+        s.runs++;
+        s.depth = max(s.depth, (uint32_t)(active - p));
+        s.peak = max(s.peak, (uint32_t)(loopTop() - p));
+        active = nullptr;
+    }
+
+    // Call every loop pass; warns once when the loop stack runs short
+    void update() {
+        if (millis() - lastCheck < STACK_CHECK_MS) return;
+        lastCheck = millis();
+        uint32_t free = ARDUINO_LOOP_STACK_SIZE - loopPeak();
+        if (free < STACK_WARN_BYTES && !warned) {
+            warned = true;
+            Serial.printf("[Stack] Loop task down to %lu bytes free of %u\n",
+                          (unsigned long)free, ARDUINO_LOOP_STACK_SIZE);
+        }
+    }
+
+    void print() {
+        Serial.println(F("\n[Stack] Task              size  min free"));
+        for (size_t i = 0; i < STACK_TASK_COUNT; i++) {
+            TaskHandle_t t = xTaskGetHandle(STACK_TASKS[i].name);
+            if (!t) continue;
+            Serial.printf("  %-16s %6lu  %8lu\n", STACK_TASKS[i].name,
+                          (unsigned long)STACK_TASKS[i].size,
+                          (unsigned long)uxTaskGetStackHighWaterMark(t));
+        }
+
+        Serial.println(F("  Path        runs   depth    peak"));
+        for (int i = 0; i < STACK_PATH_COUNT; i++) {
+            const StackPathStats& s = paths[i];
+            if (s.runs == 0) continue;
+            Serial.printf("  %-9s %6lu %7lu %7lu\n", STACK_PATH_NAMES[i], (unsigned long)s.runs,
+                          (unsigned long)s.depth, (unsigned long)s.peak);
+        }
+        Serial.printf("  Loop peak %lu of %u, suggest -DARDUINO_LOOP_STACK_SIZE=%lu\n",
+                      (unsigned long)loopPeak(), ARDUINO_LOOP_STACK_SIZE,
+                      (unsigned long)suggestedLoopSize());
+    }
+};
+
+extern StackMonitor stackMon;
+
+// StackScope scope(STACK_PATH_SYNC); ... work ...
+struct StackScope {
+    StackPath path;
+    bool open;
+
+    explicit StackScope(StackPath p) : path(p), open(stackMon.enter()) {}
+    ~StackScope() { if (open) stackMon.leave(path); }
+};
+
+#endif // STACKMON_H
@@ -0,0 +1,178 @@
+/*
+ * Event Tracing
+ *
+ * Begin/end/instant events with microsecond timestamps, kept in a fixed
+ * ring (the oldest are overwritten). Names are string literals stored by
+ * pointer, so recording never allocates and costs a timer read and a few
+ * stores. The ring is a bulk buffer (memplace.h) allocated by begin():
+ * TRACE_EVENTS_PSRAM entries in PSRAM on the Sense, TRACE_EVENTS internal
+ * otherwise. Nothing is recorded before begin().
+ *
+ * /trace prints the ring as Chrome trace JSON; paste it into
+ * ui.perfetto.dev or chrome://tracing. Each category gets its own row,
+ * so a render that overlapped a TLS handshake or an SD write shows up
+ * as exactly that.
+ *
+ * Built only with FEATURE_TRACE (env:esp32s3_trace). Without it the
+ * TRACE_* macros are empty and nothing is linked in.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "config.h"
+#include "memplace.h"
+
+enum TraceCat : uint8_t {
+    TRACE_FRAME,            // Screen renders
+    TRACE_INPUT,            // Button gestures
+    TRACE_CLOUD,            // API calls, HTTP exchanges, response parsing
+    TRACE_STORAGE,          // Soul saves, chat log, config
+    TRACE_WIFI,             // Association attempts, drops, park/resume
+    TRACE_POWER,            // Light-sleep naps
+    TRACE_CAT_COUNT
+};
+
+#ifdef FEATURE_TRACE
+
+#ifndef TRACE_EVENTS
+#define TRACE_EVENTS        512     // 12 bytes each
+#endif
+#ifndef TRACE_EVENTS_PSRAM
+#define TRACE_EVENTS_PSRAM  8192    // 96 KB, minutes of a busy session
+#endif
+
+static const char* const TRACE_CAT_NAMES[TRACE_CAT_COUNT] = {
+    "frame", "input", "cloud", "storage", "wifi", "power"
+};
+
+struct TraceEvent {
+    uint32_t ts;            // esp_timer µs, wraps after 71 minutes
+    const char* name;
+    char phase;             // 'B', 'E' or 'i' (Chrome trace phases)
+    uint8_t cat;
+    uint16_t arg;
+};
+
+class Tracer {
+private:
+    MemBlock block;
+    TraceEvent* ring;
+    uint16_t capacity;      // 0 until begin()
+    uint16_t head;          // Next slot to write
+    uint16_t count;
+    uint32_t overwritten;
+    volatile bool paused;   // Set while exporting
+    bool held;              // Paused across exports (USB link stream)
+    portMUX_TYPE lock;
+
+public:
+    Tracer() : block{ nullptr, 0, MEM_INTERNAL }, ring(nullptr), capacity(0), head(0), count(0),
+               overwritten(0), paused(false), held(false), lock(portMUX_INITIALIZER_UNLOCKED) {}
+    ~Tracer() { memPlace.release(block); }
+
+    // After memPlace.begin(); again does nothing
+    void begin() {
+        if (ring) return;
+        uint16_t n = memPlace.hasPsram() ? TRACE_EVENTS_PSRAM : TRACE_EVENTS;
+        block = memPlace.alloc(n * sizeof(TraceEvent), MEM_BULK, "trace ring");
+        if (!block.ptr) return;
+        ring = (TraceEvent*)block.ptr;
+        portENTER_CRITICAL(&lock);
+        capacity = n;
+        portEXIT_CRITICAL(&lock);
+    }
+
+    void record(TraceCat cat, char phase, const char* name, uint16_t arg = 0) {
+        if (paused || !capacity) return;
+        uint32_t ts = (uint32_t)esp_timer_get_time();
+        portENTER_CRITICAL(&lock);
+        ring[head] = { ts, name, phase, (uint8_t)cat, arg };
+        head = (head + 1) % capacity;
+        if (count < capacity) count++;
+        else overwritten++;
+        portEXIT_CRITICAL(&lock);
+    }
+
+    void clear() {
+        portENTER_CRITICAL(&lock);
+        head = 0;
+        count = 0;
+        overwritten = 0;
+        portEXIT_CRITICAL(&lock);
+    }
+
+    // Keep the ring frozen between exports, so a stream rendered more
+    // than once reads the same events every time
+    void hold(bool on) {
+        held = on;
+        paused = on;
+    }
+
+    uint16_t size() { return count; }
+    uint16_t getCapacity() { return capacity; }
+    uint32_t getOverwritten() { return overwritten; }
+
+    // Oldest first
+    const TraceEvent& at(uint16_t i) {
+        return ring[(head + capacity - count + i) % capacity];
+    }
+
+    // Chrome trace JSON, one event per line. Timestamps start at the oldest
+    // event; ends whose begin was overwritten are left out.
+    void exportJson(Print& out) {
+        paused = true;
+        out.print(F("{\"traceEvents\":[\n"));
+        for (int c = 0; c < TRACE_CAT_COUNT; c++) {
+            out.printf("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                       "\"args\":{\"name\":\"%s\"}}\n", c ? "," : "", c, TRACE_CAT_NAMES[c]);
+        }
+
+        uint16_t open[TRACE_CAT_COUNT] = {};
+        uint32_t t0 = count ? at(0).ts : 0;
+        for (uint16_t i = 0; i < count; i++) {
+            const TraceEvent& e = at(i);
+            if (e.phase == 'B') open[e.cat]++;
+            if (e.phase == 'E') {
+                if (open[e.cat] == 0) continue;
+                open[e.cat]--;
+            }
+            out.printf(",{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%lu,\"pid\":1,\"tid\":%u",
+                       e.name, TRACE_CAT_NAMES[e.cat], e.phase, (unsigned long)(e.ts - t0), e.cat);
+            if (e.phase == 'i') out.printf(",\"s\":\"t\",\"args\":{\"v\":%u}", e.arg);
+            out.print(F("}\n"));
+        }
+        out.print(F("],\"displayTimeUnit\":\"ms\"}\n"));
+        paused = held;
+    }
+};
+
+extern Tracer tracer;
+
+struct TraceScope {
+    TraceCat cat;
+    const char* name;
+
+    TraceScope(TraceCat c, const char* n) : cat(c), name(n) { tracer.record(cat, 'B', name); }
+    ~TraceScope() { tracer.record(cat, 'E', name); }
+};
+
+#define TRACE_CONCAT_(a, b)             a##b
+#define TRACE_CONCAT(a, b)              TRACE_CONCAT_(a, b)
+#define TRACE_BEGIN(cat, name)          tracer.record(cat, 'B', name)
+#define TRACE_END(cat, name)            tracer.record(cat, 'E', name)
+#define TRACE_INSTANT(cat, name, arg)   tracer.record(cat, 'i', name, arg)
+#define TRACE_SCOPE(cat, name)          TraceScope TRACE_CONCAT(traceScope, __LINE__)(cat, name)
+
+#else
+
+#define TRACE_BEGIN(cat, name)          ((void)0)
+#define TRACE_END(cat, name)            ((void)0)
+#define TRACE_INSTANT(cat, name, arg)   ((void)0)
+#define TRACE_SCOPE(cat, name)          ((void)0)
+
+#endif // FEATURE_TRACE
+
+#endif // TRACE_H
@@ -0,0 +1,117 @@
+/*
+ * Wake-Reason-Aware Boot
+ *
+ * Soul, cloud config/status and the last WiFi association are kept in RTC
+ * slow memory across deep sleep. A button wake restores them and puts the
+ * face up straight away; storage mounts and network work follow from the
+ * main loop. A timer wake runs a headless sync cycle from the same
+ * snapshot and goes back to sleep. Cold boots (power-on, reset) take the
+ * full setup() path.
+ */
+
+#ifndef WAKE_H
+#define WAKE_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "soul.h"
+#include "cloud.h"
+#include "sdconfig.h"
+#include "esp_timer.h"
+
+#ifdef FEATURE_DEEPSLEEP
+#include "esp_sleep.h"
+#endif
+
+#define RTC_SNAPSHOT_MAGIC  0x57414B45  // "WAKE"
+
+enum WakeKind { WAKE_COLD, WAKE_BUTTON, WAKE_TIMER, WAKE_OTHER };
+
+struct RtcSnapshot {
+    uint32_t magic;
+
+    SoulData soul;
+
+    // Cloud
+    CloudConfig cloudCfg;
+    bool token_valid;
+    bool billing_ok;
+    int tools_available;
+    int messages_used;
+    int messages_limit;
+    char tier_name[16];
+
+    // WiFi: config networks plus the association to retry first
+    WifiNetwork wifiNets[MAX_WIFI_NETWORKS];
+    int8_t wifiNetCount;
+    int8_t wifiIndex;           // -1 none, wifiNetCount = hardcoded fallback
+    uint8_t bssid[6];
+    int32_t channel;
+
+    // SD config fingerprint, so the deferred mount doesn't re-apply it
+    SdConfigStamp configStamp;
+
+    uint8_t brightness;
+    uint8_t wakeIntervalH;      // Timer wake period armed at sleep entry
+
+    uint32_t sleepCount;
+    uint32_t checksum;
+};
+
+extern RtcSnapshot rtcSnapshot;     // RTC_DATA_ATTR, defined in main.cpp
+
+// Headless timer-wake sync cycles, accumulated across deep sleep
+struct SyncCycleStats {
+    uint32_t cycles;
+    uint32_t synced;            // Cycles that reached the cloud
+    uint32_t lastAwakeMs;
+    uint32_t lastWifiMs;
+    float lastUAh;              // Estimated charge of the last cycle
+    float totalUAh;
+};
+
+extern SyncCycleStats cycleStats;   // RTC_DATA_ATTR, defined in main.cpp
+
+// Charge estimate for a wake cycle from time awake and time with radio on
+inline float cycleChargeUAh(uint32_t awakeMs, uint32_t wifiMs) {
+    return (awakeMs * (float)CURRENT_AWAKE_MA +
+            wifiMs * (float)(CURRENT_WIFI_MA - CURRENT_AWAKE_MA)) / 3600.0f;
+}
+
+inline WakeKind getWakeKind() {
+    #ifdef FEATURE_DEEPSLEEP
+    switch (esp_sleep_get_wakeup_cause()) {
+        case ESP_SLEEP_WAKEUP_UNDEFINED: return WAKE_COLD;
+        case ESP_SLEEP_WAKEUP_EXT0:      return WAKE_BUTTON;
+        case ESP_SLEEP_WAKEUP_TIMER:     return WAKE_TIMER;
+        default:                         return WAKE_OTHER;
+    }
+    #else
+    return WAKE_COLD;
+    #endif
+}
+
+inline uint32_t rtcSnapshotChecksum() {
+    const uint8_t* ptr = (const uint8_t*)&rtcSnapshot;
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < offsetof(RtcSnapshot, checksum); i++) {
+        hash = (hash ^ ptr[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+inline bool rtcSnapshotValid() {
+    return rtcSnapshot.magic == RTC_SNAPSHOT_MAGIC &&
+           rtcSnapshot.checksum == rtcSnapshotChecksum();
+}
+
+inline void rtcSnapshotSeal() {
+    rtcSnapshot.magic = RTC_SNAPSHOT_MAGIC;
+    rtcSnapshot.checksum = rtcSnapshotChecksum();
+}
+
+inline void rtcSnapshotInvalidate() {
+    rtcSnapshot.magic = 0;
+}
+
+#endif // WAKE_H
@@ -0,0 +1,128 @@
+/*
+ * Adafruit_GFX mock
+ *
+ * The drawing primitives the firmware uses, on top of drawPixel(). Text is
+ * drawn with a stand-in 5x7 font (a hash of the character, not real
+ * glyphs): different strings give different pixels, and the cost per
+ * character is in the same ballpark as the real font.
+ */
+
+#ifndef MOCK_ADAFRUIT_GFX_H
+#define MOCK_ADAFRUIT_GFX_H
+
+#include <Arduino.h>
+
+class Adafruit_GFX : public Print {
+protected:
+    int16_t _width, _height;
+    int16_t cursor_x = 0, cursor_y = 0;
+    uint16_t textcolor = 1, textbgcolor = 1;
+    uint8_t textsize = 1;
+    bool wrap = true;
+
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint8_t size) {
+        for (int8_t col = 0; col < 5; col++) {
+            uint8_t line = (uint8_t)((c * 37u + col * 11u) ^ (c >> 1)) & 0x7F;
+            for (int8_t row = 0; row < 7; row++, line >>= 1) {
+                if (!(line & 1)) continue;
+                if (size == 1) drawPixel(x + col, y + row, color);
+                else fillRect(x + col * size, y + row * size, size, size, color);
+            }
+        }
+    }
+
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h) {}
+    virtual ~Adafruit_GFX() {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+        for (int16_t i = 0; i < w; i++) drawPixel(x + i, y, color);
+    }
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+        for (int16_t i = 0; i < h; i++) drawPixel(x, y + i, color);
+    }
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        for (int16_t i = 0; i < h; i++) drawFastHLine(x, y + i, w, color);
+    }
+    virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        drawFastHLine(x, y, w, color);
+        drawFastHLine(x, y + h - 1, w, color);
+        drawFastVLine(x, y, h, color);
+        drawFastVLine(x + w - 1, y, h, color);
+    }
+
+    void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint16_t color) {
+        int16_t dx = abs(x1 - x0), dy = -abs(y1 - y0);
+        int16_t sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+        int16_t err = dx + dy;
+        for (;;) {
+            drawPixel(x0, y0, color);
+            if (x0 == x1 && y0 == y1) break;
+            int16_t e2 = 2 * err;
+            if (e2 >= dy) { err += dy; x0 += sx; }
+            if (e2 <= dx) { err += dx; y0 += sy; }
+        }
+    }
+
+    void drawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+        for (int16_t y = -r; y <= r; y++) {
+            for (int16_t x = -r; x <= r; x++) {
+                int16_t d = x * x + y * y;
+                if (d <= r * r && d > (r - 1) * (r - 1)) drawPixel(x0 + x, y0 + y, color);
+            }
+        }
+    }
+
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+        for (int16_t y = -r; y <= r; y++) {
+            for (int16_t x = -r; x <= r; x++) {
+                if (x * x + y * y <= r * r) drawPixel(x0 + x, y0 + y, color);
+            }
+        }
+    }
+
+    // 1-bit bitmap, rows padded to whole bytes, MSB first
+    void drawBitmap(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, uint16_t color) {
+        int16_t byteWidth = (w + 7) / 8;
+        for (int16_t j = 0; j < h; j++) {
+            for (int16_t i = 0; i < w; i++) {
+                if (pgm_read_byte(&bitmap[j * byteWidth + i / 8]) & (0x80 >> (i & 7))) {
+                    drawPixel(x + i, y + j, color);
+                }
+            }
+        }
+    }
+
+    size_t write(uint8_t c) override {
+        if (c == '\n') {
+            cursor_x = 0;
+            cursor_y += textsize * 8;
+        } else if (c != '\r') {
+            if (wrap && cursor_x + textsize * 6 > _width) {
+                cursor_x = 0;
+                cursor_y += textsize * 8;
+            }
+            drawChar(cursor_x, cursor_y, c, textcolor, textsize);
+            cursor_x += textsize * 6;
+        }
+        return 1;
+    }
+    using Print::write;
+
+    void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+    void setTextSize(uint8_t s) { textsize = s > 0 ? s : 1; }
+    void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+    void setTextWrap(bool w) { wrap = w; }
+    void cp437(bool = true) {}
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+};
+
+#endif // MOCK_ADAFRUIT_GFX_H
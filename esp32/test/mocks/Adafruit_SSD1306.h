@@ -0,0 +1,80 @@
+/*
+ * SSD1306 mock: a real 1-bit framebuffer in the controller's page layout.
+ * begin() succeeds only if a device answers at the address on the mock
+ * I2C bus. Commands and display() pushes are recorded.
+ */
+
+#ifndef MOCK_ADAFRUIT_SSD1306_H
+#define MOCK_ADAFRUIT_SSD1306_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <vector>
+#include "Adafruit_GFX.h"
+
+#define SSD1306_BLACK           0
+#define SSD1306_WHITE           1
+#define SSD1306_INVERSE         2
+#define BLACK                   SSD1306_BLACK
+#define WHITE                   SSD1306_WHITE
+#define INVERSE                 SSD1306_INVERSE
+
+#define SSD1306_SWITCHCAPVCC    0x02
+#define SSD1306_EXTERNALVCC     0x01
+#define SSD1306_SETCONTRAST     0x81
+#define SSD1306_DISPLAYALLON_RESUME 0xA4
+#define SSD1306_NORMALDISPLAY   0xA6
+#define SSD1306_INVERTDISPLAY   0xA7
+#define SSD1306_DISPLAYOFF      0xAE
+#define SSD1306_DISPLAYON       0xAF
+
+class Adafruit_SSD1306 : public Adafruit_GFX {
+private:
+    TwoWire* wire;
+    std::vector<uint8_t> buffer;
+
+public:
+    std::vector<uint8_t> mockCommands;      // ssd1306_command() bytes, in order
+    uint32_t mockFrames = 0;                // display() calls
+
+    Adafruit_SSD1306(uint8_t w, uint8_t h, TwoWire* twi = &Wire, int8_t = -1,
+                     uint32_t = 400000UL, uint32_t = 100000UL)
+        : Adafruit_GFX(w, h), wire(twi), buffer(w * ((h + 7) / 8), 0) {}
+
+    bool begin(uint8_t = SSD1306_SWITCHCAPVCC, uint8_t addr = 0, bool = true, bool = true) {
+        return wire->mockDevice(addr ? addr : 0x3C) != nullptr;
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+        uint8_t& b = buffer[x + (y / 8) * _width];
+        uint8_t mask = 1 << (y & 7);
+        if (color == SSD1306_WHITE) b |= mask;
+        else if (color == SSD1306_BLACK) b &= ~mask;
+        else b ^= mask;
+    }
+
+    bool getPixel(int16_t x, int16_t y) const {
+        if (x < 0 || y < 0 || x >= _width || y >= _height) return false;
+        return buffer[x + (y / 8) * _width] & (1 << (y & 7));
+    }
+
+    uint8_t* getBuffer() { return buffer.data(); }
+    void clearDisplay() { std::fill(buffer.begin(), buffer.end(), 0); }
+    void display() { mockFrames++; }
+    void ssd1306_command(uint8_t c) { mockCommands.push_back(c); }
+    void invertDisplay(bool i) { ssd1306_command(i ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY); }
+    void dim(bool dim) {
+        ssd1306_command(SSD1306_SETCONTRAST);
+        ssd1306_command(dim ? 0 : 0xCF);
+    }
+
+    // ---------- test hooks ----------
+    uint32_t mockLitPixels() const {
+        uint32_t n = 0;
+        for (uint8_t b : buffer) n += __builtin_popcount(b);
+        return n;
+    }
+};
+
+#endif // MOCK_ADAFRUIT_SSD1306_H
@@ -0,0 +1,603 @@
+/*
+ * Arduino Core Mock
+ *
+ * Enough of the Arduino-ESP32 core to build the firmware headers on a
+ * Linux box: String, Print/Stream, a Serial that records output and takes
+ * scripted input, pins, LEDC, CPU clock and the ESP object. Time is virtual
+ * (mock_clock.h): millis() stands still until delay() or mockAdvance().
+ *
+ * Everything is header-only so each test builds as one translation unit,
+ * the same way main.cpp pulls in the firmware headers. Test hooks are the
+ * mock* functions and members; mockReset() puts the core back to boot.
+ */
+
+#ifndef MOCK_ARDUINO_H
+#define MOCK_ARDUINO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <cctype>
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+#include <string>
+
+#include "mock_clock.h"
+#include "mock_gpio.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+using std::min;
+using std::max;
+
+// ============================================================================
+// ATTRIBUTES, CONSTANTS, MACROS
+// ============================================================================
+
+#define PROGMEM
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define PSTR(s)             (s)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+
+#define HIGH                0x1
+#define LOW                 0x0
+
+#define DEC                 10
+#define HEX                 16
+#define OCT                 8
+#define BIN                 2
+
+#define PI                  3.1415926535897932384626433832795
+#define DEG_TO_RAD          0.017453292519943295769236907684886
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define bit(b)              (1UL << (b))
+#define bitRead(value, b)   (((value) >> (b)) & 0x01)
+#define lowByte(w)          ((uint8_t)((w) & 0xff))
+#define highByte(w)         ((uint8_t)((w) >> 8))
+
+typedef bool boolean;
+typedef uint8_t byte;
+typedef unsigned int word;
+
+class __FlashStringHelper;
+#define F(s)                (reinterpret_cast<const __FlashStringHelper*>(s))
+#define FPSTR(s)            (reinterpret_cast<const __FlashStringHelper*>(s))
+
+// glibc only has these from 2.38
+#if !defined(__APPLE__) && !(defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 38))
+inline size_t strlcpy(char* dst, const char* src, size_t size) {
+    size_t len = strlen(src);
+    if (size > 0) {
+        size_t n = len < size - 1 ? len : size - 1;
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return len;
+}
+
+inline size_t strlcat(char* dst, const char* src, size_t size) {
+    size_t used = strnlen(dst, size);
+    if (used == size) return size + strlen(src);
+    return used + strlcpy(dst + used, src, size - used);
+}
+#endif
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    if (inMax == inMin) return outMin;
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+// ============================================================================
+// STRING
+// ============================================================================
+
+class String {
+private:
+    std::string s;
+
+    static std::string number(unsigned long long v, int base) {
+        if (base < 2 || base > 36) base = 10;
+        char buf[72];
+        char* p = buf + sizeof(buf) - 1;
+        *p = '\0';
+        do {
+            int d = v % base;
+            *--p = d < 10 ? '0' + d : 'A' + d - 10;
+            v /= base;
+        } while (v);
+        return p;
+    }
+
+    static std::string signedNumber(long long v, int base) {
+        if (v < 0 && base == 10) return "-" + number(-(unsigned long long)v, base);
+        return number((unsigned long long)v, base);
+    }
+
+    static std::string fixed(double v, unsigned places) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", places, v);
+        return buf;
+    }
+
+public:
+    String() {}
+    String(const char* c) : s(c ? c : "") {}
+    String(const __FlashStringHelper* f) : s(f ? (const char*)f : "") {}
+    String(const String&) = default;
+    String(String&&) = default;
+    explicit String(char c) : s(1, c) {}
+    explicit String(unsigned char v, unsigned char base = 10) : s(number(v, base)) {}
+    explicit String(int v, unsigned char base = 10) : s(signedNumber(v, base)) {}
+    explicit String(unsigned int v, unsigned char base = 10) : s(number(v, base)) {}
+    explicit String(long v, unsigned char base = 10) : s(signedNumber(v, base)) {}
+    explicit String(unsigned long v, unsigned char base = 10) : s(number(v, base)) {}
+    explicit String(long long v, unsigned char base = 10) : s(signedNumber(v, base)) {}
+    explicit String(unsigned long long v, unsigned char base = 10) : s(number(v, base)) {}
+    explicit String(float v, unsigned int places = 2) : s(fixed(v, places)) {}
+    explicit String(double v, unsigned int places = 2) : s(fixed(v, places)) {}
+
+    String& operator=(const String&) = default;
+    String& operator=(String&&) = default;
+    String& operator=(const char* c) { s = c ? c : ""; return *this; }
+
+    unsigned int length() const { return s.size(); }
+    const char* c_str() const { return s.c_str(); }
+    bool isEmpty() const { return s.empty(); }
+    bool reserve(unsigned int size) { s.reserve(size); return true; }
+
+    bool concat(const String& o) { s += o.s; return true; }
+    bool concat(const char* c) { if (!c) return false; s += c; return true; }
+    bool concat(const char* c, unsigned int n) { if (!c) return false; s.append(c, n); return true; }
+    bool concat(char c) { s += c; return true; }
+    bool concat(int v) { s += signedNumber(v, 10); return true; }
+    bool concat(unsigned int v) { s += number(v, 10); return true; }
+    bool concat(long v) { s += signedNumber(v, 10); return true; }
+    bool concat(unsigned long v) { s += number(v, 10); return true; }
+    bool concat(float v) { s += fixed(v, 2); return true; }
+    bool concat(double v) { s += fixed(v, 2); return true; }
+
+    template <typename T> String& operator+=(const T& v) { concat(v); return *this; }
+
+    char charAt(unsigned int i) const { return i < s.size() ? s[i] : 0; }
+    char operator[](unsigned int i) const { return charAt(i); }
+    char& operator[](unsigned int i) { return s[i]; }
+    void setCharAt(unsigned int i, char c) { if (i < s.size()) s[i] = c; }
+
+    bool equals(const String& o) const { return s == o.s; }
+    bool equals(const char* c) const { return s == (c ? c : ""); }
+    bool equalsIgnoreCase(const String& o) const {
+        return s.size() == o.s.size() &&
+               std::equal(s.begin(), s.end(), o.s.begin(),
+                          [](char a, char b) { return tolower((unsigned char)a) == tolower((unsigned char)b); });
+    }
+    bool operator==(const String& o) const { return equals(o); }
+    bool operator==(const char* c) const { return equals(c); }
+    bool operator!=(const String& o) const { return !equals(o); }
+    bool operator!=(const char* c) const { return !equals(c); }
+    bool operator<(const String& o) const { return s < o.s; }
+
+    bool startsWith(const String& p) const { return s.compare(0, p.s.size(), p.s) == 0; }
+    bool endsWith(const String& p) const {
+        return s.size() >= p.s.size() && s.compare(s.size() - p.s.size(), p.s.size(), p.s) == 0;
+    }
+
+    int indexOf(char c, unsigned int from = 0) const {
+        size_t p = s.find(c, from);
+        return p == std::string::npos ? -1 : (int)p;
+    }
+    int indexOf(const String& str, unsigned int from = 0) const {
+        size_t p = s.find(str.s, from);
+        return p == std::string::npos ? -1 : (int)p;
+    }
+    int lastIndexOf(char c) const {
+        size_t p = s.rfind(c);
+        return p == std::string::npos ? -1 : (int)p;
+    }
+
+    String substring(unsigned int from) const { return substring(from, s.size()); }
+    String substring(unsigned int from, unsigned int to) const {
+        if (from > to) std::swap(from, to);
+        if (from >= s.size()) return String();
+        return String(s.substr(from, to - from).c_str());
+    }
+
+    void replace(const String& from, const String& to) {
+        if (from.s.empty()) return;
+        for (size_t p = 0; (p = s.find(from.s, p)) != std::string::npos; p += to.s.size()) {
+            s.replace(p, from.s.size(), to.s);
+        }
+    }
+    void remove(unsigned int index) { if (index < s.size()) s.erase(index); }
+    void remove(unsigned int index, unsigned int count) { if (index < s.size()) s.erase(index, count); }
+    void toLowerCase() { for (char& c : s) c = tolower((unsigned char)c); }
+    void toUpperCase() { for (char& c : s) c = toupper((unsigned char)c); }
+    void trim() {
+        size_t a = s.find_first_not_of(" \t\r\n");
+        if (a == std::string::npos) { s.clear(); return; }
+        s = s.substr(a, s.find_last_not_of(" \t\r\n") - a + 1);
+    }
+
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return (float)atof(s.c_str()); }
+    double toDouble() const { return atof(s.c_str()); }
+
+    void toCharArray(char* buf, unsigned int size, unsigned int index = 0) const {
+        if (!size || !buf) return;
+        strlcpy(buf, index < s.size() ? s.c_str() + index : "", size);
+    }
+    void getBytes(unsigned char* buf, unsigned int size, unsigned int index = 0) const {
+        toCharArray((char*)buf, size, index);
+    }
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r.concat(b); return r; }
+inline String operator+(const String& a, const char* b) { String r(a); r.concat(b); return r; }
+inline String operator+(const char* a, const String& b) { String r(a); r.concat(b); return r; }
+inline String operator+(const String& a, char b) { String r(a); r.concat(b); return r; }
+
+// ============================================================================
+// PRINT / STREAM
+// ============================================================================
+
+class Print {
+private:
+    size_t printNumber(unsigned long long n, int base) {
+        char buf[72];
+        char* p = buf + sizeof(buf) - 1;
+        *p = '\0';
+        if (base < 2) base = 10;
+        do {
+            int d = n % base;
+            *--p = d < 10 ? '0' + d : 'A' + d - 10;
+            n /= base;
+        } while (n);
+        return write(p);
+    }
+
+    size_t printSigned(long long n, int base) {
+        if (base == 0) return write((uint8_t)n);
+        if (base == 10 && n < 0) return write((uint8_t)'-') + printNumber(-(unsigned long long)n, 10);
+        return printNumber((unsigned long long)n, base);
+    }
+
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t size) {
+        size_t n = 0;
+        while (n < size && write(buf[n])) n++;
+        return n;
+    }
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    size_t write(const char* buf, size_t size) { return write((const uint8_t*)buf, size); }
+
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t print(const __FlashStringHelper* s) { return write((const char*)s); }
+    size_t print(const String& s) { return write(s.c_str(), s.length()); }
+    size_t print(const char* s) { return write(s); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char n, int base = DEC) { return printSigned(n, base); }
+    size_t print(int n, int base = DEC) { return printSigned(n, base); }
+    size_t print(unsigned int n, int base = DEC) { return base ? printNumber(n, base) : write((uint8_t)n); }
+    size_t print(long n, int base = DEC) { return printSigned(n, base); }
+    size_t print(unsigned long n, int base = DEC) { return base ? printNumber(n, base) : write((uint8_t)n); }
+    size_t print(long long n, int base = DEC) { return printSigned(n, base); }
+    size_t print(unsigned long long n, int base = DEC) { return base ? printNumber(n, base) : write((uint8_t)n); }
+    size_t print(double n, int digits = 2) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "%.*f", digits, n);
+        return write(buf);
+    }
+
+    size_t println() { return write("\r\n"); }
+    template <typename T> size_t println(const T& v) { size_t n = print(v); return n + println(); }
+    template <typename T> size_t println(const T& v, int format) { size_t n = print(v, format); return n + println(); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        char small[128];
+        va_list args;
+        va_start(args, format);
+        int len = vsnprintf(small, sizeof(small), format, args);
+        va_end(args);
+        if (len < 0) return 0;
+        if ((size_t)len < sizeof(small)) return write((const uint8_t*)small, len);
+
+        std::string big(len + 1, '\0');
+        va_start(args, format);
+        vsnprintf(&big[0], big.size(), format, args);
+        va_end(args);
+        return write((const uint8_t*)big.data(), len);
+    }
+};
+
+// Reads never wait: a mock stream has everything it will ever have
+class Stream : public Print {
+protected:
+    unsigned long timeout = 1000;
+
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long ms) { timeout = ms; }
+    unsigned long getTimeout() const { return timeout; }
+
+    virtual size_t readBytes(char* buffer, size_t length) {
+        size_t n = 0;
+        int c;
+        while (n < length && (c = read()) >= 0) buffer[n++] = (char)c;
+        return n;
+    }
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+
+    String readStringUntil(char terminator) {
+        String out;
+        int c;
+        while ((c = read()) >= 0 && c != terminator) out += (char)c;
+        return out;
+    }
+
+    String readString() {
+        String out;
+        int c;
+        while ((c = read()) >= 0) out += (char)c;
+        return out;
+    }
+};
+
+// ============================================================================
+// SERIAL
+// ============================================================================
+
+class HardwareSerial : public Stream {
+private:
+    std::string rx;
+    size_t rxPos = 0;
+    bool echo = false;
+
+public:
+    std::string output;         // Everything written since the last take/reset
+    uint32_t mockPollUs = 0;    // Clock cost of available(), so busy loops on the port progress
+
+    void begin(unsigned long, uint32_t = 0, int8_t = -1, int8_t = -1) {}
+    void end() {}
+    operator bool() const { return true; }
+    void setTxTimeoutMs(uint32_t) {}
+    void setRxBufferSize(size_t) {}
+    void setTxBufferSize(size_t) {}
+
+    int available() override {
+        if (mockPollUs) mockAdvanceUs(mockPollUs);
+        return (int)(rx.size() - rxPos);
+    }
+    int read() override { return rxPos < rx.size() ? (uint8_t)rx[rxPos++] : -1; }
+    int peek() override { return rxPos < rx.size() ? (uint8_t)rx[rxPos] : -1; }
+    int availableForWrite() override { return 256; }
+
+    size_t write(uint8_t c) override {
+        output += (char)c;
+        if (echo) fputc(c, stdout);
+        return 1;
+    }
+    size_t write(const uint8_t* buf, size_t size) override {
+        output.append((const char*)buf, size);
+        if (echo) fwrite(buf, 1, size, stdout);
+        return size;
+    }
+    using Print::write;
+
+    // ---------- test hooks ----------
+    void mockInput(const char* text) { rx.append(text); }
+    void mockInput(const uint8_t* data, size_t len) { rx.append((const char*)data, len); }
+    void mockEcho(bool on) { echo = on; }
+
+    std::string mockTake() {
+        std::string out;
+        out.swap(output);
+        return out;
+    }
+
+    void mockReset() {
+        rx.clear();
+        rxPos = 0;
+        output.clear();
+        mockPollUs = 0;
+    }
+};
+
+inline HardwareSerial Serial;
+
+// ============================================================================
+// TIME
+// ============================================================================
+
+inline unsigned long millis() { return (unsigned long)(mockClock.now / 1000ULL); }
+inline unsigned long micros() { return (unsigned long)mockClock.now; }
+inline void delay(uint32_t ms) { mockAdvance(ms); }
+inline void delayMicroseconds(uint32_t us) { mockAdvanceUs(us); }
+inline void yield() {}
+
+// ============================================================================
+// PINS, INTERRUPTS
+// ============================================================================
+
+inline void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin >= MOCK_PIN_COUNT) return;
+    mockPins[pin].mode = mode;
+    if (mode & PULLUP) mockPins[pin].level = HIGH;
+}
+
+inline int digitalRead(uint8_t pin) { return pin < MOCK_PIN_COUNT ? mockPins[pin].level : LOW; }
+inline void digitalWrite(uint8_t pin, uint8_t level) { mockPinSet(pin, level); }
+
+inline uint16_t analogRead(uint8_t pin) { return pin < MOCK_PIN_COUNT ? mockPins[pin].analog : 0; }
+inline uint32_t analogReadMilliVolts(uint8_t pin) { return analogRead(pin) * 3300UL / 4095UL; }
+
+inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+
+inline void attachInterrupt(uint8_t pin, void (*isr)(), int mode) {
+    if (pin >= MOCK_PIN_COUNT) return;
+    mockPins[pin].isr = isr;
+    mockPins[pin].isrMode = mode;
+    mockPins[pin].intrEnabled = true;
+}
+
+inline void detachInterrupt(uint8_t pin) {
+    if (pin >= MOCK_PIN_COUNT) return;
+    mockPins[pin].isr = nullptr;
+    mockPins[pin].intrEnabled = false;
+}
+
+// ============================================================================
+// RANDOM (xorshift32, reproducible per seed)
+// ============================================================================
+
+inline uint32_t mockRandomState = 0x2545F491;
+
+inline void randomSeed(unsigned long seed) { mockRandomState = seed ? seed : 0x2545F491; }
+
+inline long random(long howbig) {
+    if (howbig <= 0) return 0;
+    uint32_t x = mockRandomState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    mockRandomState = x;
+    return x % howbig;
+}
+
+inline long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return howsmall + random(howbig - howsmall);
+}
+
+// ============================================================================
+// LEDC
+// ============================================================================
+
+#define MOCK_LEDC_CHANNELS  16
+
+struct MockLedc {
+    double freq;
+    uint32_t duty;
+    int8_t pin;
+    uint32_t writes;
+};
+
+inline MockLedc mockLedc[MOCK_LEDC_CHANNELS];
+
+inline double ledcSetup(uint8_t ch, double freq, uint8_t) {
+    if (ch >= MOCK_LEDC_CHANNELS) return 0;
+    mockLedc[ch].freq = freq;
+    return freq;
+}
+
+inline void ledcAttachPin(uint8_t pin, uint8_t ch) { if (ch < MOCK_LEDC_CHANNELS) mockLedc[ch].pin = pin; }
+inline void ledcDetachPin(uint8_t pin) {
+    for (MockLedc& c : mockLedc) if (c.pin == pin) c.pin = -1;
+}
+
+inline void ledcWrite(uint8_t ch, uint32_t duty) {
+    if (ch >= MOCK_LEDC_CHANNELS) return;
+    mockLedc[ch].duty = duty;
+    mockLedc[ch].writes++;
+}
+
+inline double ledcWriteTone(uint8_t ch, double freq) {
+    if (ch >= MOCK_LEDC_CHANNELS) return 0;
+    mockLedc[ch].freq = freq;
+    return freq;
+}
+
+inline uint32_t ledcRead(uint8_t ch) { return ch < MOCK_LEDC_CHANNELS ? mockLedc[ch].duty : 0; }
+
+// ============================================================================
+// CPU CLOCK, CHIP
+// ============================================================================
+
+inline uint32_t mockCpuMhz = 240;
+
+inline bool setCpuFrequencyMhz(uint32_t mhz) {
+    if (mhz != 240 && mhz != 160 && mhz != 80 && mhz != 40 && mhz != 20 && mhz != 10) return false;
+    mockCpuMhz = mhz;
+    return true;
+}
+
+inline uint32_t getCpuFrequencyMhz() { return mockCpuMhz; }
+inline uint32_t getXtalFrequencyMhz() { return 40; }
+inline uint32_t getApbFrequency() { return mockCpuMhz >= 80 ? 80000000 : mockCpuMhz * 1000000; }
+
+// PSRAM fitted (0: none, the default) and handed out so far; heap_caps_free
+// doesn't give it back
+inline uint32_t mockPsramSize = 0;
+inline uint32_t mockPsramUsed = 0;
+
+inline bool psramFound() { return mockPsramSize > 0; }
+inline void* ps_malloc(size_t size) { return malloc(size); }
+
+class EspClass {
+public:
+    uint32_t mockHeapSize = 320 * 1024;
+    uint32_t mockFreeHeap = 240 * 1024;
+    uint32_t mockMinFreeHeap = 200 * 1024;
+    uint32_t mockMaxAllocHeap = 110 * 1024;
+    uint32_t mockRestarts = 0;
+
+    const char* getChipModel() { return "ESP32-S3"; }
+    uint8_t getChipRevision() { return 0; }
+    uint8_t getChipCores() { return 2; }
+    const char* getSdkVersion() { return "native"; }
+    uint32_t getCpuFreqMHz() { return mockCpuMhz; }
+    uint32_t getCycleCount() { return (uint32_t)(mockClock.now * mockCpuMhz); }
+
+    uint32_t getHeapSize() { return mockHeapSize; }
+    uint32_t getFreeHeap() { return mockFreeHeap; }
+    uint32_t getMinFreeHeap() { return mockMinFreeHeap; }
+    uint32_t getMaxAllocHeap() { return mockMaxAllocHeap; }
+    uint32_t getPsramSize() { return mockPsramSize; }
+    uint32_t getFreePsram() { return mockPsramSize - mockPsramUsed; }
+
+    uint32_t getFlashChipSize() { return 8 * 1024 * 1024; }
+    uint64_t getEfuseMac() { return 0x0000A1B2C3D4E5F6ULL; }
+
+    void restart() { mockRestarts++; }
+};
+
+inline EspClass ESP;
+
+// ============================================================================
+// RESET
+// ============================================================================
+
+// Core back to power-on: clock, pins, serial, LEDC, CPU clock, RNG, heap, stack.
+// PSRAM goes back to not fitted.
+inline void mockReset() {
+    mockClockReset();
+    mockGpioReset();
+    Serial.mockReset();
+    for (MockLedc& c : mockLedc) c = MockLedc{ 0, 0, -1, 0 };
+    mockCpuMhz = 240;
+    mockRandomState = 0x2545F491;
+    ESP.mockRestarts = 0;
+    ESP.mockFreeHeap = 240 * 1024;
+    ESP.mockMinFreeHeap = 200 * 1024;
+    ESP.mockMaxAllocHeap = 110 * 1024;
+    mockPsramSize = 0;
+    mockPsramUsed = 0;
+    mockStackReset();
+}
+
+#endif // MOCK_ARDUINO_H
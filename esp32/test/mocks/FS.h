@@ -0,0 +1,274 @@
+/*
+ * Filesystem mock
+ *
+ * A RAM tree behind the fs::FS / fs::File API that SD and LittleFS share.
+ * Files copied by value share one handle (position included), like the
+ * FileImplPtr in the real core. Writes stamp the mock clock as mtime.
+ * Opening for write needs the parent directory to exist, as on FAT.
+ */
+
+#ifndef MOCK_FS_H
+#define MOCK_FS_H
+
+#include <Arduino.h>
+#include <map>
+#include <memory>
+#include <vector>
+
+#define FILE_READ       "r"
+#define FILE_WRITE      "w"
+#define FILE_APPEND     "a"
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+struct MockNode {
+    bool dir;
+    std::vector<uint8_t> data;
+    time_t mtime;
+};
+
+typedef std::shared_ptr<MockNode> MockNodePtr;
+typedef std::map<std::string, MockNodePtr> MockTree;
+
+inline time_t mockFsTime() { return (time_t)(1700000000UL + millis() / 1000); }
+
+inline std::string mockParent(const std::string& path) {
+    size_t slash = path.rfind('/');
+    return (slash == std::string::npos || slash == 0) ? "/" : path.substr(0, slash);
+}
+
+class File : public Stream {
+private:
+    struct Handle {
+        MockNodePtr node;
+        std::string path;
+        size_t pos;
+        bool writable;
+        std::vector<std::pair<std::string, MockNodePtr>> entries;   // Directory listing
+        size_t nextEntry;
+    };
+    std::shared_ptr<Handle> h;
+
+public:
+    File() {}
+    File(MockNodePtr node, const std::string& path, bool writable, size_t pos,
+         std::vector<std::pair<std::string, MockNodePtr>> entries = {})
+        : h(new Handle{ node, path, pos, writable, std::move(entries), 0 }) {}
+
+    explicit operator bool() const { return h && h->node; }
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buf, size_t size) override {
+        if (!*this || !h->writable || h->node->dir) return 0;
+        std::vector<uint8_t>& d = h->node->data;
+        if (h->pos + size > d.size()) d.resize(h->pos + size);
+        memcpy(d.data() + h->pos, buf, size);
+        h->pos += size;
+        h->node->mtime = mockFsTime();
+        return size;
+    }
+    using Print::write;
+
+    int available() override {
+        if (!*this || h->node->dir) return 0;
+        return (int)(h->node->data.size() - std::min(h->pos, h->node->data.size()));
+    }
+    int read() override {
+        uint8_t c;
+        return read(&c, 1) == 1 ? c : -1;
+    }
+    int peek() override {
+        if (available() <= 0) return -1;
+        return h->node->data[h->pos];
+    }
+    size_t read(uint8_t* buf, size_t size) {
+        size_t n = std::min(size, (size_t)std::max(available(), 0));
+        if (n) memcpy(buf, h->node->data.data() + h->pos, n);
+        if (h) h->pos += n;
+        return n;
+    }
+    size_t readBytes(char* buffer, size_t length) override { return read((uint8_t*)buffer, length); }
+    void flush() override {}
+
+    bool seek(uint32_t pos, SeekMode mode = SeekSet) {
+        if (!*this || h->node->dir) return false;
+        size_t base = mode == SeekSet ? 0 : mode == SeekCur ? h->pos : h->node->data.size();
+        if (base + pos > h->node->data.size()) return false;
+        h->pos = base + pos;
+        return true;
+    }
+
+    size_t position() const { return h ? h->pos : 0; }
+    size_t size() const { return *this ? h->node->data.size() : 0; }
+    void close() { if (h) h->node.reset(); }
+    time_t getLastWrite() { return *this ? h->node->mtime : 0; }
+    const char* path() const { return h ? h->path.c_str() : nullptr; }
+    const char* name() const {
+        if (!h) return nullptr;
+        size_t slash = h->path.rfind('/');
+        return h->path.c_str() + (slash == std::string::npos || h->path == "/" ? 0 : slash + 1);
+    }
+    bool isDirectory() const { return *this && h->node->dir; }
+
+    File openNextFile(const char* = FILE_READ) {
+        if (!isDirectory() || h->nextEntry >= h->entries.size()) return File();
+        auto& e = h->entries[h->nextEntry++];
+        return File(e.second, e.first, false, 0);
+    }
+    void rewindDirectory() { if (h) h->nextEntry = 0; }
+};
+
+class FS {
+protected:
+    MockTree tree;
+    bool mounted = false;
+
+    static std::string normalize(const char* path) {
+        std::string p = path ? path : "";
+        if (p.empty() || p[0] != '/') p = "/" + p;
+        while (p.size() > 1 && p.back() == '/') p.pop_back();
+        return p;
+    }
+
+    MockNodePtr find(const std::string& path) {
+        auto it = tree.find(path);
+        return it == tree.end() ? nullptr : it->second;
+    }
+
+    bool usable() { return mounted && !mockEjected; }
+
+public:
+    bool mockEjected = false;   // Card pulled: every call fails
+
+    FS() { mockReset(); }
+
+    File open(const char* path, const char* mode = FILE_READ, bool create = false) {
+        if (!usable()) return File();
+        std::string p = normalize(path);
+        MockNodePtr node = find(p);
+
+        if (mode[0] == 'r') {
+            if (!node) return File();
+            if (!node->dir) return File(node, p, mode[1] == '+', 0);
+            std::vector<std::pair<std::string, MockNodePtr>> entries;
+            for (auto& e : tree) {
+                if (e.first != p && mockParent(e.first) == p) entries.push_back(e);
+            }
+            return File(node, p, false, 0, entries);
+        }
+
+        if (node && node->dir) return File();
+        MockNodePtr parent = find(mockParent(p));
+        if (!parent || !parent->dir) {
+            if (!create) return File();
+            mockMkdirs(mockParent(p));
+        }
+        if (!node) {
+            node = std::make_shared<MockNode>(MockNode{ false, {}, mockFsTime() });
+            tree[p] = node;
+        }
+        if (mode[0] == 'w') {
+            node->data.clear();
+            node->mtime = mockFsTime();
+        }
+        return File(node, p, true, mode[0] == 'a' ? node->data.size() : 0);
+    }
+    File open(const String& path, const char* mode = FILE_READ, bool create = false) {
+        return open(path.c_str(), mode, create);
+    }
+
+    bool exists(const char* path) { return usable() && find(normalize(path)) != nullptr; }
+    bool exists(const String& path) { return exists(path.c_str()); }
+
+    bool remove(const char* path) {
+        if (!usable()) return false;
+        MockNodePtr node = find(normalize(path));
+        if (!node || node->dir) return false;
+        tree.erase(normalize(path));
+        return true;
+    }
+
+    bool rename(const char* from, const char* to) {
+        if (!usable()) return false;
+        std::string a = normalize(from), b = normalize(to);
+        if (!find(a) || find(b) || !find(mockParent(b))) return false;
+        MockTree moved;
+        for (auto it = tree.begin(); it != tree.end();) {
+            if (it->first == a || it->first.compare(0, a.size() + 1, a + "/") == 0) {
+                moved[b + it->first.substr(a.size())] = it->second;
+                it = tree.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        tree.insert(moved.begin(), moved.end());
+        return true;
+    }
+
+    bool mkdir(const char* path) {
+        if (!usable()) return false;
+        std::string p = normalize(path);
+        MockNodePtr node = find(p);
+        if (node) return node->dir;
+        MockNodePtr parent = find(mockParent(p));
+        if (!parent || !parent->dir) return false;
+        tree[p] = std::make_shared<MockNode>(MockNode{ true, {}, mockFsTime() });
+        return true;
+    }
+    bool mkdir(const String& path) { return mkdir(path.c_str()); }
+
+    bool rmdir(const char* path) {
+        if (!usable()) return false;
+        std::string p = normalize(path);
+        MockNodePtr node = find(p);
+        if (!node || !node->dir || p == "/") return false;
+        for (auto& e : tree) if (mockParent(e.first) == p && e.first != p) return false;
+        tree.erase(p);
+        return true;
+    }
+
+    size_t usedBytes() {
+        size_t used = 0;
+        for (auto& e : tree) used += e.second->data.size();
+        return used;
+    }
+
+    // ---------- test hooks ----------
+    // Write a file directly, creating parent directories; works unmounted
+    void mockWrite(const char* path, const std::string& content) {
+        std::string p = normalize(path);
+        mockMkdirs(mockParent(p));
+        tree[p] = std::make_shared<MockNode>(
+            MockNode{ false, std::vector<uint8_t>(content.begin(), content.end()), mockFsTime() });
+    }
+
+    // Whole file as a string, "" if missing
+    std::string mockRead(const char* path) {
+        MockNodePtr node = find(normalize(path));
+        if (!node || node->dir) return "";
+        return std::string(node->data.begin(), node->data.end());
+    }
+
+    void mockMkdirs(const std::string& path) {
+        if (path == "/" || find(path)) return;
+        mockMkdirs(mockParent(path));
+        tree[path] = std::make_shared<MockNode>(MockNode{ true, {}, mockFsTime() });
+    }
+
+    // Empty and unmounted
+    void mockReset() {
+        tree.clear();
+        tree["/"] = std::make_shared<MockNode>(MockNode{ true, {}, 0 });
+        mounted = false;
+        mockEjected = false;
+    }
+};
+
+} // namespace fs
+
+using fs::FS;
+using fs::File;
+
+#endif // MOCK_FS_H
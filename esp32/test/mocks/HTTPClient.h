@@ -0,0 +1,112 @@
+/*
+ * HTTPClient mock
+ *
+ * Tests queue responses with HTTPClient::mockRespond(); each GET/POST takes
+ * the next one (nothing queued = connection refused) and is recorded in
+ * HTTPClient::mockRequests. A request on a closed client counts as a new
+ * connection (TLS handshake); setReuse(true) keeps it open after end().
+ */
+
+#ifndef MOCK_HTTPCLIENT_H
+#define MOCK_HTTPCLIENT_H
+
+#include <Arduino.h>
+#include <deque>
+#include <vector>
+#include "WiFiClient.h"
+
+#define HTTPC_ERROR_CONNECTION_REFUSED  (-1)
+#define HTTPC_ERROR_SEND_HEADER_FAILED  (-2)
+#define HTTPC_ERROR_NOT_CONNECTED       (-4)
+#define HTTPC_ERROR_CONNECTION_LOST     (-5)
+#define HTTPC_ERROR_READ_TIMEOUT        (-11)
+
+#define HTTP_CODE_OK                    200
+
+struct MockHttpResponse {
+    int code;
+    String body;
+};
+
+struct MockHttpRequest {
+    String method;
+    String url;
+    String body;
+    std::vector<std::pair<String, String>> headers;
+    uint16_t timeout;
+    bool newConnection;
+
+    String header(const char* name) const {
+        for (auto& h : headers) if (h.first == name) return h.second;
+        return String();
+    }
+};
+
+class HTTPClient {
+private:
+    WiFiClient* client = nullptr;
+    MockHttpRequest req;
+    String response;
+    bool reuse = false;
+
+    int send(const char* method, const String& body) {
+        req.method = method;
+        req.body = body;
+        req.newConnection = client && !client->connected();
+        if (req.newConnection) client->connect("mock", 443);
+        mockRequests.push_back(req);
+
+        if (mockResponses.empty()) {
+            if (client) client->stop();
+            return HTTPC_ERROR_CONNECTION_REFUSED;
+        }
+        MockHttpResponse r = mockResponses.front();
+        mockResponses.pop_front();
+        response = r.body;
+        if (r.code < 0 && client) client->stop();
+        return r.code;
+    }
+
+public:
+    static inline std::deque<MockHttpResponse> mockResponses;
+    static inline std::vector<MockHttpRequest> mockRequests;
+
+    static void mockRespond(int code, const char* body = "") { mockResponses.push_back({ code, body }); }
+    static void mockReset() {
+        mockResponses.clear();
+        mockRequests.clear();
+    }
+
+    bool begin(WiFiClient& c, const String& url) {
+        client = &c;
+        req = MockHttpRequest{ "", url, "", {}, 5000, false };
+        return true;
+    }
+
+    void addHeader(const String& name, const String& value, bool = false, bool = true) {
+        req.headers.push_back({ name, value });
+    }
+    void setReuse(bool on) { reuse = on; }
+    void setTimeout(uint16_t ms) { req.timeout = ms; }
+    void setConnectTimeout(int32_t) {}
+
+    int GET() { return send("GET", String()); }
+    int POST(const String& body) { return send("POST", body); }
+    int POST(const uint8_t* data, size_t size) {
+        String body;
+        body.concat((const char*)data, size);
+        return send("POST", body);
+    }
+
+    String getString() { return response; }
+    int getSize() { return response.length(); }
+
+    void end() {
+        if (client && !reuse) client->stop();
+        client = nullptr;
+    }
+
+    static String errorToString(int code) { return String("mock error ") + String(code); }
+};
+
+#endif // MOCK_HTTPCLIENT_H
@@ -0,0 +1,24 @@
+#ifndef MOCK_IPADDRESS_H
+#define MOCK_IPADDRESS_H
+
+#include <Arduino.h>
+
+class IPAddress {
+private:
+    uint8_t octets[4];
+
+public:
+    IPAddress() : octets{ 0, 0, 0, 0 } {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : octets{ a, b, c, d } {}
+
+    uint8_t operator[](int i) const { return octets[i]; }
+    bool operator==(const IPAddress& o) const { return memcmp(octets, o.octets, 4) == 0; }
+
+    String toString() const {
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+        return String(buf);
+    }
+};
+
+#endif // MOCK_IPADDRESS_H
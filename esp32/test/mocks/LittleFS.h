@@ -0,0 +1,37 @@
+#ifndef MOCK_LITTLEFS_H
+#define MOCK_LITTLEFS_H
+
+#include <Arduino.h>
+#include <FS.h>
+
+namespace fs {
+
+class LittleFSFS : public FS {
+public:
+    bool mockMountable = true;                  // false: corrupt partition
+    size_t mockTotalBytes = 1536 * 1024;
+
+    bool begin(bool formatOnFail = false, const char* = "/littlefs", uint8_t = 10,
+               const char* = "spiffs") {
+        if (!mockMountable && formatOnFail) format();
+        mounted = mockMountable;
+        return mounted;
+    }
+    void end() { mounted = false; }
+
+    bool format() {
+        bool wasMounted = mounted;
+        mockReset();
+        mounted = wasMounted;
+        mockMountable = true;
+        return true;
+    }
+
+    size_t totalBytes() { return mockTotalBytes; }
+};
+
+} // namespace fs
+
+inline fs::LittleFSFS LittleFS;
+
+#endif // MOCK_LITTLEFS_H
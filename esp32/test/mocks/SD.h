@@ -0,0 +1,36 @@
+#ifndef MOCK_SD_H
+#define MOCK_SD_H
+
+#include <Arduino.h>
+#include <FS.h>
+#include <SPI.h>
+
+typedef enum { CARD_NONE, CARD_MMC, CARD_SD, CARD_SDHC, CARD_UNKNOWN } sdcard_type_t;
+
+namespace fs {
+
+class SDFS : public FS {
+public:
+    bool mockPresent = true;                    // Card in the slot at begin()
+    uint64_t mockCardSize = 16ULL << 30;
+
+    bool begin(uint8_t = 5, SPIClass& = SPI, uint32_t = 4000000, const char* = "/sd",
+               uint8_t = 5, bool = false) {
+        mounted = mockPresent;
+        mockEjected = false;
+        return mounted;
+    }
+    void end() { mounted = false; }
+
+    sdcard_type_t cardType() { return usable() ? CARD_SDHC : CARD_NONE; }
+    uint64_t cardSize() { return usable() ? mockCardSize : 0; }
+    uint64_t totalBytes() { return cardSize(); }
+};
+
+} // namespace fs
+
+inline fs::SDFS SD;
+
+using namespace fs;
+
+#endif // MOCK_SD_H
@@ -0,0 +1,14 @@
+#ifndef MOCK_SPI_H
+#define MOCK_SPI_H
+
+#include <Arduino.h>
+
+class SPIClass {
+public:
+    void begin(int8_t = -1, int8_t = -1, int8_t = -1, int8_t = -1) {}
+    void end() {}
+};
+
+inline SPIClass SPI;
+
+#endif // MOCK_SPI_H
@@ -0,0 +1,85 @@
+/*
+ * WiFi mock: begin() connects at once unless mockConnectResult says
+ * otherwise; status() reports whatever the test last set.
+ */
+
+#ifndef MOCK_WIFI_H
+#define MOCK_WIFI_H
+
+#include <Arduino.h>
+#include "IPAddress.h"
+#include "WiFiClient.h"
+#include "WiFiServer.h"
+
+typedef enum {
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL,
+    WL_SCAN_COMPLETED,
+    WL_CONNECTED,
+    WL_CONNECT_FAILED,
+    WL_CONNECTION_LOST,
+    WL_DISCONNECTED,
+} wl_status_t;
+
+typedef enum { WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA } wifi_mode_t;
+
+class WiFiClass {
+private:
+    wifi_mode_t currentMode = WIFI_OFF;
+    String ssid;
+    String pass;
+    int32_t chan = 0;
+    uint8_t bssid[6] = {};
+
+public:
+    wl_status_t mockStatus = WL_DISCONNECTED;
+    wl_status_t mockConnectResult = WL_CONNECTED;   // What begin() leads to
+    int8_t mockRSSI = -55;
+    uint32_t mockBegins = 0;
+
+    bool mode(wifi_mode_t m) { currentMode = m; return true; }
+    wifi_mode_t getMode() { return currentMode; }
+
+    wl_status_t begin(const char* s, const char* p = nullptr, int32_t channel = 0,
+                      const uint8_t* b = nullptr, bool = true) {
+        if (currentMode == WIFI_OFF) currentMode = WIFI_STA;
+        ssid = s;
+        pass = p;
+        chan = channel ? channel : 6;
+        if (b) memcpy(bssid, b, 6);
+        else memcpy(bssid, "\x02\x00\x00\xAA\xBB\xCC", 6);
+        mockBegins++;
+        mockStatus = mockConnectResult;
+        return mockStatus;
+    }
+
+    bool disconnect(bool wifiOff = false, bool = false) {
+        mockStatus = WL_DISCONNECTED;
+        if (wifiOff) currentMode = WIFI_OFF;
+        return true;
+    }
+
+    wl_status_t status() { return mockStatus; }
+    bool isConnected() { return mockStatus == WL_CONNECTED; }
+    IPAddress localIP() { return isConnected() ? IPAddress(192, 168, 1, 42) : IPAddress(); }
+    String SSID() { return isConnected() ? ssid : String(); }
+    String psk() { return pass; }
+    int32_t channel() { return chan; }
+    uint8_t* BSSID() { return isConnected() ? bssid : nullptr; }
+    int8_t RSSI() { return isConnected() ? mockRSSI : 0; }
+    bool setSleep(bool) { return true; }
+    String macAddress() { return String("02:00:00:A1:B2:C3"); }
+
+    void mockReset() {
+        currentMode = WIFI_OFF;
+        ssid = pass = "";
+        chan = 0;
+        mockStatus = WL_DISCONNECTED;
+        mockConnectResult = WL_CONNECTED;
+        mockBegins = 0;
+    }
+};
+
+inline WiFiClass WiFi;
+
+#endif // MOCK_WIFI_H
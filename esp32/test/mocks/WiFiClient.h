@@ -0,0 +1,37 @@
+/*
+ * TCP client mock. No bytes flow; HTTPClient drives the connection state
+ * so keep-alive and handshake counts can be checked.
+ */
+
+#ifndef MOCK_WIFICLIENT_H
+#define MOCK_WIFICLIENT_H
+
+#include <Arduino.h>
+
+class WiFiClient : public Stream {
+protected:
+    bool open = false;
+
+public:
+    uint32_t mockConnects = 0;          // Times a connection was (re)opened
+
+    virtual ~WiFiClient() {}
+
+    virtual int connect(const char*, uint16_t) {
+        open = true;
+        mockConnects++;
+        return 1;
+    }
+    virtual uint8_t connected() { return open; }
+    virtual void stop() { open = false; }
+    explicit operator bool() { return open; }
+
+    size_t write(uint8_t) override { return open ? 1 : 0; }
+    size_t write(const uint8_t*, size_t size) override { return open ? size : 0; }
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+};
+
+#endif // MOCK_WIFICLIENT_H
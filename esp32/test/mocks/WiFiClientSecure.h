@@ -0,0 +1,25 @@
+#ifndef MOCK_WIFICLIENTSECURE_H
+#define MOCK_WIFICLIENTSECURE_H
+
+#include <Arduino.h>
+#include <mbedtls/x509_crt.h>
+#include "WiFiClient.h"
+
+class WiFiClientSecure : public WiFiClient {
+public:
+    const char* mockCACert = nullptr;
+    bool mockInsecure = false;
+
+    // Shared by every instance: clients owned by other classes are private
+    static inline const uint8_t* mockCABundle = nullptr;        // Last setCACertBundle()
+    static inline mbedtls_x509_crt* mockPeerChain = nullptr;    // Leaf first, presented on connect
+
+    void setCACert(const char* rootCA) { mockCACert = rootCA; }
+    void setCACertBundle(const uint8_t* bundle) { mockCABundle = bundle; }
+    void setInsecure() { mockInsecure = true; }
+    void setHandshakeTimeout(unsigned long) {}
+
+    const mbedtls_x509_crt* getPeerCertificate() { return open ? mockPeerChain : nullptr; }
+};
+
+#endif // MOCK_WIFICLIENTSECURE_H
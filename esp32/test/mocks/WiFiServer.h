@@ -0,0 +1,31 @@
+/*
+ * TCP server mock: listens or not; no client ever connects. Request
+ * handling is tested by handing the handler a Stream directly.
+ */
+
+#ifndef MOCK_WIFISERVER_H
+#define MOCK_WIFISERVER_H
+
+#include <Arduino.h>
+#include "WiFiClient.h"
+
+class WiFiServer {
+private:
+    uint16_t port;
+
+public:
+    bool mockListening = false;
+
+    explicit WiFiServer(uint16_t p = 80) : port(p) {}
+
+    void begin(uint16_t p = 0) {
+        if (p) port = p;
+        mockListening = true;
+    }
+    void end() { mockListening = false; }
+    void setNoDelay(bool) {}
+    WiFiClient available() { return WiFiClient(); }
+    uint16_t mockPort() { return port; }
+};
+
+#endif // MOCK_WIFISERVER_H
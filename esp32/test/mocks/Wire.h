@@ -0,0 +1,110 @@
+/*
+ * I2C bus mock
+ *
+ * Devices are attached by address. A device with memory behaves like a
+ * 24LC-series EEPROM: the first two bytes of a write set the address
+ * pointer, the rest are stored; reads continue from the pointer. Anything
+ * else just ACKs (the OLED).
+ */
+
+#ifndef MOCK_WIRE_H
+#define MOCK_WIRE_H
+
+#include <Arduino.h>
+#include <map>
+#include <vector>
+
+struct MockI2CDevice {
+    std::vector<uint8_t> mem;   // Empty: ACK-only device
+    uint16_t pointer;
+    uint32_t writes;            // Completed write transactions
+};
+
+class TwoWire : public Stream {
+private:
+    std::map<uint8_t, MockI2CDevice> devices;
+    uint8_t txAddr = 0;
+    std::vector<uint8_t> tx;
+    std::vector<uint8_t> rx;
+    size_t rxPos = 0;
+    uint32_t clock = 100000;
+
+public:
+    bool begin(int = -1, int = -1, uint32_t frequency = 0) {
+        if (frequency) clock = frequency;
+        return true;
+    }
+    void end() {}
+    bool setClock(uint32_t frequency) { clock = frequency; return true; }
+    uint32_t getClock() { return clock; }
+
+    void beginTransmission(uint16_t address) {
+        txAddr = address;
+        tx.clear();
+    }
+
+    size_t write(uint8_t c) override { tx.push_back(c); return 1; }
+    size_t write(const uint8_t* buf, size_t size) override {
+        tx.insert(tx.end(), buf, buf + size);
+        return size;
+    }
+    size_t write(unsigned long n) { return write((uint8_t)n); }
+    size_t write(long n) { return write((uint8_t)n); }
+    size_t write(unsigned int n) { return write((uint8_t)n); }
+    size_t write(int n) { return write((uint8_t)n); }
+    using Print::write;
+
+    // 0 = ACK, 2 = address NACK (nothing there)
+    uint8_t endTransmission(bool = true) {
+        auto it = devices.find(txAddr);
+        if (it == devices.end()) return 2;
+        MockI2CDevice& d = it->second;
+        if (!d.mem.empty() && tx.size() >= 2) {
+            d.pointer = (tx[0] << 8) | tx[1];
+            for (size_t i = 2; i < tx.size(); i++) {
+                d.mem[d.pointer % d.mem.size()] = tx[i];
+                d.pointer++;
+            }
+            if (tx.size() > 2) d.writes++;
+        }
+        return 0;
+    }
+
+    uint8_t requestFrom(uint16_t address, size_t size, bool = true) {
+        rx.clear();
+        rxPos = 0;
+        auto it = devices.find(address);
+        if (it == devices.end()) return 0;
+        MockI2CDevice& d = it->second;
+        for (size_t i = 0; i < size; i++) {
+            rx.push_back(d.mem.empty() ? 0xFF : d.mem[d.pointer % d.mem.size()]);
+            d.pointer++;
+        }
+        return (uint8_t)size;
+    }
+
+    int available() override { return (int)(rx.size() - rxPos); }
+    int read() override { return rxPos < rx.size() ? rx[rxPos++] : -1; }
+    int peek() override { return rxPos < rx.size() ? rx[rxPos] : -1; }
+
+    // ---------- test hooks ----------
+    // memBytes > 0: EEPROM of that size, erased to 0xFF
+    void mockAttach(uint8_t address, size_t memBytes = 0) {
+        devices[address] = MockI2CDevice{ std::vector<uint8_t>(memBytes, 0xFF), 0, 0 };
+    }
+    void mockDetach(uint8_t address) { devices.erase(address); }
+    MockI2CDevice* mockDevice(uint8_t address) {
+        auto it = devices.find(address);
+        return it == devices.end() ? nullptr : &it->second;
+    }
+    void mockReset() {
+        devices.clear();
+        tx.clear();
+        rx.clear();
+        rxPos = 0;
+    }
+};
+
+inline TwoWire Wire;
+
+#endif // MOCK_WIRE_H
@@ -0,0 +1,49 @@
+#ifndef MOCK_DRIVER_GPIO_H
+#define MOCK_DRIVER_GPIO_H
+
+#include "esp_err.h"
+#include "mock_gpio.h"
+
+enum gpio_num_t : int {
+    GPIO_NUM_NC = -1,
+    GPIO_NUM_0 = 0,
+    GPIO_NUM_1, GPIO_NUM_2, GPIO_NUM_3, GPIO_NUM_4, GPIO_NUM_5,
+    GPIO_NUM_MAX = 49,
+};
+
+typedef enum {
+    GPIO_INTR_DISABLE,
+    GPIO_INTR_POSEDGE,
+    GPIO_INTR_NEGEDGE,
+    GPIO_INTR_ANYEDGE,
+    GPIO_INTR_LOW_LEVEL,
+    GPIO_INTR_HIGH_LEVEL,
+} gpio_int_type_t;
+
+inline int gpio_get_level(gpio_num_t pin) {
+    return (pin >= 0 && pin < MOCK_PIN_COUNT) ? mockPins[pin].level : 0;
+}
+
+inline esp_err_t gpio_set_intr_type(gpio_num_t pin, gpio_int_type_t type) {
+    if (pin < 0 || pin >= MOCK_PIN_COUNT) return ESP_ERR_INVALID_ARG;
+    static const uint8_t MODES[] = { 0, RISING, FALLING, CHANGE, 0, 0 };
+    mockPins[pin].isrMode = MODES[type];
+    return ESP_OK;
+}
+
+inline esp_err_t gpio_intr_enable(gpio_num_t pin) {
+    if (pin < 0 || pin >= MOCK_PIN_COUNT) return ESP_ERR_INVALID_ARG;
+    mockPins[pin].intrEnabled = true;
+    return ESP_OK;
+}
+
+inline esp_err_t gpio_intr_disable(gpio_num_t pin) {
+    if (pin < 0 || pin >= MOCK_PIN_COUNT) return ESP_ERR_INVALID_ARG;
+    mockPins[pin].intrEnabled = false;
+    return ESP_OK;
+}
+
+inline esp_err_t gpio_wakeup_enable(gpio_num_t, gpio_int_type_t) { return ESP_OK; }
+inline esp_err_t gpio_wakeup_disable(gpio_num_t) { return ESP_OK; }
+
+#endif // MOCK_DRIVER_GPIO_H
@@ -0,0 +1,50 @@
+/*
+ * heap_caps on the ESP mock's heap numbers: internal and DMA-capable RAM
+ * are the same pool (ESP.mockFreeHeap and friends). PSRAM is there when a
+ * test sets mockPsramSize; allocations from it come from the host heap.
+ */
+
+#ifndef MOCK_ESP_HEAP_CAPS_H
+#define MOCK_ESP_HEAP_CAPS_H
+
+#include "Arduino.h"
+
+#define MALLOC_CAP_EXEC         (1 << 0)
+#define MALLOC_CAP_32BIT        (1 << 1)
+#define MALLOC_CAP_8BIT         (1 << 2)
+#define MALLOC_CAP_DMA          (1 << 3)
+#define MALLOC_CAP_SPIRAM       (1 << 10)
+#define MALLOC_CAP_INTERNAL     (1 << 11)
+#define MALLOC_CAP_DEFAULT      (1 << 12)
+
+inline size_t mockExtmemLimit = 0;      // Last heap_caps_malloc_extmem_enable(), 0 = not called
+
+inline size_t heap_caps_get_total_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? mockPsramSize : ESP.mockHeapSize;
+}
+
+inline size_t heap_caps_get_free_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? mockPsramSize - mockPsramUsed : ESP.mockFreeHeap;
+}
+
+inline size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? mockPsramSize - mockPsramUsed : ESP.mockMinFreeHeap;
+}
+
+inline size_t heap_caps_get_largest_free_block(uint32_t caps) {
+    return (caps & MALLOC_CAP_SPIRAM) ? mockPsramSize - mockPsramUsed : ESP.mockMaxAllocHeap;
+}
+
+inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+    if (caps & MALLOC_CAP_SPIRAM) {
+        if (mockPsramUsed + size > mockPsramSize) return nullptr;
+        mockPsramUsed += size;
+    }
+    return malloc(size);
+}
+
+inline void heap_caps_free(void* ptr) { free(ptr); }
+
+inline void heap_caps_malloc_extmem_enable(size_t limit) { mockExtmemLimit = limit; }
+
+#endif // MOCK_ESP_HEAP_CAPS_H
@@ -0,0 +1,63 @@
+/*
+ * Sleep on the mock clock: a light sleep returns after its timer wakeup
+ * with that much virtual time gone; a deep sleep is only recorded.
+ */
+
+#ifndef MOCK_ESP_SLEEP_H
+#define MOCK_ESP_SLEEP_H
+
+#include <cstdint>
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
+
+typedef enum {
+    ESP_SLEEP_WAKEUP_UNDEFINED,
+    ESP_SLEEP_WAKEUP_ALL,
+    ESP_SLEEP_WAKEUP_EXT0,
+    ESP_SLEEP_WAKEUP_EXT1,
+    ESP_SLEEP_WAKEUP_TIMER,
+    ESP_SLEEP_WAKEUP_TOUCHPAD,
+    ESP_SLEEP_WAKEUP_ULP,
+    ESP_SLEEP_WAKEUP_GPIO,
+    ESP_SLEEP_WAKEUP_UART,
+} esp_sleep_wakeup_cause_t;
+
+typedef esp_sleep_wakeup_cause_t esp_sleep_source_t;
+
+struct MockSleep {
+    esp_sleep_wakeup_cause_t cause;     // Reported by esp_sleep_get_wakeup_cause()
+    uint64_t timerUs;                   // 0 = no timer wakeup armed
+    uint32_t lightSleeps;
+    uint32_t deepSleeps;
+};
+
+inline MockSleep mockSleep;
+
+inline void mockSleepReset() { mockSleep = MockSleep{ ESP_SLEEP_WAKEUP_UNDEFINED, 0, 0, 0 }; }
+
+inline esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() { return mockSleep.cause; }
+
+inline esp_err_t esp_sleep_enable_timer_wakeup(uint64_t us) {
+    mockSleep.timerUs = us;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_sleep_enable_ext0_wakeup(gpio_num_t, int) { return ESP_OK; }
+inline esp_err_t esp_sleep_enable_gpio_wakeup() { return ESP_OK; }
+
+inline esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t source) {
+    if (source == ESP_SLEEP_WAKEUP_TIMER || source == ESP_SLEEP_WAKEUP_ALL) mockSleep.timerUs = 0;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_light_sleep_start() {
+    mockSleep.lightSleeps++;
+    mockAdvanceUs(mockSleep.timerUs);
+    mockSleep.cause = ESP_SLEEP_WAKEUP_TIMER;
+    return ESP_OK;
+}
+
+inline void esp_deep_sleep_start() { mockSleep.deepSleeps++; }
+
+#endif // MOCK_ESP_SLEEP_H
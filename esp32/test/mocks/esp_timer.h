@@ -0,0 +1,49 @@
+/*
+ * esp_timer on the mock clock: one-shots fire from mockAdvance()/delay(),
+ * as if the timer task ran them at the exact due time.
+ */
+
+#ifndef MOCK_ESP_TIMER_H
+#define MOCK_ESP_TIMER_H
+
+#include "esp_err.h"
+#include "mock_clock.h"
+
+typedef esp_timer* esp_timer_handle_t;
+
+typedef enum { ESP_TIMER_TASK, ESP_TIMER_ISR } esp_timer_dispatch_t;
+
+struct esp_timer_create_args_t {
+    esp_timer_cb_t callback;
+    void* arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char* name;
+    bool skip_unhandled_events;
+};
+
+inline esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out) {
+    esp_timer* t = new esp_timer{ args->callback, args->arg, args->name, false, 0 };
+    mockClock.timers.push_back(t);
+    *out = t;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_timer_start_once(esp_timer_handle_t t, uint64_t us) {
+    if (!t) return ESP_ERR_INVALID_ARG;
+    if (t->armed) return ESP_ERR_INVALID_STATE;
+    t->armed = true;
+    t->due = mockClock.now + us;
+    return ESP_OK;
+}
+
+inline esp_err_t esp_timer_stop(esp_timer_handle_t t) {
+    if (!t || !t->armed) return ESP_ERR_INVALID_STATE;
+    t->armed = false;
+    return ESP_OK;
+}
+
+inline bool esp_timer_is_active(esp_timer_handle_t t) { return t && t->armed; }
+
+inline int64_t esp_timer_get_time() { return (int64_t)mockClock.now; }
+
+#endif // MOCK_ESP_TIMER_H
@@ -0,0 +1,30 @@
+/*
+ * FreeRTOS types and critical sections for single-threaded native tests.
+ */
+
+#ifndef MOCK_FREERTOS_H
+#define MOCK_FREERTOS_H
+
+#include <cstdint>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void* TaskHandle_t;
+
+typedef struct { uint32_t owner; uint32_t count; } portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    { 0, 0 }
+#define portENTER_CRITICAL(mux)         ((void)(mux))
+#define portEXIT_CRITICAL(mux)          ((void)(mux))
+#define portENTER_CRITICAL_ISR(mux)     ((void)(mux))
+#define portEXIT_CRITICAL_ISR(mux)      ((void)(mux))
+
+#define portMAX_DELAY       0xFFFFFFFFUL
+#define portTICK_PERIOD_MS  1
+#define pdMS_TO_TICKS(ms)   ((TickType_t)(ms))
+#define pdFALSE             0
+#define pdTRUE              1
+#define pdPASS              1
+
+#endif // MOCK_FREERTOS_H
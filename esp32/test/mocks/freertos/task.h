@@ -0,0 +1,74 @@
+/*
+ * FreeRTOS task queries on a pretend loop task: its stack is a byte array
+ * filled like the real one, mockStackUse() scribbles on it as a call would,
+ * and other tasks are just a name and a high-water mark.
+ */
+
+#ifndef MOCK_FREERTOS_TASK_H
+#define MOCK_FREERTOS_TASK_H
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include "FreeRTOS.h"
+
+#ifndef ARDUINO_LOOP_STACK_SIZE
+#define ARDUINO_LOOP_STACK_SIZE 8192
+#endif
+
+#define MOCK_STACK_FILL     0xA5
+
+struct MockTask {
+    std::string name;
+    UBaseType_t freeBytes;
+};
+
+struct MockStack {
+    uint8_t mem[ARDUINO_LOOP_STACK_SIZE];
+    uint32_t depth;                     // In use above the current frame
+    std::vector<MockTask> tasks;
+};
+
+inline MockStack mockStack;
+
+// Stack pointer of the code under test
+inline uint8_t* mockStackPointer() { return mockStack.mem + ARDUINO_LOOP_STACK_SIZE - mockStack.depth; }
+
+// A call from the current frame that goes `bytes` deeper
+inline void mockStackUse(uint32_t bytes) { memset(mockStackPointer() - bytes, 0, bytes); }
+
+// Fresh loop task, `depth` bytes already in use (setup, loop, the caller)
+inline void mockStackReset(uint32_t depth = 512) {
+    memset(mockStack.mem, MOCK_STACK_FILL, sizeof(mockStack.mem));
+    mockStack.depth = 0;
+    mockStackUse(depth);
+    mockStack.depth = depth;
+    mockStack.tasks.clear();
+}
+
+inline void mockTaskAdd(const char* name, UBaseType_t freeBytes) {
+    mockStack.tasks.push_back({ name, freeBytes });
+}
+
+// nullptr is the loop task, the rest are indexes into the task list plus one
+inline TaskHandle_t xTaskGetHandle(const char* name) {
+    if (strcmp(name, "loopTask") == 0) return (TaskHandle_t)&mockStack;
+    for (size_t i = 0; i < mockStack.tasks.size(); i++) {
+        if (mockStack.tasks[i].name == name) return (TaskHandle_t)(i + 1);
+    }
+    return nullptr;
+}
+
+inline uint8_t* pxTaskGetStackStart(TaskHandle_t) { return mockStack.mem; }
+
+// Bytes, as on ESP-IDF (StackType_t is uint8_t there)
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t t) {
+    if (t == nullptr || t == (TaskHandle_t)&mockStack) {
+        UBaseType_t n = 0;
+        while (n < sizeof(mockStack.mem) && mockStack.mem[n] == MOCK_STACK_FILL) n++;
+        return n;
+    }
+    return mockStack.tasks[(size_t)t - 1].freeBytes;
+}
+
+#endif // MOCK_FREERTOS_TASK_H
@@ -0,0 +1,23 @@
+/*
+ * mbedTLS certificate chain, just the fields the firmware reads: raw DER,
+ * the SubjectPublicKeyInfo and the link to the next cert up the chain.
+ */
+
+#ifndef MOCK_MBEDTLS_X509_CRT_H
+#define MOCK_MBEDTLS_X509_CRT_H
+
+#include <stddef.h>
+
+typedef struct mbedtls_x509_buf {
+    int tag;
+    size_t len;
+    unsigned char* p;
+} mbedtls_x509_buf;
+
+typedef struct mbedtls_x509_crt {
+    mbedtls_x509_buf raw;
+    mbedtls_x509_buf pk_raw;
+    struct mbedtls_x509_crt* next;
+} mbedtls_x509_crt;
+
+#endif // MOCK_MBEDTLS_X509_CRT_H
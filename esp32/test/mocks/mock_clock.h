@@ -0,0 +1,59 @@
+/*
+ * Mock Clock
+ *
+ * Virtual time for native tests. Nothing moves unless a test (or the code
+ * under test, through delay()) advances it, so timing logic is exact and
+ * repeatable. esp_timer one-shots live here too: advancing the clock fires
+ * every timer that comes due, in order, at its own timestamp.
+ */
+
+#ifndef MOCK_CLOCK_H
+#define MOCK_CLOCK_H
+
+#include <cstdint>
+#include <vector>
+
+typedef void (*esp_timer_cb_t)(void* arg);
+
+struct esp_timer {
+    esp_timer_cb_t callback;
+    void* arg;
+    const char* name;
+    bool armed;
+    uint64_t due;               // Mock microseconds
+};
+
+struct MockClock {
+    uint64_t now;               // Microseconds since "boot"
+    std::vector<esp_timer*> timers;
+};
+
+inline MockClock mockClock;
+
+inline uint64_t mockMicros() { return mockClock.now; }
+
+// Move time forward, firing timers as they come due. Callbacks may re-arm.
+inline void mockAdvanceUs(uint64_t us) {
+    uint64_t target = mockClock.now + us;
+    for (;;) {
+        esp_timer* next = nullptr;
+        for (esp_timer* t : mockClock.timers) {
+            if (t->armed && t->due <= target && (!next || t->due < next->due)) next = t;
+        }
+        if (!next) break;
+        if (next->due > mockClock.now) mockClock.now = next->due;
+        next->armed = false;
+        next->callback(next->arg);
+    }
+    mockClock.now = target;
+}
+
+inline void mockAdvance(uint32_t ms) { mockAdvanceUs((uint64_t)ms * 1000ULL); }
+
+// Back to t = 0 with every timer disarmed (handles stay valid)
+inline void mockClockReset() {
+    mockClock.now = 0;
+    for (esp_timer* t : mockClock.timers) t->armed = false;
+}
+
+#endif // MOCK_CLOCK_H
@@ -0,0 +1,62 @@
+/*
+ * Mock GPIO
+ *
+ * One table behind both the Arduino pin API and driver/gpio.h. Tests drive
+ * inputs with mockPinSet(), which runs the attached ISR on a matching edge
+ * the way the GPIO interrupt would.
+ */
+
+#ifndef MOCK_GPIO_H
+#define MOCK_GPIO_H
+
+#include <cstdint>
+
+#define MOCK_PIN_COUNT  64
+
+// Arduino-ESP32 values
+#define INPUT           0x01
+#define OUTPUT          0x03
+#define PULLUP          0x04
+#define INPUT_PULLUP    0x05
+#define PULLDOWN        0x08
+#define INPUT_PULLDOWN  0x09
+
+#define RISING          0x01
+#define FALLING         0x02
+#define CHANGE          0x03
+#define ONLOW           0x04
+#define ONHIGH          0x05
+
+struct MockPin {
+    uint8_t mode;
+    uint8_t level;
+    uint16_t analog;            // analogRead() value, 12-bit
+    void (*isr)();
+    uint8_t isrMode;            // RISING / FALLING / CHANGE, 0 = none
+    bool intrEnabled;
+};
+
+inline MockPin mockPins[MOCK_PIN_COUNT];
+
+inline void mockGpioReset() {
+    for (MockPin& p : mockPins) p = MockPin{ 0, 0, 0, nullptr, 0, false };
+}
+
+inline void mockPinSet(uint8_t pin, uint8_t level) {
+    if (pin >= MOCK_PIN_COUNT) return;
+    MockPin& p = mockPins[pin];
+    uint8_t old = p.level;
+    p.level = level ? 1 : 0;
+    if (!p.isr || !p.intrEnabled || old == p.level) return;
+    if (p.isrMode == CHANGE ||
+        (p.isrMode == RISING && p.level) ||
+        (p.isrMode == FALLING && !p.level)) {
+        p.isr();
+    }
+}
+
+inline void mockAnalogSet(uint8_t pin, uint16_t raw) {
+    if (pin < MOCK_PIN_COUNT) mockPins[pin].analog = raw;
+}
+
+#endif // MOCK_GPIO_H
@@ -0,0 +1,166 @@
+/*
+ * Buzzer: RTTTL parsed at compile time, melody expansion, and the
+ * esp_timer sequencer playing into the mock LEDC channel.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "melody.h"
+
+// The parser runs in the compiler; these fail the build, not the run
+static_assert(MELODY_SYNC.bpm == 200, "bpm from header");
+static_assert(sizeof(MELODY_SYNC.notes) / sizeof(PackedNote) == 3, "note count");
+static_assert(MELODY_SYNC.notes[0].pitch == 2 * 12 + 4 + 1, "e6");
+static_assert(MELODY_SYNC.notes[0].len == MELODY_LEN_WHOLE / 16, "default duration");
+static_assert(MELODY_SYNC.notes[2].pitch == 3 * 12 + 1 && MELODY_SYNC.notes[2].len == 8, "8c7");
+static_assert(MELODY_BOOT.notes[1].pitch == 0, "rest");
+static_assert(MELODY_BOOT.notes[4].len == 8 + 4, "dotted eighth");
+static_assert(MELODY_BILLING.notes[2].pitch == 9 + 1, "a4 overrides the default octave");
+
+static const uint16_t FULL = AUDIO_DUTY_FULL;
+
+static uint32_t freq() { return (uint32_t)mockLedc[BUZZER_CHANNEL].freq; }
+static uint32_t duty() { return mockLedc[BUZZER_CHANNEL].duty; }
+
+void setUp() {
+    mockReset();
+    audio.pin = -1;
+    audio.count = 0;
+    audio.playing = false;
+    audio.volume = 100;
+}
+
+void tearDown() {}
+
+// ============================================================================
+// MELODIES
+// ============================================================================
+
+void test_expand_splits_tone_and_gap() {
+    AudioNote notes[AUDIO_QUEUE_LEN];
+    uint8_t n = melodyExpand(MELODY_SYNC, notes);
+
+    // 1/16 at 200 bpm = 75 ms: 68 tone + 7 gap; the 1/8 is 150 ms
+    TEST_ASSERT_EQUAL_UINT8(6, n);
+    TEST_ASSERT_EQUAL_UINT16(1319, notes[0].freq);
+    TEST_ASSERT_EQUAL_UINT16(68, notes[0].ms);
+    TEST_ASSERT_EQUAL_UINT16(0, notes[1].freq);
+    TEST_ASSERT_EQUAL_UINT16(7, notes[1].ms);
+    TEST_ASSERT_EQUAL_UINT16(2093, notes[4].freq);
+    TEST_ASSERT_EQUAL_UINT16(135, notes[4].ms);
+}
+
+void test_expand_keeps_rests_whole() {
+    AudioNote notes[AUDIO_QUEUE_LEN];
+    uint8_t n = melodyExpand(MELODY_BOOT, notes);
+
+    // c, 32p, e, 32p, g. -> 3 tones with gaps + 2 rests
+    TEST_ASSERT_EQUAL_UINT8(8, n);
+    TEST_ASSERT_EQUAL_UINT16(0, notes[2].freq);
+    TEST_ASSERT_EQUAL_UINT16(25, notes[2].ms);
+}
+
+void test_every_state_has_a_melody() {
+    AudioNote notes[AUDIO_QUEUE_LEN];
+    for (const MelodyRef& m : STATE_MELODIES) {
+        uint8_t n = melodyExpand(m, notes);
+        TEST_ASSERT_TRUE(n > 0 && n <= AUDIO_QUEUE_LEN);
+    }
+    TEST_ASSERT_EQUAL(7, sizeof(STATE_MELODIES) / sizeof(STATE_MELODIES[0]));     // PROTECTING..TRANSCENDENT
+}
+
+// ============================================================================
+// SEQUENCER
+// ============================================================================
+
+void test_no_buzzer_drops_everything() {
+    TEST_ASSERT_FALSE(audioTone(440, 100));
+    TEST_ASSERT_FALSE(audioBusy());
+}
+
+void test_plays_notes_in_order_without_blocking() {
+    audioBegin(PIN_BUZZER);
+    TEST_ASSERT_EQUAL(PIN_BUZZER, mockLedc[BUZZER_CHANNEL].pin);
+
+    AudioNote notes[] = { { 440, 100 }, { 0, 50 }, { 880, 100 } };
+    TEST_ASSERT_TRUE(audioPlay(notes, 3, PRIO_UI));
+    TEST_ASSERT_TRUE(audioBusy());
+
+    mockAdvance(1);
+    TEST_ASSERT_EQUAL_UINT32(440, freq());
+    TEST_ASSERT_EQUAL_UINT32(FULL, duty());
+
+    mockAdvance(100);
+    TEST_ASSERT_EQUAL_UINT32(0, duty());
+
+    mockAdvance(50);
+    TEST_ASSERT_EQUAL_UINT32(880, freq());
+    TEST_ASSERT_EQUAL_UINT32(FULL, duty());
+
+    mockAdvance(100);
+    TEST_ASSERT_EQUAL_UINT32(0, duty());
+    TEST_ASSERT_FALSE(audioBusy());
+}
+
+void test_priority_drops_and_interrupts() {
+    audioBegin(PIN_BUZZER);
+    TEST_ASSERT_TRUE(audioTone(660, 500, PRIO_EVENT));
+    mockAdvance(10);
+
+    TEST_ASSERT_FALSE(audioTone(440, 100, PRIO_UI));
+    mockAdvance(10);
+    TEST_ASSERT_EQUAL_UINT32(660, freq());
+
+    TEST_ASSERT_TRUE(audioTone(220, 100, PRIO_ALERT));
+    mockAdvance(1);
+    TEST_ASSERT_EQUAL_UINT32(220, freq());
+
+    mockAdvance(100);
+    TEST_ASSERT_FALSE(audioBusy());
+}
+
+void test_volume_scales_duty() {
+    audioBegin(PIN_BUZZER);
+    audioSetVolume(50);
+    audioTone(440, 100);
+    mockAdvance(1);
+    TEST_ASSERT_EQUAL_UINT32(FULL / 2, duty());
+
+    audioSetVolume(0);
+    TEST_ASSERT_FALSE(audioTone(440, 100, PRIO_ALERT));
+}
+
+void test_stop_silences_now() {
+    audioBegin(PIN_BUZZER);
+    AudioNote notes[AUDIO_QUEUE_LEN];
+    audioPlay(notes, melodyExpand(MELODY_TRANSCENDENT, notes), PRIO_EVENT);
+    mockAdvance(20);
+    TEST_ASSERT_TRUE(duty() > 0);
+
+    audioStop();
+    mockAdvance(1);
+    TEST_ASSERT_EQUAL_UINT32(0, duty());
+    TEST_ASSERT_FALSE(audioBusy());
+}
+
+void test_wait_idle_lets_the_sound_finish() {
+    audioBegin(PIN_BUZZER);
+    audioTone(440, 300);
+    audioWaitIdle(1000);
+    TEST_ASSERT_FALSE(audioBusy());
+    TEST_ASSERT_TRUE(millis() >= 300 && millis() < 320);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_expand_splits_tone_and_gap);
+    RUN_TEST(test_expand_keeps_rests_whole);
+    RUN_TEST(test_every_state_has_a_melody);
+    RUN_TEST(test_no_buzzer_drops_everything);
+    RUN_TEST(test_plays_notes_in_order_without_blocking);
+    RUN_TEST(test_priority_drops_and_interrupts);
+    RUN_TEST(test_volume_scales_duty);
+    RUN_TEST(test_stop_silences_now);
+    RUN_TEST(test_wait_idle_lets_the_sound_finish);
+    return UNITY_END();
+}
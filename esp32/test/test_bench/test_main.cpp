@@ -0,0 +1,177 @@
+/*
+ * Host benchmarks: the firmware's hot paths against the mocks, timed with
+ * the host's steady clock. Numbers are for spotting regressions between
+ * commits on the same machine, not for predicting the S3.
+ *
+ * Same runner and output as /bench on the device (bench.h), in ns:
+ *
+ *   pio test -e native -f test_bench -v | grep ^BENCH
+ */
+
+#define BENCH_MAX_ITERS 20000
+
+#include <Arduino.h>
+#include <unity.h>
+#include "bench.h"
+#include "cloud.h"
+#include "display.h"
+#include "sdconfig.h"
+#include "melody.h"
+#include "link.h"
+
+HardwareStatus hw;
+I2CTopology i2cTopology;
+Logger logger;
+MemPlacement memPlace;
+JsonArena jsonArena;
+CpuFreq cpu;
+MetricsRegistry metrics;
+
+// BENCH lines to stdout; the firmware's own Serial output stays in the mock
+struct StdoutPrint : public Print {
+    size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+};
+static StdoutPrint out;
+
+void setUp() {
+    mockReset();
+    Wire.mockReset();
+    SD.mockReset();
+    LittleFS.mockReset();
+    HTTPClient::mockReset();
+    memset(&hw, 0, sizeof(hw));
+}
+
+void tearDown() {}
+
+// ============================================================================
+// RUNNER
+// ============================================================================
+
+void test_stats_pick_ranks() {
+    uint32_t samples[100];
+    for (uint32_t i = 0; i < 100; i++) samples[i] = 100 - i;
+    BenchResult r = benchStats(samples, 100);
+    TEST_ASSERT_EQUAL_UINT32(1, r.min);
+    TEST_ASSERT_EQUAL_UINT32(51, r.median);
+    TEST_ASSERT_EQUAL_UINT32(100, r.p99);
+}
+
+void test_run_prints_one_line() {
+    int calls = 0;
+    BenchResult r = benchRun("noop", 10, [&] { calls++; });
+    TEST_ASSERT_EQUAL(11, calls);       // Plus the untimed warm-up
+    TEST_ASSERT_EQUAL_UINT16(10, r.iters);
+    TEST_ASSERT_EQUAL(0, r.heapDelta);
+    std::string line = Serial.mockTake();
+    TEST_ASSERT_EQUAL(0, line.find("BENCH noop 10 "));
+    TEST_ASSERT_TRUE(line.find(" ns 0\n") != std::string::npos);
+}
+
+// ============================================================================
+// BENCHES
+// ============================================================================
+
+void bench_soul_update() {
+    Soul soul;
+    benchRun("soul", 10000, [&] {
+        mockAdvance(1000);
+        soul.update(0.1f, 0.0f);
+    }, out);
+}
+
+void bench_render_face() {
+    Wire.mockAttach(I2C_ADDR_OLED);
+    Adafruit_SSD1306 oled(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    Display display;
+    Soul soul;
+    display.begin(&oled);
+    benchRun("face", 2000, [&] {
+        mockAdvance(33);
+        display.update();
+        display.renderFaceScreen(soul, true, true);
+    }, out);
+}
+
+void bench_cloud_sync() {
+    CloudConfig config = {};
+    strlcpy(config.cloud_url, "https://cloud.test", sizeof(config.cloud_url));
+    strlcpy(config.device_token, "apex_dev_bench", sizeof(config.device_token));
+    strlcpy(config.device_id, "device-1", sizeof(config.device_id));
+    config.configured = true;
+    CloudClient cloud;
+    cloud.init(&config);
+
+    String body;
+    benchRun("json", 10000, [&] {
+        cloud.buildSyncBody(body, 12.5f, 1.2f, 30.0f, 42, 17.5f, "FLOURISHING", "AZOTH",
+                            0.5f, 0.6f, 0.7f, FW_VERSION);
+    }, out);
+
+    // Body plus the mock transport
+    benchRun("cloud_sync", 2000, [&] {
+        HTTPClient::mockRespond(200, "{\"motd\":\"\"}");
+        cloud.sync(12.5f, 1.2f, 30.0f, 42, 17.5f, "FLOURISHING", "AZOTH",
+                   0.5f, 0.6f, 0.7f, FW_VERSION);
+        HTTPClient::mockRequests.clear();
+    }, out);
+}
+
+void bench_sd_log_chat() {
+    SD.begin();
+    sdInit();
+    benchRun("sdlog", 2000, [&] {
+        sdLogChat("AZOTH", "how are you today?", "Flourishing, thank you for asking.", 12.5f);
+    }, out);
+}
+
+void bench_melody_expand() {
+    AudioNote notes[AUDIO_QUEUE_LEN];
+    volatile uint8_t n = 0;
+    benchRun("melody_expand", 20000, [&] { n = melodyExpand(MELODY_TRANSCENDENT, notes); }, out);
+    (void)n;
+}
+
+void bench_link_open_window() {
+    SD.begin();
+    SD.mockWrite("/bench.bin", std::string(LINK_CHUNK * LINK_WINDOW, 'x'));
+    Soul soul;
+    HostLink link;
+    link.begin(&soul, nullptr, 0);
+    Serial.mockPollUs = 50;
+    link.start();
+
+    // OPEN, a full window of DATA frames (framing and CRC on every byte),
+    // then the rest of the LINK_PUMP_MS pass polling for an ACK
+    const uint8_t open[] = { 0xA5, 0x5A, LINK_OPEN, 0, 11, 0, LINK_SRC_FILE,
+                             '/', 'b', 'e', 'n', 'c', 'h', '.', 'b', 'i', 'n', 0, 0 };
+    uint8_t frame[sizeof(open)];
+    memcpy(frame, open, sizeof(open));
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 2; i < sizeof(frame) - 2; i++) {
+        crc ^= (uint16_t)frame[i] << 8;
+        for (int b = 0; b < 8; b++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    frame[sizeof(frame) - 2] = (uint8_t)crc;
+    frame[sizeof(frame) - 1] = (uint8_t)(crc >> 8);
+
+    benchRun("link_open_window", 2000, [&] {
+        Serial.mockInput(frame, sizeof(frame));
+        link.poll();
+        Serial.mockTake();
+    }, out);
+}
+
+int main() {
+    UNITY_BEGIN();
+    benchHeader(out, 0);
+    RUN_TEST(test_stats_pick_ranks);
+    RUN_TEST(test_run_prints_one_line);
+    RUN_TEST(bench_soul_update);
+    RUN_TEST(bench_render_face);
+    RUN_TEST(bench_cloud_sync);
+    RUN_TEST(bench_sd_log_chat);
+    RUN_TEST(bench_melody_expand);
+    RUN_TEST(bench_link_open_window);
+    return UNITY_END();
+}
@@ -0,0 +1,371 @@
+/*
+ * Cloud client against the mocked HTTP stack: response codes, backoff,
+ * keep-alive, TLS trust, the care queue and the offline fallback.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "cloud.h"
+#include "offline.h"
+
+HardwareStatus hw;
+I2CTopology i2cTopology;
+Logger logger;
+MemPlacement memPlace;
+JsonArena jsonArena;
+
+static CloudConfig config;
+static CloudClient* cloud;
+
+static int hookStarts, hookEnds, hookHandshakes;
+
+static void countRequests(bool starting, bool handshake) {
+    if (starting) hookStarts++;
+    else hookEnds++;
+    if (handshake) hookHandshakes++;
+}
+
+static void addTelemetry(JsonObject doc) {
+    doc.createNestedObject("power")["battery_mv"] = 3912;
+}
+
+void setUp() {
+    mockReset();
+    HTTPClient::mockReset();
+    WiFiClientSecure::mockCABundle = nullptr;
+    WiFiClientSecure::mockPeerChain = nullptr;
+    hookStarts = hookEnds = hookHandshakes = 0;
+
+    memset(&config, 0, sizeof(config));
+    strlcpy(config.cloud_url, "https://cloud.test", sizeof(config.cloud_url));
+    strlcpy(config.device_token, "apex_dev_test", sizeof(config.device_token));
+    strlcpy(config.device_id, "device-1", sizeof(config.device_id));
+    config.configured = true;
+
+    cloud = new CloudClient();
+    cloud->init(&config);
+}
+
+void tearDown() {
+    delete cloud;
+}
+
+// ============================================================================
+// REQUESTS
+// ============================================================================
+
+void test_unconfigured_client_stays_offline() {
+    config.configured = false;
+    CloudClient c;
+    c.init(&config);
+    TEST_ASSERT_FALSE(c.isInitialized());
+    TEST_ASSERT_FALSE(c.fetchStatus());
+    TEST_ASSERT_EQUAL(0, HTTPClient::mockRequests.size());
+}
+
+void test_status_parses_fields_and_sends_auth() {
+    HTTPClient::mockRespond(200,
+        "{\"tools_available\":12,\"messages_used\":3,\"messages_limit\":50,"
+        "\"tier\":\"seeker\",\"motd\":\"hello\"}");
+
+    TEST_ASSERT_TRUE(cloud->fetchStatus());
+
+    TEST_ASSERT_EQUAL(1, HTTPClient::mockRequests.size());
+    const MockHttpRequest& req = HTTPClient::mockRequests[0];
+    TEST_ASSERT_EQUAL_STRING("GET", req.method.c_str());
+    TEST_ASSERT_EQUAL_STRING("https://cloud.test" API_PREFIX "/status", req.url.c_str());
+    String auth = req.header("Authorization");
+    TEST_ASSERT_EQUAL_STRING("Bearer apex_dev_test", auth.c_str());
+
+    TEST_ASSERT_TRUE(cloud->isConnected());
+    TEST_ASSERT_EQUAL(12, cloud->status.tools_available);
+    TEST_ASSERT_EQUAL(50, cloud->status.messages_limit);
+    TEST_ASSERT_EQUAL_STRING("seeker", cloud->status.tier_name);
+    TEST_ASSERT_EQUAL_STRING("hello", cloud->status.motd);
+}
+
+void test_chat_fills_response_and_defaults() {
+    HTTPClient::mockRespond(200, "{\"response\":\"Hi there\",\"messages_used\":4}");
+
+    char text[64], expr[16];
+    float careValue = 0;
+    TEST_ASSERT_TRUE(cloud->chat("hello", 2.5f, "WARM", "AZOTH", text, sizeof(text), expr, &careValue));
+
+    TEST_ASSERT_EQUAL_STRING("Hi there", text);
+    TEST_ASSERT_EQUAL_STRING("neutral", expr);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.5f, careValue);
+    TEST_ASSERT_EQUAL(4, cloud->status.messages_used);
+
+    const String& body = HTTPClient::mockRequests[0].body;
+    TEST_ASSERT_TRUE(body.indexOf("\"message\":\"hello\"") >= 0);
+    TEST_ASSERT_TRUE(body.indexOf("\"device_id\":\"device-1\"") >= 0);
+}
+
+void test_chat_reply_too_big_fails_loudly() {
+    std::string reply = "{\"response\":\"" + std::string(CHAT_RESPONSE_CAP, 'x') + "\"}";
+    HTTPClient::mockRespond(200, reply.c_str());
+
+    char text[64] = "", expr[16];
+    float careValue = 0;
+    TEST_ASSERT_FALSE(cloud->chat("hello", 2.5f, "WARM", "AZOTH", text, sizeof(text), expr, &careValue));
+    TEST_ASSERT_EQUAL_STRING("", text);
+    TEST_ASSERT_TRUE(Serial.mockTake().find("[JSON] chat: document too small") != std::string::npos);
+    TEST_ASSERT_EQUAL(0, jsonArena.getUsed());
+}
+
+void test_sync_merges_telemetry() {
+    cloud->setTelemetryProvider(addTelemetry, JSON_OBJECT_SIZE(2));
+    HTTPClient::mockRespond(200, "{\"motd\":\"synced\"}");
+
+    TEST_ASSERT_TRUE(cloud->sync(3.0f, 1.5f, 4.0f, 42, 10.0f, "WARM", "AZOTH",
+                                 0.2f, 0.3f, 0.01f, FW_VERSION));
+
+    const String& body = HTTPClient::mockRequests[0].body;
+    TEST_ASSERT_TRUE(body.indexOf("\"interactions\":42") >= 0);
+    TEST_ASSERT_TRUE(body.indexOf("\"power\":{\"battery_mv\":3912}") >= 0);
+    TEST_ASSERT_EQUAL_STRING("synced", cloud->status.motd);
+}
+
+void test_fetch_agents() {
+    HTTPClient::mockRespond(200, "{\"agents\":[\"AZOTH\",\"ELYSIAN\",\"VAJRA\"]}");
+
+    char names[2][16];
+    int count = 0;
+    TEST_ASSERT_TRUE(cloud->fetchAgents(names, &count, 2));
+    TEST_ASSERT_EQUAL(2, count);
+    TEST_ASSERT_EQUAL_STRING("AZOTH", names[0]);
+    TEST_ASSERT_EQUAL_STRING("ELYSIAN", names[1]);
+}
+
+// ============================================================================
+// ERRORS AND BACKOFF
+// ============================================================================
+
+void test_401_stops_all_requests() {
+    HTTPClient::mockRespond(401);
+    TEST_ASSERT_FALSE(cloud->fetchStatus());
+    TEST_ASSERT_FALSE(cloud->isTokenValid());
+    TEST_ASSERT_FALSE(cloud->shouldAttempt());
+
+    mockAdvance(3600000);
+    TEST_ASSERT_FALSE(cloud->care("love", 1.0f, 2.0f));
+    TEST_ASSERT_EQUAL(1, HTTPClient::mockRequests.size());
+}
+
+void test_402_blocks_chat_only() {
+    HTTPClient::mockRespond(402);
+    char text[32], expr[16];
+    float careValue;
+    TEST_ASSERT_FALSE(cloud->chat("hi", 1, "TENDER", "AZOTH", text, sizeof(text), expr, &careValue));
+    TEST_ASSERT_FALSE(cloud->isBillingOk());
+
+    TEST_ASSERT_FALSE(cloud->chat("hi", 1, "TENDER", "AZOTH", text, sizeof(text), expr, &careValue));
+    TEST_ASSERT_EQUAL(1, HTTPClient::mockRequests.size());
+
+    HTTPClient::mockRespond(200);
+    TEST_ASSERT_TRUE(cloud->care("poke", 0.5f, 1.0f));
+}
+
+void test_backoff_doubles_to_the_cap() {
+    const unsigned long expected[] = { 5000, 10000, 20000, 40000, 60000, 60000 };
+    for (unsigned long wait : expected) {
+        TEST_ASSERT_TRUE(cloud->shouldAttempt());
+        HTTPClient::mockRespond(503);
+        TEST_ASSERT_FALSE(cloud->fetchStatus());
+        TEST_ASSERT_EQUAL_UINT32(wait, cloud->status.backoff_ms);
+
+        mockAdvance(wait - 1);
+        TEST_ASSERT_FALSE(cloud->shouldAttempt());
+        mockAdvance(1);
+    }
+
+    HTTPClient::mockRespond(200, "{}");
+    TEST_ASSERT_TRUE(cloud->fetchStatus());
+    TEST_ASSERT_EQUAL_UINT32(0, cloud->status.backoff_ms);
+    TEST_ASSERT_EQUAL(0, cloud->status.consecutive_failures);
+}
+
+void test_network_error_marks_disconnected() {
+    HTTPClient::mockRespond(200, "{}");
+    cloud->fetchStatus();
+    TEST_ASSERT_TRUE(cloud->isConnected());
+
+    mockAdvance(1000);
+    TEST_ASSERT_FALSE(cloud->fetchStatus());    // Nothing queued: refused
+    TEST_ASSERT_FALSE(cloud->isConnected());
+    TEST_ASSERT_EQUAL_UINT32(API_BACKOFF_BASE_MS, cloud->status.backoff_ms);
+}
+
+// ============================================================================
+// TLS TRUST
+// ============================================================================
+
+// Leaf signed by an intermediate; only the keys matter to the pin check
+static unsigned char leafKey[] = "leaf public key";
+static unsigned char interKey[] = "intermediate public key";
+static mbedtls_x509_crt inter = { {}, { 0x30, sizeof(interKey), interKey }, nullptr };
+static mbedtls_x509_crt leaf = { {}, { 0x30, sizeof(leafKey), leafKey }, &inter };
+
+void test_init_uses_der_bundle() {
+    TEST_ASSERT_EQUAL_PTR(CLOUD_CA_BUNDLE, WiFiClientSecure::mockCABundle);
+    TEST_ASSERT_EQUAL(CLOUD_CA_COUNT, CLOUD_CA_BUNDLE[0] << 8 | CLOUD_CA_BUNDLE[1]);
+}
+
+void test_pinned_intermediate_lets_request_through() {
+    uint8_t pins[2][CLOUD_PIN_LEN] = {};
+    mbedtls_sha256_ret(interKey, sizeof(interKey), pins[1], 0);
+    cloud->setPins(pins, 2);
+    WiFiClientSecure::mockPeerChain = &leaf;
+
+    HTTPClient::mockRespond(200);
+    HTTPClient::mockRespond(200);
+    TEST_ASSERT_TRUE(cloud->care("love", 1.0f, 2.0f));
+    TEST_ASSERT_TRUE(cloud->care("love", 1.0f, 2.0f));      // Kept alive: checked once
+    TEST_ASSERT_EQUAL(2, HTTPClient::mockRequests.size());
+}
+
+void test_unpinned_chain_sends_nothing() {
+    uint8_t pins[1][CLOUD_PIN_LEN];
+    mbedtls_sha256_ret(leafKey, sizeof(leafKey), pins[0], 0);     // The leaf doesn't count
+    cloud->setPins(pins, 1);
+    WiFiClientSecure::mockPeerChain = &leaf;
+    MetricsRegistry reg;
+    cloud->registerMetrics(reg);
+
+    HTTPClient::mockRespond(200);
+    TEST_ASSERT_FALSE(cloud->fetchStatus());
+    TEST_ASSERT_EQUAL(0, HTTPClient::mockRequests.size());
+    TEST_ASSERT_FALSE(cloud->isConnected());
+    TEST_ASSERT_TRUE(Serial.mockTake().find("no pinned intermediate") != std::string::npos);
+
+    reg.writePrometheus(Serial);
+    TEST_ASSERT_TRUE(Serial.mockTake().find("apex_cloud_pin_rejects_total 1\n") != std::string::npos);
+}
+
+// ============================================================================
+// KEEP-ALIVE AND CARE QUEUE
+// ============================================================================
+
+void test_keep_alive_handshakes_once() {
+    cloud->setRequestHook(countRequests);
+    for (int i = 0; i < 3; i++) HTTPClient::mockRespond(200);
+
+    cloud->care("love", 1.0f, 2.0f);
+    cloud->care("love", 1.0f, 2.0f);
+    cloud->care("poke", 0.5f, 2.0f);
+
+    TEST_ASSERT_EQUAL(3, hookStarts);
+    TEST_ASSERT_EQUAL(3, hookEnds);
+    TEST_ASSERT_EQUAL(1, hookHandshakes);
+    TEST_ASSERT_TRUE(HTTPClient::mockRequests[0].newConnection);
+    TEST_ASSERT_FALSE(HTTPClient::mockRequests[2].newConnection);
+
+    cloud->endSession();
+    HTTPClient::mockRespond(200);
+    cloud->care("love", 1.0f, 2.0f);
+    TEST_ASSERT_EQUAL(2, hookHandshakes);
+}
+
+void test_metrics_count_results_and_handshakes() {
+    MetricsRegistry reg;
+    cloud->registerMetrics(reg);
+    HTTPClient::mockRespond(200);
+    HTTPClient::mockRespond(500);
+    HTTPClient::mockRespond(-1);
+    cloud->care("love", 1.0f, 2.0f);
+    cloud->care("love", 1.0f, 2.0f);
+    mockAdvance(API_BACKOFF_MAX_MS);
+    cloud->care("love", 1.0f, 2.0f);
+
+    Serial.mockTake();
+    reg.writePrometheus(Serial);
+    std::string out = Serial.mockTake();
+    TEST_ASSERT_TRUE(out.find("apex_cloud_requests_total{result=\"ok\"} 1\n") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("apex_cloud_requests_total{result=\"server\"} 1\n") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("apex_cloud_requests_total{result=\"network\"} 1\n") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("apex_cloud_tls_handshakes_total 1\n") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("apex_cloud_request_ms_count 3\n") != std::string::npos);
+}
+
+void test_care_queue_drops_oldest() {
+    CareQueue q;
+    memset(&q, 0, sizeof(q));
+    for (int i = 0; i < CARE_QUEUE_MAX + 3; i++) careQueuePush(&q, "love", 1.0f, (float)i);
+
+    TEST_ASSERT_EQUAL(CARE_QUEUE_MAX, q.count);
+    TEST_ASSERT_EQUAL(3, q.dropped);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 3.0f, q.events[0].E);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, CARE_QUEUE_MAX + 2.0f, q.events[q.count - 1].E);
+}
+
+void test_flush_care_keeps_unsent_events() {
+    CareQueue q;
+    memset(&q, 0, sizeof(q));
+    careQueuePush(&q, "love", 1.0f, 1.0f);
+    careQueuePush(&q, "poke", 0.5f, 2.0f);
+    careQueuePush(&q, "love", 1.0f, 3.0f);
+
+    HTTPClient::mockRespond(200);
+    HTTPClient::mockRespond(500);
+    TEST_ASSERT_EQUAL(1, cloud->flushCare(&q));
+
+    TEST_ASSERT_EQUAL(2, q.count);
+    TEST_ASSERT_EQUAL_STRING("poke", q.events[0].care_type);
+
+    mockAdvance(API_BACKOFF_BASE_MS);
+    HTTPClient::mockRespond(200);
+    HTTPClient::mockRespond(200);
+    TEST_ASSERT_EQUAL(2, cloud->flushCare(&q));
+    TEST_ASSERT_EQUAL(0, q.count);
+}
+
+// ============================================================================
+// OFFLINE FALLBACK
+// ============================================================================
+
+void test_offline_after_two_failures() {
+    OfflineMode offline;
+    offline.connectionFailed();
+    TEST_ASSERT_FALSE(offline.getOffline());
+    offline.connectionFailed();
+    TEST_ASSERT_TRUE(offline.getOffline());
+
+    offline.connectionSuccess();
+    TEST_ASSERT_FALSE(offline.getOffline());
+    offline.connectionFailed();
+    TEST_ASSERT_FALSE(offline.getOffline());
+}
+
+void test_offline_responses_come_from_the_state_pool() {
+    OfflineMode offline;
+    for (int i = 0; i < 50; i++) {
+        const char* r = offline.getResponse(STATE_PROTECTING);
+        bool found = false;
+        for (int j = 0; j < RESP_PROTECTING_COUNT; j++) found |= r == RESP_PROTECTING[j];
+        TEST_ASSERT_TRUE(found);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_unconfigured_client_stays_offline);
+    RUN_TEST(test_status_parses_fields_and_sends_auth);
+    RUN_TEST(test_chat_fills_response_and_defaults);
+    RUN_TEST(test_chat_reply_too_big_fails_loudly);
+    RUN_TEST(test_sync_merges_telemetry);
+    RUN_TEST(test_fetch_agents);
+    RUN_TEST(test_401_stops_all_requests);
+    RUN_TEST(test_402_blocks_chat_only);
+    RUN_TEST(test_backoff_doubles_to_the_cap);
+    RUN_TEST(test_network_error_marks_disconnected);
+    RUN_TEST(test_init_uses_der_bundle);
+    RUN_TEST(test_pinned_intermediate_lets_request_through);
+    RUN_TEST(test_unpinned_chain_sends_nothing);
+    RUN_TEST(test_keep_alive_handshakes_once);
+    RUN_TEST(test_metrics_count_results_and_handshakes);
+    RUN_TEST(test_care_queue_drops_oldest);
+    RUN_TEST(test_flush_care_keeps_unsent_events);
+    RUN_TEST(test_offline_after_two_failures);
+    RUN_TEST(test_offline_responses_come_from_the_state_pool);
+    return UNITY_END();
+}
@@ -0,0 +1,201 @@
+/*
+ * Display: init against the I2C bus, face and status rendering into the
+ * mock framebuffer, panel power and contrast commands, message expiry.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "cloud.h"
+#include "display.h"
+
+HardwareStatus hw;
+I2CTopology i2cTopology;
+CpuFreq cpu;
+
+static Adafruit_SSD1306* oled;
+static Display* display;
+static Soul* soul;
+
+static std::vector<uint8_t> frame() {
+    return std::vector<uint8_t>(oled->getBuffer(), oled->getBuffer() + SCREEN_WIDTH * SCREEN_HEIGHT / 8);
+}
+
+// Last contrast value sent to the panel
+static int lastContrast() {
+    const std::vector<uint8_t>& c = oled->mockCommands;
+    for (size_t i = c.size(); i >= 2; i--) {
+        if (c[i - 2] == SSD1306_SETCONTRAST) return c[i - 1];
+    }
+    return -1;
+}
+
+static bool sent(uint8_t command) {
+    const std::vector<uint8_t>& c = oled->mockCommands;
+    return std::find(c.begin(), c.end(), command) != c.end();
+}
+
+void setUp() {
+    mockReset();
+    Wire.mockReset();
+    memset(&hw, 0, sizeof(hw));
+    Wire.mockAttach(I2C_ADDR_OLED);
+    oled = new Adafruit_SSD1306(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, -1);
+    display = new Display();
+    soul = new Soul();
+}
+
+void tearDown() {
+    delete soul;
+    delete display;
+    delete oled;
+}
+
+// ============================================================================
+// INIT
+// ============================================================================
+
+void test_begin_fails_without_panel() {
+    Wire.mockDetach(I2C_ADDR_OLED);
+    TEST_ASSERT_FALSE(display->begin(oled));
+    TEST_ASSERT_FALSE(display->isReady());
+
+    // Rendering before init is a no-op
+    display->renderFaceScreen(*soul, false, false);
+    TEST_ASSERT_EQUAL_UINT32(0, oled->mockFrames);
+}
+
+void test_begin_sets_normal_contrast() {
+    TEST_ASSERT_TRUE(display->begin(oled));
+    TEST_ASSERT_TRUE(display->isLit());
+    TEST_ASSERT_EQUAL(CONTRAST_NORMAL, lastContrast());
+}
+
+// ============================================================================
+// RENDERING
+// ============================================================================
+
+void test_face_screen_draws_and_pushes() {
+    display->begin(oled);
+    display->renderFaceScreen(*soul, true, false);
+    TEST_ASSERT_EQUAL_UINT32(1, oled->mockFrames);
+    TEST_ASSERT_GREATER_THAN(100, oled->mockLitPixels());
+}
+
+void test_expressions_draw_differently() {
+    display->begin(oled);
+    display->setExpression(EXPR_HAPPY);
+    display->renderFaceScreen(*soul, true, true);
+    std::vector<uint8_t> happy = frame();
+
+    display->setExpression(EXPR_SAD);
+    display->renderFaceScreen(*soul, true, true);
+    TEST_ASSERT_TRUE(happy != frame());
+}
+
+void test_state_to_expression() {
+    TEST_ASSERT_EQUAL(EXPR_SLEEPING, display->stateToExpression(STATE_PROTECTING));
+    TEST_ASSERT_EQUAL(EXPR_HAPPY, display->stateToExpression(STATE_FLOURISHING));
+    TEST_ASSERT_EQUAL(EXPR_LOVE, display->stateToExpression(STATE_TRANSCENDENT));
+}
+
+void test_static_elements_shift_against_burn_in() {
+    display->begin(oled);
+    display->renderFaceScreen(*soul, false, false);
+    std::vector<uint8_t> first = frame();
+
+    mockAdvance(PIXEL_SHIFT_MS);
+    display->renderFaceScreen(*soul, false, false);
+    TEST_ASSERT_TRUE(first != frame());
+}
+
+void test_message_replaces_status_line_then_expires() {
+    display->begin(oled);
+    display->setLookAround(false);      // Keep the eyes still between frames
+    display->renderFaceScreen(*soul, false, false);
+    std::vector<uint8_t> plain = frame();
+
+    display->showMessage("Hello from the Village", 3000);
+    display->renderFaceScreen(*soul, false, false);
+    TEST_ASSERT_TRUE(plain != frame());
+    TEST_ASSERT_TRUE(display->isAnimating());
+
+    mockAdvance(3001);
+    display->update();
+    display->renderFaceScreen(*soul, false, false);
+    TEST_ASSERT_TRUE(plain == frame());
+}
+
+void test_status_screen_renders() {
+    display->begin(oled);
+    display->renderStatusScreen(*soul, true, true, 12, 3, 50, "seeker", "bat 87%");
+    TEST_ASSERT_EQUAL_UINT32(1, oled->mockFrames);
+    TEST_ASSERT_GREATER_THAN(100, oled->mockLitPixels());
+}
+
+// ============================================================================
+// PANEL POWER
+// ============================================================================
+
+void test_panel_off_dim_on() {
+    display->begin(oled);
+
+    display->setPanel(PANEL_DIM);
+    TEST_ASSERT_EQUAL(CONTRAST_DIM, lastContrast());
+    TEST_ASSERT_TRUE(display->isLit());
+
+    display->setPanel(PANEL_OFF);
+    TEST_ASSERT_TRUE(sent(SSD1306_DISPLAYOFF));
+    TEST_ASSERT_FALSE(display->isLit());
+    TEST_ASSERT_EQUAL_UINT32(SLEEP_TIMEOUT_MS, display->msUntilNextChange());
+
+    oled->mockCommands.clear();
+    display->setPanel(PANEL_ON);
+    TEST_ASSERT_TRUE(sent(SSD1306_DISPLAYON));
+    TEST_ASSERT_EQUAL(CONTRAST_NORMAL, lastContrast());
+
+    // Same state again sends nothing
+    oled->mockCommands.clear();
+    display->setPanel(PANEL_ON);
+    TEST_ASSERT_EQUAL(0, oled->mockCommands.size());
+}
+
+void test_brightness_clamps_and_waits_for_panel_on() {
+    display->begin(oled);
+    display->setBrightness(7);
+    TEST_ASSERT_EQUAL_UINT8(BRIGHT_HIGH, display->getBrightness());
+    TEST_ASSERT_EQUAL(CONTRAST_HIGH, lastContrast());
+
+    display->setPanel(PANEL_DIM);
+    display->setBrightness(BRIGHT_LOW);
+    TEST_ASSERT_EQUAL(CONTRAST_DIM, lastContrast());
+
+    display->setPanel(PANEL_ON);
+    TEST_ASSERT_EQUAL(CONTRAST_LOW, lastContrast());
+}
+
+void test_idle_waits_for_next_blink() {
+    display->begin(oled);
+    unsigned long wait = display->msUntilNextChange();
+    TEST_ASSERT_TRUE(wait >= BLINK_MIN_MS && wait <= BLINK_MAX_MS);
+
+    mockAdvance(wait + 1);
+    display->update();
+    TEST_ASSERT_TRUE(display->isAnimating());
+    TEST_ASSERT_EQUAL_UINT32(0, display->msUntilNextChange());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_begin_fails_without_panel);
+    RUN_TEST(test_begin_sets_normal_contrast);
+    RUN_TEST(test_face_screen_draws_and_pushes);
+    RUN_TEST(test_expressions_draw_differently);
+    RUN_TEST(test_state_to_expression);
+    RUN_TEST(test_static_elements_shift_against_burn_in);
+    RUN_TEST(test_message_replaces_status_line_then_expires);
+    RUN_TEST(test_status_screen_renders);
+    RUN_TEST(test_panel_off_dim_on);
+    RUN_TEST(test_brightness_clamps_and_waits_for_panel_on);
+    RUN_TEST(test_idle_waits_for_next_blink);
+    return UNITY_END();
+}
@@ -0,0 +1,145 @@
+/*
+ * Heap telemetry: the heap numbers come from the ESP mock, moved by hand
+ * to stand in for allocations, fragmentation and a day of uptime.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "heapmon.h"
+
+HeapMonitor heapMon;
+
+void setUp() {
+    mockReset();
+    heapMon = HeapMonitor();
+    heapMon.begin();
+}
+
+void tearDown() {}
+
+// ============================================================================
+// SAMPLING
+// ============================================================================
+
+void test_sample_reads_regions() {
+    const HeapStats& s = heapMon.stats(HEAP_INTERNAL);
+    TEST_ASSERT_EQUAL_UINT32(240 * 1024, s.free);
+    TEST_ASSERT_EQUAL_UINT32(200 * 1024, s.minFree);
+    TEST_ASSERT_EQUAL_UINT32(110 * 1024, s.largest);
+    TEST_ASSERT_EQUAL_UINT8(55, heapMon.fragmentation(HEAP_INTERNAL));
+
+    // No PSRAM on the mock: zeroed, not garbage
+    TEST_ASSERT_EQUAL_UINT32(0, heapMon.stats(HEAP_PSRAM).free);
+    TEST_ASSERT_EQUAL_UINT8(0, heapMon.fragmentation(HEAP_PSRAM));
+}
+
+void test_update_waits_for_interval() {
+    ESP.mockFreeHeap = 100 * 1024;
+    mockAdvance(HEAP_SAMPLE_MS - 1);
+    heapMon.update();
+    TEST_ASSERT_EQUAL_UINT32(240 * 1024, heapMon.stats(HEAP_INTERNAL).free);
+
+    mockAdvance(1);
+    heapMon.update();
+    TEST_ASSERT_EQUAL_UINT32(100 * 1024, heapMon.stats(HEAP_INTERNAL).free);
+}
+
+void test_trend_keeps_hourly_lows_for_a_day() {
+    ESP.mockMaxAllocHeap = 90 * 1024;
+    heapMon.sample();
+    ESP.mockMaxAllocHeap = 100 * 1024;
+    heapMon.sample();
+    TEST_ASSERT_EQUAL_UINT32(90 * 1024, heapMon.trendLow());
+
+    // The dip ages out once a full day of newer hours is kept
+    for (int h = 0; h < HEAP_TREND_SLOTS - 1; h++) {
+        mockAdvance(HEAP_TREND_MS);
+        heapMon.sample();
+    }
+    TEST_ASSERT_EQUAL_UINT32(90 * 1024, heapMon.trendLow());
+    mockAdvance(HEAP_TREND_MS);
+    heapMon.sample();
+    TEST_ASSERT_EQUAL_UINT32(100 * 1024, heapMon.trendLow());
+}
+
+// ============================================================================
+// TLS
+// ============================================================================
+
+void test_tls_fits_with_room() {
+    TEST_ASSERT_TRUE(heapMon.checkTls());
+    TEST_ASSERT_EQUAL_UINT32(0, heapMon.getTlsWarnings());
+}
+
+void test_fragmented_heap_warns_before_tls() {
+    ESP.mockMaxAllocHeap = 12 * 1024;      // Plenty free, nothing contiguous
+    Serial.mockTake();
+    TEST_ASSERT_FALSE(heapMon.checkTls());
+    TEST_ASSERT_EQUAL_UINT32(1, heapMon.getTlsWarnings());
+    TEST_ASSERT_TRUE(Serial.mockTake().find("TLS handshake may fail") != std::string::npos);
+
+    char line[22];
+    heapMon.formatLine(line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("Heap 240k/12k f95% !", line);
+}
+
+void test_low_free_warns_before_tls() {
+    ESP.mockFreeHeap = 40 * 1024;
+    ESP.mockMaxAllocHeap = 32 * 1024;
+    TEST_ASSERT_FALSE(heapMon.checkTls());
+}
+
+// ============================================================================
+// TAGS
+// ============================================================================
+
+void test_scope_books_held_and_peak() {
+    {
+        HeapScope scope(HEAP_TAG_CLOUD);
+        ESP.mockMinFreeHeap = 190 * 1024;   // Dipped 50k below where it started
+        ESP.mockFreeHeap = 239 * 1024;      // and kept 1k
+    }
+    const HeapTagStats& t = heapMon.tagStats(HEAP_TAG_CLOUD);
+    TEST_ASSERT_EQUAL_UINT32(1, t.calls);
+    TEST_ASSERT_EQUAL_INT32(1024, t.held);
+    TEST_ASSERT_EQUAL_UINT32(50 * 1024, t.peak);
+
+    // Gives it back; no new low, so the peak stands
+    {
+        HeapScope scope(HEAP_TAG_CLOUD);
+        ESP.mockFreeHeap = 240 * 1024;
+    }
+    TEST_ASSERT_EQUAL_UINT32(2, t.calls);
+    TEST_ASSERT_EQUAL_INT32(0, t.held);
+    TEST_ASSERT_EQUAL_UINT32(50 * 1024, t.peak);
+    TEST_ASSERT_EQUAL_UINT32(0, heapMon.tagStats(HEAP_TAG_DISPLAY).calls);
+}
+
+void test_json_for_sync() {
+    {
+        HeapScope scope(HEAP_TAG_STORAGE);
+        ESP.mockFreeHeap -= 512;
+    }
+    StaticJsonDocument<512> doc;
+    heapMon.toJson(doc.to<JsonObject>());
+    String body;
+    serializeJson(doc, body);
+    TEST_ASSERT_TRUE(body.indexOf("\"free\":245760") >= 0);
+    TEST_ASSERT_TRUE(body.indexOf("\"frag_pct\":55") >= 0);
+    TEST_ASSERT_TRUE(body.indexOf("\"largest_24h\":112640") >= 0);
+    TEST_ASSERT_TRUE(body.indexOf("\"storage\":512") >= 0);
+    TEST_ASSERT_TRUE(body.indexOf("psram") < 0);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_sample_reads_regions);
+    RUN_TEST(test_update_waits_for_interval);
+    RUN_TEST(test_trend_keeps_hourly_lows_for_a_day);
+    RUN_TEST(test_tls_fits_with_room);
+    RUN_TEST(test_fragmented_heap_warns_before_tls);
+    RUN_TEST(test_low_free_warns_before_tls);
+    RUN_TEST(test_scope_books_held_and_peak);
+    RUN_TEST(test_json_for_sync);
+    return UNITY_END();
+}
@@ -0,0 +1,326 @@
+/*
+ * Button input: edges come in through the mocked GPIO interrupt, time is
+ * the virtual clock, so every gesture is checked to the millisecond,
+ * including presses made while the loop was stalled.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "input.h"
+
+static ButtonInput* input;
+static int filtered;
+
+static const uint8_t PIN[BTN_COUNT] = { PIN_BTN_A, PIN_BTN_B };
+
+static void press(Button b) { mockPinSet(PIN[b], LOW); }
+static void release(Button b) { mockPinSet(PIN[b], HIGH); }
+
+// Press, hold, release (the debounce settles on the next update)
+static void tap(Button b, uint32_t holdMs = 100) {
+    press(b);
+    mockAdvance(holdMs);
+    release(b);
+}
+
+static void settle() {
+    mockAdvance(DEBOUNCE_MS + 1);
+    input->update();
+}
+
+static bool swallowA(Button b) {
+    filtered++;
+    return b == BTN_A;
+}
+
+static void expectEvent(Gesture g, Button b, uint32_t at) {
+    InputEvent ev;
+    TEST_ASSERT_TRUE(input->poll(ev));
+    TEST_ASSERT_EQUAL(g, ev.gesture);
+    TEST_ASSERT_EQUAL(b, ev.button);
+    TEST_ASSERT_EQUAL_UINT32(at, ev.at);
+}
+
+static void expectNoEvent() {
+    InputEvent ev;
+    TEST_ASSERT_FALSE(input->poll(ev));
+}
+
+void setUp() {
+    mockReset();
+    inputRing = {};
+    filtered = 0;
+    pinMode(PIN_BTN_A, INPUT_PULLUP);
+    pinMode(PIN_BTN_B, INPUT_PULLUP);
+    mockAdvance(1000);
+    input = new ButtonInput();
+    input->begin();
+}
+
+void tearDown() {
+    delete input;
+}
+
+// ============================================================================
+// SINGLE BUTTON
+// ============================================================================
+
+void test_short_press() {
+    tap(BTN_A);
+    settle();
+    expectEvent(GESTURE_SHORT, BTN_A, 1100);
+    expectNoEvent();
+    TEST_ASSERT_FALSE(input->busy());
+}
+
+void test_contact_bounce_is_one_press() {
+    for (int i = 0; i < 4; i++) {
+        press(BTN_B);
+        mockAdvance(3);
+        release(BTN_B);
+        mockAdvance(2);
+    }
+    press(BTN_B);
+    mockAdvance(200);
+    release(BTN_B);
+    settle();
+
+    expectEvent(GESTURE_SHORT, BTN_B, 1220);
+    expectNoEvent();
+}
+
+void test_long_fires_while_held() {
+    press(BTN_A);
+    mockAdvance(LONG_PRESS_MS - 1);
+    input->update();
+    expectNoEvent();
+    TEST_ASSERT_TRUE(input->busy());
+
+    mockAdvance(1);
+    input->update();
+    expectEvent(GESTURE_LONG, BTN_A, 1000 + LONG_PRESS_MS);
+
+    mockAdvance(2000);
+    release(BTN_A);
+    settle();
+    expectNoEvent();
+}
+
+void test_presses_during_a_stall_keep_their_timing() {
+    // The loop is stuck (TLS handshake) while the user taps, then holds
+    tap(BTN_A, 120);
+    mockAdvance(400);
+    tap(BTN_B, LONG_PRESS_MS + 200);
+    mockAdvance(3000);
+
+    input->update();
+    expectEvent(GESTURE_SHORT, BTN_A, 1120);
+    expectEvent(GESTURE_LONG, BTN_B, 1520 + LONG_PRESS_MS);
+    expectNoEvent();
+}
+
+// ============================================================================
+// DOUBLE TAP
+// ============================================================================
+
+void test_double_tap() {
+    input->setDoubleTap(BTN_B, true);
+    tap(BTN_B);
+    mockAdvance(DOUBLE_TAP_MS - 100);
+    tap(BTN_B);
+    settle();
+    mockAdvance(DOUBLE_TAP_MS + 1);
+    input->update();
+
+    expectEvent(GESTURE_DOUBLE, BTN_B, 1100 + DOUBLE_TAP_MS);
+    expectNoEvent();
+}
+
+void test_single_tap_waits_out_the_double_window() {
+    input->setDoubleTap(BTN_B, true);
+    tap(BTN_B);
+    settle();
+    expectNoEvent();
+    TEST_ASSERT_TRUE(input->busy());
+
+    mockAdvance(DOUBLE_TAP_MS);
+    input->update();
+    expectEvent(GESTURE_SHORT, BTN_B, 1100);
+}
+
+// ============================================================================
+// CHORDS
+// ============================================================================
+
+void test_chord_on_release() {
+    press(BTN_A);
+    mockAdvance(30);
+    press(BTN_B);
+    mockAdvance(CHORD_MS + 100);
+    input->update();
+    TEST_ASSERT_TRUE(input->chordHeldMs() >= CHORD_MS);
+
+    release(BTN_A);
+    mockAdvance(20);
+    release(BTN_B);
+    settle();
+
+    expectEvent(GESTURE_CHORD, BTN_A, 1030 + CHORD_MS + 100 + 20);
+    expectNoEvent();
+}
+
+void test_chord_led_by_b_in_one_drain() {
+    // Buttons settle oldest edge first, not A before B
+    press(BTN_B);
+    mockAdvance(20);
+    press(BTN_A);
+    mockAdvance(CHORD_MS + 100);
+    input->update();
+    expectNoEvent();
+
+    release(BTN_B);
+    mockAdvance(20);
+    release(BTN_A);
+    settle();
+
+    expectEvent(GESTURE_CHORD, BTN_A, 1020 + CHORD_MS + 100 + 20);
+    expectNoEvent();
+}
+
+void test_chord_led_by_b_within_one_frame() {
+    press(BTN_B);
+    mockAdvance(10);
+    press(BTN_A);
+    mockAdvance(6);
+    for (int frame = 0; frame < 75; frame++) {
+        input->update();
+        mockAdvance(16);
+    }
+    expectNoEvent();
+
+    release(BTN_A);
+    mockAdvance(5);
+    release(BTN_B);
+    for (int frame = 0; frame < 5; frame++) {
+        mockAdvance(16);
+        input->update();
+    }
+
+    expectEvent(GESTURE_CHORD, BTN_A, 1016 + 75 * 16 + 5);
+    expectNoEvent();
+}
+
+void test_short_chord_is_nothing() {
+    press(BTN_A);
+    press(BTN_B);
+    mockAdvance(200);
+    release(BTN_A);
+    release(BTN_B);
+    settle();
+    expectNoEvent();
+}
+
+void test_factory_reset_while_held() {
+    press(BTN_A);
+    press(BTN_B);
+    mockAdvance(FACTORY_RESET_MS);
+    input->update();
+    expectEvent(GESTURE_FACTORY_RESET, BTN_A, 1000 + FACTORY_RESET_MS);
+
+    // No chord on top of the reset
+    release(BTN_A);
+    release(BTN_B);
+    settle();
+    expectNoEvent();
+}
+
+// ============================================================================
+// FILTER, WAKE AND OVERFLOW
+// ============================================================================
+
+void test_press_filter_swallows() {
+    input->setPressFilter(swallowA);
+    tap(BTN_A);
+    settle();
+    expectNoEvent();
+
+    tap(BTN_B);
+    settle();
+    expectEvent(GESTURE_SHORT, BTN_B, 1251);
+    TEST_ASSERT_EQUAL(2, filtered);
+}
+
+void test_button_held_at_begin_is_swallowed() {
+    delete input;
+    press(BTN_A);
+    input = new ButtonInput();
+    input->begin();
+
+    mockAdvance(LONG_PRESS_MS * 2);
+    release(BTN_A);
+    settle();
+    expectNoEvent();
+}
+
+void test_ring_overflow_is_counted() {
+    for (int i = 0; i < INPUT_RING_LEN; i++) {
+        press(BTN_A);
+        mockAdvance(1);
+        release(BTN_A);
+        mockAdvance(1);
+    }
+    // Once full, each lost press also drops its release as a repeat
+    TEST_ASSERT_EQUAL(INPUT_RING_LEN / 2, input->overflows());
+    TEST_ASSERT_TRUE(input->busy());
+
+    settle();
+    TEST_ASSERT_FALSE(input->busy());
+    TEST_ASSERT_EQUAL(INPUT_RING_LEN / 2, input->overflows());
+}
+
+void test_ring_overflow_resyncs_a_lost_release() {
+    press(BTN_A);
+    settle();
+    // Fill the ring so it ends on a press, then lose the release
+    for (int i = 0; i < INPUT_RING_LEN / 2; i++) {
+        release(BTN_A);
+        mockAdvance(1);
+        press(BTN_A);
+        mockAdvance(1);
+    }
+    release(BTN_A);
+    TEST_ASSERT_EQUAL(1, input->overflows());
+
+    settle();   // Drains, resamples: the release is pushed now
+    settle();   // and debounced here
+    TEST_ASSERT_FALSE(input->busy());
+
+    // And the next press is seen, not dropped as a repeat
+    InputEvent ev;
+    while (input->poll(ev)) {}
+    tap(BTN_A);
+    settle();
+    TEST_ASSERT_TRUE(input->poll(ev));
+    TEST_ASSERT_EQUAL(BTN_A, ev.button);
+    TEST_ASSERT_EQUAL(GESTURE_SHORT, ev.gesture);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_short_press);
+    RUN_TEST(test_contact_bounce_is_one_press);
+    RUN_TEST(test_long_fires_while_held);
+    RUN_TEST(test_presses_during_a_stall_keep_their_timing);
+    RUN_TEST(test_double_tap);
+    RUN_TEST(test_single_tap_waits_out_the_double_window);
+    RUN_TEST(test_chord_on_release);
+    RUN_TEST(test_chord_led_by_b_in_one_drain);
+    RUN_TEST(test_chord_led_by_b_within_one_frame);
+    RUN_TEST(test_short_chord_is_nothing);
+    RUN_TEST(test_factory_reset_while_held);
+    RUN_TEST(test_press_filter_swallows);
+    RUN_TEST(test_button_held_at_begin_is_swallowed);
+    RUN_TEST(test_ring_overflow_is_counted);
+    RUN_TEST(test_ring_overflow_resyncs_a_lost_release);
+    return UNITY_END();
+}
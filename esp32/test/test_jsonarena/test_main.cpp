@@ -0,0 +1,145 @@
+/*
+ * JSON arena: bump allocation and rewind, documents drawing on it,
+ * schema capacities, overflow reporting, and where the pool is placed.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "jsonarena.h"
+
+Logger logger;
+MemPlacement memPlace;
+JsonArena jsonArena;
+
+static JsonArena* arena;
+
+static constexpr JsonField PAIR[] = { { "name", 8 }, { "count", 0 } };
+
+void setUp() {
+    mockReset();
+    arena = new JsonArena();
+}
+
+void tearDown() {
+    delete arena;
+    jsonArena.rewind(0, JSON_ARENA_NONE);
+}
+
+// ============================================================================
+// ALLOCATION
+// ============================================================================
+
+void test_latest_allocation_pops() {
+    void* a = arena->allocate(100);
+    uint16_t afterA = arena->getUsed();
+    void* b = arena->allocate(50);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_TRUE((uint8_t*)b >= (uint8_t*)a + 100);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)b % 4);
+
+    arena->deallocate(b);
+    TEST_ASSERT_EQUAL(afterA, arena->getUsed());
+    arena->deallocate(a);
+    TEST_ASSERT_EQUAL(0, arena->getUsed());
+    TEST_ASSERT_TRUE(arena->getPeak() >= 150);
+}
+
+void test_out_of_order_release_waits_for_scope() {
+    uint16_t used = arena->mark(), top = arena->topMark();
+    void* a = arena->allocate(100);
+    arena->allocate(50);
+    arena->deallocate(a);               // Not the latest: stays until rewind
+    TEST_ASSERT_TRUE(arena->getUsed() >= 150);
+
+    arena->rewind(used, top);
+    TEST_ASSERT_EQUAL(0, arena->getUsed());
+    TEST_ASSERT_NOT_NULL(arena->allocate(JSON_ARENA_SIZE - 8));
+}
+
+void test_exhausted_arena_returns_null_and_counts() {
+    TEST_ASSERT_NULL(arena->allocate(JSON_ARENA_SIZE));
+    TEST_ASSERT_TRUE(Serial.mockTake().find("[JSON] Arena full") != std::string::npos);
+
+    MetricsRegistry reg;
+    arena->registerMetrics(reg);
+    reg.writePrometheus(Serial);
+    TEST_ASSERT_TRUE(Serial.mockTake().find("apex_json_overflows_total{kind=\"arena\"} 1\n") !=
+                     std::string::npos);
+}
+
+void test_scope_rewinds_documents() {
+    {
+        JsonArenaScope scope;
+        ArenaJsonDocument doc(jsonObjectSize(PAIR, true));
+        doc["name"] = "pocket";
+        TEST_ASSERT_TRUE(jsonArena.getUsed() >= jsonObjectSize(PAIR, true));
+    }
+    TEST_ASSERT_EQUAL(0, jsonArena.getUsed());
+}
+
+// Plain XIAO S3 build: the pool is internal even with PSRAM on the board
+void test_pool_internal_without_psram_build() {
+    mockPsramSize = 8 * 1024 * 1024;
+    memPlace.begin();
+    TEST_ASSERT_FALSE(memPlace.hasPsram());
+    uint32_t before = memPlace.getHeld(MEM_INTERNAL);
+    JsonArena local;
+    TEST_ASSERT_NOT_NULL(local.allocate(16));
+    TEST_ASSERT_EQUAL_UINT32(before + JSON_ARENA_SIZE, memPlace.getHeld(MEM_INTERNAL));
+    TEST_ASSERT_EQUAL_UINT32(0, memPlace.getHeld(MEM_PSRAM));
+}
+
+// ============================================================================
+// SCHEMAS AND OVERFLOW
+// ============================================================================
+
+void test_schema_capacity() {
+    // Two slots; parsing copies "name", "count" and up to 8 chars of name
+    TEST_ASSERT_EQUAL(JSON_OBJECT_SIZE(2), jsonObjectSize(PAIR, false) - JSON_STRING_SIZE(8));
+    TEST_ASSERT_EQUAL(JSON_OBJECT_SIZE(2) + JSON_STRING_SIZE(4) + JSON_STRING_SIZE(5) +
+                      JSON_STRING_SIZE(8), jsonObjectSize(PAIR, true));
+}
+
+void test_schema_sized_parse_fits() {
+    JsonArenaScope scope;
+    ArenaJsonDocument doc(jsonObjectSize(PAIR, true));
+    TEST_ASSERT_TRUE(jsonArena.parsed(deserializeJson(doc, String("{\"name\":\"pocket\",\"count\":3}")), "pair"));
+    TEST_ASSERT_EQUAL_STRING("pocket", doc["name"] | "");
+    TEST_ASSERT_EQUAL(3, doc["count"] | 0);
+}
+
+void test_parse_overflow_is_reported() {
+    JsonArenaScope scope;
+    ArenaJsonDocument doc(JSON_OBJECT_SIZE(1));
+    String input("{\"name\":\"pocket\",\"count\":3,\"extra\":\"more than it has room for\"}");
+    TEST_ASSERT_FALSE(jsonArena.parsed(deserializeJson(doc, input), "pair"));
+    TEST_ASSERT_TRUE(Serial.mockTake().find("[JSON] pair: document too small") != std::string::npos);
+}
+
+void test_build_overflow_is_reported() {
+    JsonArenaScope scope;
+    ArenaJsonDocument doc(JSON_OBJECT_SIZE(1));
+    doc["name"] = "pocket";
+    doc["count"] = 3;
+    TEST_ASSERT_FALSE(jsonArena.built(doc, "pair"));
+
+    MetricsRegistry reg;
+    jsonArena.registerMetrics(reg);
+    reg.writePrometheus(Serial);
+    TEST_ASSERT_TRUE(Serial.mockTake().find("apex_json_overflows_total{kind=\"build\"} 1\n") !=
+                     std::string::npos);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_latest_allocation_pops);
+    RUN_TEST(test_out_of_order_release_waits_for_scope);
+    RUN_TEST(test_exhausted_arena_returns_null_and_counts);
+    RUN_TEST(test_scope_rewinds_documents);
+    RUN_TEST(test_pool_internal_without_psram_build);
+    RUN_TEST(test_schema_capacity);
+    RUN_TEST(test_schema_sized_parse_fits);
+    RUN_TEST(test_parse_overflow_is_reported);
+    RUN_TEST(test_build_overflow_is_reported);
+    return UNITY_END();
+}
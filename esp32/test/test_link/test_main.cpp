@@ -0,0 +1,399 @@
+/*
+ * USB link: the test plays the host, writing frames into the mock serial
+ * port and parsing what the device sends back. Windowing, go-back-N and
+ * the idle fallback run on the virtual clock.
+ */
+
+#define FEATURE_TRACE
+
+#include <Arduino.h>
+#include <unity.h>
+#include "link.h"
+
+HardwareStatus hw;
+I2CTopology i2cTopology;
+Logger logger;
+MemPlacement memPlace;
+JsonArena jsonArena;
+CpuFreq cpu;
+MetricsRegistry metrics;
+Tracer tracer;
+
+struct Frame {
+    uint8_t type;
+    uint8_t seq;
+    std::vector<uint8_t> payload;
+};
+
+static HostLink* link;
+static Soul* soul;
+static uint8_t hostSeq;
+
+static uint16_t crc16(uint16_t crc, const uint8_t* data, size_t len) {
+    while (len--) {
+        crc ^= (uint16_t)(*data++) << 8;
+        for (int i = 0; i < 8; i++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+static uint32_t get32(const std::vector<uint8_t>& p, size_t at = 0) {
+    return p[at] | (p[at + 1] << 8) | (p[at + 2] << 16) | ((uint32_t)p[at + 3] << 24);
+}
+
+static std::vector<uint8_t> encode(uint8_t type, const void* payload, size_t len) {
+    std::vector<uint8_t> f = { LINK_MAGIC0, LINK_MAGIC1, type, hostSeq++,
+                               (uint8_t)len, (uint8_t)(len >> 8) };
+    f.insert(f.end(), (const uint8_t*)payload, (const uint8_t*)payload + len);
+    uint16_t crc = crc16(0xFFFF, f.data() + 2, f.size() - 2);
+    f.push_back((uint8_t)crc);
+    f.push_back((uint8_t)(crc >> 8));
+    return f;
+}
+
+static void sendFrame(uint8_t type, const void* payload = nullptr, size_t len = 0) {
+    std::vector<uint8_t> f = encode(type, payload, len);
+    Serial.mockInput(f.data(), f.size());
+}
+
+static void sendAck(uint32_t offset) {
+    uint8_t p[4] = { (uint8_t)offset, (uint8_t)(offset >> 8), (uint8_t)(offset >> 16),
+                     (uint8_t)(offset >> 24) };
+    sendFrame(LINK_ACK, p, 4);
+}
+
+static void sendOpen(LinkSource source, const char* path) {
+    std::vector<uint8_t> p = { (uint8_t)source };
+    p.insert(p.end(), path, path + strlen(path));
+    sendFrame(LINK_OPEN, p.data(), p.size());
+}
+
+// Frames sent since the last call; console text around them is skipped,
+// a frame with a bad CRC fails the test
+static std::vector<Frame> received() {
+    std::string out = Serial.mockTake();
+    std::vector<Frame> frames;
+    size_t i = 0;
+    while (i + 8 <= out.size()) {
+        const uint8_t* p = (const uint8_t*)out.data() + i;
+        if (p[0] != LINK_MAGIC0 || p[1] != LINK_MAGIC1) { i++; continue; }
+        uint16_t len = p[4] | (p[5] << 8);
+        TEST_ASSERT_TRUE(i + 8 + len <= out.size());
+        uint16_t crc = crc16(0xFFFF, p + 2, 4 + len);
+        TEST_ASSERT_EQUAL_HEX16(crc, p[6 + len] | (p[7 + len] << 8));
+        frames.push_back({ p[2], p[3], std::vector<uint8_t>(p + 6, p + 6 + len) });
+        i += 8 + len;
+    }
+    return frames;
+}
+
+static Frame only() {
+    std::vector<Frame> frames = received();
+    TEST_ASSERT_EQUAL(1, frames.size());
+    return frames[0];
+}
+
+static std::string text(const Frame& f, size_t from = 0) {
+    return std::string(f.payload.begin() + from, f.payload.end());
+}
+
+// Ack an open stream through to the end; returns its bytes
+static std::string drain() {
+    std::string got;
+    link->poll();
+    for (int pass = 0; pass < 200 && link->isStreaming(); pass++) {
+        for (const Frame& f : received()) {
+            if (f.type == LINK_DATA && get32(f.payload) == got.size()) got += text(f, 4);
+            if (f.type == LINK_END) sendAck(LINK_ACK_END);
+            else sendAck(got.size());
+        }
+        link->poll();
+    }
+    return got;
+}
+
+void setUp() {
+    mockReset();
+    SD.mockReset();
+    SD.begin();
+    LittleFS.mockReset();
+    memset(&hw, 0, sizeof(hw));
+    Serial.mockPollUs = 50;
+    hostSeq = 0;
+    soul = new Soul();
+    link = new HostLink();
+    link->begin(soul, nullptr, 0);
+    link->start();
+    Serial.mockTake();
+}
+
+void tearDown() {
+    delete link;
+    delete soul;
+}
+
+// ============================================================================
+// FRAMING
+// ============================================================================
+
+void test_hello_reports_version_and_window() {
+    sendFrame(LINK_HELLO);
+    link->poll();
+
+    Frame f = only();
+    TEST_ASSERT_EQUAL_HEX8(LINK_HELLO_OK, f.type);
+    TEST_ASSERT_EQUAL(LINK_VERSION, f.payload[0]);
+    TEST_ASSERT_EQUAL(LINK_WINDOW, f.payload[1]);
+    TEST_ASSERT_EQUAL(LINK_MAX_PAYLOAD, f.payload[2] | (f.payload[3] << 8));
+    TEST_ASSERT_EQUAL_STRING(FW_VERSION, text(f, 4).c_str());
+}
+
+void test_noise_and_bad_crc_are_skipped() {
+    Serial.mockInput("/status\r\n");
+    std::vector<uint8_t> bad = encode(LINK_HELLO, nullptr, 0);
+    bad.back() ^= 0xFF;
+    Serial.mockInput(bad.data(), bad.size());
+    link->poll();
+    TEST_ASSERT_EQUAL(0, received().size());
+
+    sendFrame(LINK_HELLO);
+    link->poll();
+    TEST_ASSERT_EQUAL_HEX8(LINK_HELLO_OK, only().type);
+}
+
+void test_unknown_type_is_an_error() {
+    sendFrame(0x42);
+    link->poll();
+    Frame f = only();
+    TEST_ASSERT_EQUAL_HEX8(LINK_ERROR, f.type);
+    TEST_ASSERT_EQUAL(LINK_ERR_BAD_FRAME, f.payload[0]);
+}
+
+// ============================================================================
+// STREAMING
+// ============================================================================
+
+void test_file_streams_in_window_then_ends() {
+    std::string content;
+    for (int i = 0; i < 3000; i++) content += (char)('a' + i % 26);
+    SD.mockWrite("/history/day_0001.txt", content);
+
+    sendOpen(LINK_SRC_FILE, "/history/day_0001.txt");
+    link->poll();
+
+    // No ACK yet: OPEN_OK plus a full window, nothing more
+    std::vector<Frame> frames = received();
+    TEST_ASSERT_EQUAL(1 + LINK_WINDOW, frames.size());
+    TEST_ASSERT_EQUAL_HEX8(LINK_OPEN_OK, frames[0].type);
+    TEST_ASSERT_EQUAL_UINT32(3000, get32(frames[0].payload));
+
+    std::string got;
+    for (size_t i = 1; i < frames.size(); i++) {
+        TEST_ASSERT_EQUAL_HEX8(LINK_DATA, frames[i].type);
+        TEST_ASSERT_EQUAL_UINT32(got.size(), get32(frames[i].payload));
+        got += text(frames[i], 4);
+    }
+
+    sendAck(got.size());
+    link->poll();
+    frames = received();
+    TEST_ASSERT_EQUAL(3, frames.size());
+    got += text(frames[0], 4) + text(frames[1], 4);
+    TEST_ASSERT_EQUAL_HEX8(LINK_END, frames[2].type);
+    TEST_ASSERT_EQUAL_UINT32(3000, get32(frames[2].payload));
+    TEST_ASSERT_TRUE(got == content);
+
+    sendAck(LINK_ACK_END);
+    link->poll();
+    TEST_ASSERT_FALSE(link->isStreaming());
+    TEST_ASSERT_TRUE(link->isActive());
+}
+
+void test_lost_acks_go_back_to_base() {
+    SD.mockWrite("/big.bin", std::string(LINK_CHUNK * 8, 'x'));
+    sendOpen(LINK_SRC_FILE, "/big.bin");
+    link->poll();
+    received();
+
+    // First two chunks acked, the rest lost on the way
+    sendAck(LINK_CHUNK * 2);
+    link->poll();
+    TEST_ASSERT_EQUAL(2, received().size());
+
+    mockAdvance(LINK_ACK_TIMEOUT_MS + 1);
+    link->poll();
+    std::vector<Frame> frames = received();
+    TEST_ASSERT_EQUAL(LINK_WINDOW, frames.size());
+    TEST_ASSERT_EQUAL_UINT32(LINK_CHUNK * 2, get32(frames[0].payload));
+}
+
+void test_missing_file_is_not_found() {
+    sendOpen(LINK_SRC_FILE, "/nope.txt");
+    link->poll();
+    Frame f = only();
+    TEST_ASSERT_EQUAL_HEX8(LINK_ERROR, f.type);
+    TEST_ASSERT_EQUAL(LINK_ERR_NOT_FOUND, f.payload[0]);
+    TEST_ASSERT_EQUAL_STRING("/nope.txt", text(f, 1).c_str());
+    TEST_ASSERT_FALSE(link->isStreaming());
+}
+
+void test_listing_names_files_and_dirs() {
+    SD.mockWrite("/history/day_0001.txt", "hello");
+    SD.mockWrite("/config.json", "{}");
+    sendOpen(LINK_SRC_LIST, "/");
+    link->poll();
+
+    std::vector<Frame> frames = received();
+    TEST_ASSERT_EQUAL(3, frames.size());
+    std::string listing = text(frames[1], 4);
+    TEST_ASSERT_TRUE(listing.find("history/\t0\n") != std::string::npos);
+    TEST_ASSERT_TRUE(listing.find("config.json\t2\n") != std::string::npos);
+}
+
+static void smallStatus(JsonObject out) {
+    out["fw"] = "2.0.0";
+    out["E"] = 1.5;
+}
+
+// More members than its declared capacity
+static void bigStatus(JsonObject out) {
+    static const char* const KEYS[] = { "a", "b", "c", "d", "e", "f", "g", "h" };
+    for (const char* k : KEYS) out[k] = 1;
+}
+
+void test_status_is_json_in_its_capacity() {
+    link->begin(soul, smallStatus, JSON_OBJECT_SIZE(2));
+    sendOpen(LINK_SRC_STATUS, "");
+    std::string got = drain();
+    TEST_ASSERT_EQUAL_STRING("{\"fw\":\"2.0.0\",\"E\":1.5}", got.c_str());
+}
+
+void test_status_over_capacity_is_an_error() {
+    link->begin(soul, bigStatus, JSON_OBJECT_SIZE(2));
+    sendOpen(LINK_SRC_STATUS, "");
+    link->poll();
+    Frame f = only();
+    TEST_ASSERT_EQUAL_HEX8(LINK_ERROR, f.type);
+    TEST_ASSERT_EQUAL(LINK_ERR_TOO_BIG, f.payload[0]);
+    TEST_ASSERT_FALSE(link->isStreaming());
+}
+
+void test_metrics_stream_as_prometheus_text() {
+    Counter hits("apex_test_hits_total", "Test counter");
+    for (int i = 0; i < METRICS_MAX; i++) metrics.add(&hits);  // Past the generator buffer
+    hits.inc(7);
+    uint32_t held = memPlace.getHeld(MEM_INTERNAL);
+
+    sendOpen(LINK_SRC_METRICS, "");
+    std::string got = drain();
+    TEST_ASSERT_FALSE(link->isStreaming());
+    TEST_ASSERT_TRUE(got.size() > LINK_GEN_LEN);
+    TEST_ASSERT_EQUAL(0, got.find("# HELP apex_test_hits_total Test counter\n"));
+    TEST_ASSERT_TRUE(got.find("apex_test_hits_total 7\n") != std::string::npos);
+    TEST_ASSERT_EQUAL_UINT32(held, memPlace.getHeld(MEM_INTERNAL));
+    metrics = MetricsRegistry();
+}
+
+void test_trace_streams_with_the_ring_held() {
+    tracer.begin();
+    tracer.clear();
+    tracer.record(TRACE_CLOUD, 'i', "before", 1);
+
+    sendOpen(LINK_SRC_TRACE, "");
+    link->poll();
+    TEST_ASSERT_TRUE(link->isStreaming());
+    tracer.record(TRACE_CLOUD, 'i', "during", 2);
+    TEST_ASSERT_EQUAL(1, tracer.size());
+
+    std::string got = drain();
+    TEST_ASSERT_FALSE(link->isStreaming());
+    TEST_ASSERT_EQUAL(0, got.find("{\"traceEvents\":["));
+    TEST_ASSERT_TRUE(got.find("\"name\":\"before\"") != std::string::npos);
+    TEST_ASSERT_TRUE(got.find("during") == std::string::npos);
+
+    tracer.record(TRACE_CLOUD, 'i', "after", 3);
+    TEST_ASSERT_EQUAL(2, tracer.size());
+}
+
+// ============================================================================
+// SOUL
+// ============================================================================
+
+void test_soul_round_trips() {
+    soul->setAgent(2);
+    sendOpen(LINK_SRC_SOUL, "");
+    link->poll();
+    std::vector<Frame> frames = received();
+    TEST_ASSERT_EQUAL(3, frames.size());
+    TEST_ASSERT_EQUAL_UINT32(sizeof(SoulData), get32(frames[0].payload));
+
+    std::vector<uint8_t> raw(frames[1].payload.begin() + 4, frames[1].payload.end());
+    sendAck(LINK_ACK_END);
+    link->poll();
+    received();
+
+    // Back onto a soul that moved on since the export
+    soul->setAgent(0);
+    sendFrame(LINK_SOUL_PUT, raw.data(), raw.size());
+    link->poll();
+    TEST_ASSERT_EQUAL_HEX8(LINK_OK, only().type);
+    TEST_ASSERT_EQUAL_UINT8(2, soul->getAgentIndex());
+}
+
+void test_tampered_soul_is_rejected() {
+    SoulData d;
+    soul->exportData(&d);
+    d.E = 99.0f;
+    sendFrame(LINK_SOUL_PUT, &d, sizeof(d));
+    link->poll();
+    Frame f = only();
+    TEST_ASSERT_EQUAL_HEX8(LINK_ERROR, f.type);
+    TEST_ASSERT_EQUAL(LINK_ERR_REJECTED, f.payload[0]);
+    TEST_ASSERT_TRUE(soul->getE() < 99.0f);
+
+    sendFrame(LINK_SOUL_PUT, &d, sizeof(d) - 1);
+    link->poll();
+    TEST_ASSERT_EQUAL(LINK_ERR_BAD_FRAME, only().payload[0]);
+}
+
+// ============================================================================
+// SESSION
+// ============================================================================
+
+void test_bye_hands_the_port_back() {
+    sendFrame(LINK_BYE);
+    link->poll();
+    TEST_ASSERT_EQUAL_HEX8(LINK_OK, only().type);
+    TEST_ASSERT_FALSE(link->isActive());
+}
+
+void test_idle_falls_back_to_console() {
+    mockAdvance(LINK_IDLE_MS - 10);
+    sendFrame(LINK_HELLO);
+    link->poll();
+    TEST_ASSERT_TRUE(link->isActive());
+
+    mockAdvance(LINK_IDLE_MS + 1);
+    link->poll();
+    TEST_ASSERT_FALSE(link->isActive());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_hello_reports_version_and_window);
+    RUN_TEST(test_noise_and_bad_crc_are_skipped);
+    RUN_TEST(test_unknown_type_is_an_error);
+    RUN_TEST(test_file_streams_in_window_then_ends);
+    RUN_TEST(test_lost_acks_go_back_to_base);
+    RUN_TEST(test_missing_file_is_not_found);
+    RUN_TEST(test_listing_names_files_and_dirs);
+    RUN_TEST(test_status_is_json_in_its_capacity);
+    RUN_TEST(test_status_over_capacity_is_an_error);
+    RUN_TEST(test_metrics_stream_as_prometheus_text);
+    RUN_TEST(test_trace_streams_with_the_ring_held);
+    RUN_TEST(test_soul_round_trips);
+    RUN_TEST(test_tampered_soul_is_rejected);
+    RUN_TEST(test_bye_hands_the_port_back);
+    RUN_TEST(test_idle_falls_back_to_console);
+    return UNITY_END();
+}
@@ -0,0 +1,138 @@
+/*
+ * Logging: the async ring with the drain task replaced by explicit
+ * drain() calls, so ordering, overflow and hold are deterministic.
+ * SD is built at WARN to check compile-time elision.
+ */
+
+#define LOG_ASYNC 1
+#define LOG_LEVEL_SD LOG_LEVEL_WARN
+
+#include <Arduino.h>
+#include <unity.h>
+#include "log.h"
+
+Logger logger;
+
+static int sideEffects;
+
+static int touch() {
+    sideEffects++;
+    return sideEffects;
+}
+
+void setUp() {
+    mockReset();
+    logger.reset();
+    sideEffects = 0;
+    Serial.mockTake();
+}
+
+void tearDown() {}
+
+// ============================================================================
+// RING
+// ============================================================================
+
+void test_lines_wait_for_drain() {
+    LOG_I(CLOUD, "[Cloud] Status %d", 200);
+    TEST_ASSERT_TRUE(logger.pending());
+    TEST_ASSERT_EQUAL_STRING("", Serial.mockTake().c_str());
+
+    TEST_ASSERT_EQUAL(1, logger.drain());
+    TEST_ASSERT_EQUAL_STRING("[Cloud] Status 200\n", Serial.mockTake().c_str());
+    TEST_ASSERT_FALSE(logger.pending());
+}
+
+void test_drain_keeps_order() {
+    LOG_I(WIFI, "one");
+    LOG_W(SOUL, "two");
+    LOG_E(POWER, "three");
+    TEST_ASSERT_EQUAL(3, logger.drain());
+    TEST_ASSERT_EQUAL_STRING("one\ntwo\nthree\n", Serial.mockTake().c_str());
+    TEST_ASSERT_EQUAL(3, logger.getStats().lines);
+}
+
+void test_full_ring_drops_and_counts() {
+    for (int i = 0; i < LOG_SLOTS + 5; i++) LOG_I(SYS, "line %d", i);
+    TEST_ASSERT_EQUAL(LOG_SLOTS + 5, logger.getStats().lines);
+    TEST_ASSERT_EQUAL(5, logger.getStats().dropped);
+
+    TEST_ASSERT_EQUAL(LOG_SLOTS, logger.drain());
+    std::string out = Serial.mockTake();
+    TEST_ASSERT_TRUE(out.find("line 0\n") == 0);
+    TEST_ASSERT_TRUE(out.find("line 31\n") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("line 32") == std::string::npos);
+}
+
+void test_ring_reuses_slots_after_drain() {
+    for (int round = 0; round < 3; round++) {
+        for (int i = 0; i < LOG_SLOTS; i++) LOG_I(SYS, "r%d", round);
+        TEST_ASSERT_EQUAL(LOG_SLOTS, logger.drain());
+    }
+    Serial.mockTake();
+    TEST_ASSERT_EQUAL(0, logger.getStats().dropped);
+}
+
+void test_long_line_is_cut() {
+    std::string big(200, 'x');
+    LOG_I(CLOUD, "%s", big.c_str());
+    logger.drain();
+    std::string out = Serial.mockTake();
+    TEST_ASSERT_EQUAL(LOG_LINE_LEN - 1, out.size());
+    TEST_ASSERT_EQUAL('\n', out.back());
+    TEST_ASSERT_EQUAL(1, logger.getStats().truncated);
+}
+
+// ============================================================================
+// HOLD / FLUSH
+// ============================================================================
+
+void test_hold_keeps_lines_in_ring() {
+    logger.hold(true);
+    LOG_I(SYS, "while linked");
+    TEST_ASSERT_EQUAL(0, logger.drain());
+    logger.flush();
+    TEST_ASSERT_EQUAL_STRING("", Serial.mockTake().c_str());
+
+    logger.hold(false);
+    TEST_ASSERT_EQUAL(1, logger.drain());
+    TEST_ASSERT_EQUAL_STRING("while linked\n", Serial.mockTake().c_str());
+}
+
+void test_flush_empties_ring() {
+    LOG_I(POWER, "[Power] Deep sleep");
+    LOG_I(POWER, "[Power] Bye");
+    logger.flush();
+    TEST_ASSERT_FALSE(logger.pending());
+    TEST_ASSERT_EQUAL_STRING("[Power] Deep sleep\n[Power] Bye\n", Serial.mockTake().c_str());
+}
+
+// ============================================================================
+// LEVELS
+// ============================================================================
+
+void test_level_below_module_threshold_is_elided() {
+    LOG_I(SD, "[SD] %d", touch());
+    LOG_D(CLOUD, "[Cloud] %d", touch());
+    TEST_ASSERT_EQUAL(0, sideEffects);
+    TEST_ASSERT_FALSE(logger.pending());
+    TEST_ASSERT_EQUAL(0, logger.getStats().lines);
+
+    LOG_W(SD, "[SD] %d", touch());
+    TEST_ASSERT_EQUAL(1, sideEffects);
+    logger.drain();
+    TEST_ASSERT_EQUAL_STRING("[SD] 1\n", Serial.mockTake().c_str());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_lines_wait_for_drain);
+    RUN_TEST(test_drain_keeps_order);
+    RUN_TEST(test_full_ring_drops_and_counts);
+    RUN_TEST(test_ring_reuses_slots_after_drain);
+    RUN_TEST(test_long_line_is_cut);
+    RUN_TEST(test_hold_keeps_lines_in_ring);
+    RUN_TEST(test_flush_empties_ring);
+    RUN_TEST(test_level_below_module_threshold_is_elided);
+    return UNITY_END();
+}
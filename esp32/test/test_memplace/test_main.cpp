@@ -0,0 +1,123 @@
+/*
+ * Memory placement on a Sense build (HAS_PSRAM): bulk buffers to PSRAM
+ * when the chip has it, hot ones internal, fallbacks counted. PSRAM comes
+ * and goes with mockPsramSize.
+ */
+
+#define VARIANT_SENSE_OVERRIDE
+#define FEATURE_TRACE
+
+#include <Arduino.h>
+#include <unity.h>
+#include "memplace.h"
+#include "jsonarena.h"
+#include "trace.h"
+
+Logger logger;
+MemPlacement memPlace;
+JsonArena jsonArena;
+Tracer tracer;
+
+static MemPlacement* place;
+
+void setUp() {
+    mockReset();
+    mockExtmemLimit = 0;
+    place = new MemPlacement();
+}
+
+void tearDown() {
+    delete place;
+}
+
+// ============================================================================
+// POLICY
+// ============================================================================
+
+void test_bulk_goes_to_psram() {
+    mockPsramSize = 8 * 1024 * 1024;
+    place->begin();
+    TEST_ASSERT_TRUE(place->hasPsram());
+    TEST_ASSERT_EQUAL(MEM_EXTMEM_MIN, mockExtmemLimit);
+
+    MemBlock b = place->alloc(4096, MEM_BULK, "test");
+    TEST_ASSERT_NOT_NULL(b.ptr);
+    TEST_ASSERT_EQUAL(MEM_PSRAM, b.region);
+    TEST_ASSERT_EQUAL_UINT32(4096, place->getHeld(MEM_PSRAM));
+    TEST_ASSERT_EQUAL_UINT32(4096, mockPsramUsed);
+
+    place->release(b);
+    TEST_ASSERT_NULL(b.ptr);
+    TEST_ASSERT_EQUAL_UINT32(0, place->getHeld(MEM_PSRAM));
+}
+
+void test_hot_stays_internal() {
+    mockPsramSize = 8 * 1024 * 1024;
+    place->begin();
+    MemBlock b = place->alloc(1024, MEM_HOT, "test");
+    TEST_ASSERT_EQUAL(MEM_INTERNAL, b.region);
+    TEST_ASSERT_EQUAL_UINT32(1024, place->getHeld(MEM_INTERNAL));
+    TEST_ASSERT_EQUAL_UINT32(0, mockPsramUsed);
+    place->release(b);
+}
+
+void test_no_psram_found_places_internal() {
+    place->begin();
+    TEST_ASSERT_FALSE(place->hasPsram());
+    TEST_ASSERT_EQUAL(0, mockExtmemLimit);
+    TEST_ASSERT_TRUE(Serial.mockTake().find("[Mem] PSRAM build, none found") != std::string::npos);
+
+    MemBlock b = place->alloc(4096, MEM_BULK, "test");
+    TEST_ASSERT_EQUAL(MEM_INTERNAL, b.region);
+    TEST_ASSERT_EQUAL_UINT32(0, place->getFallbacks());
+    place->release(b);
+}
+
+void test_full_psram_falls_back_and_counts() {
+    mockPsramSize = 1024;
+    place->begin();
+    MemBlock b = place->alloc(2048, MEM_BULK, "big");
+    TEST_ASSERT_NOT_NULL(b.ptr);
+    TEST_ASSERT_EQUAL(MEM_INTERNAL, b.region);
+    TEST_ASSERT_EQUAL_UINT32(1, place->getFallbacks());
+    TEST_ASSERT_TRUE(Serial.mockTake().find("[Mem] big: 2048 bytes not in PSRAM") != std::string::npos);
+
+    MetricsRegistry reg;
+    place->registerMetrics(reg);
+    reg.writePrometheus(Serial);
+    std::string out = Serial.mockTake();
+    TEST_ASSERT_TRUE(out.find("apex_mem_placed_bytes{region=\"internal\"} 2048\n") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("apex_mem_placed_bytes{region=\"psram\"} 0\n") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("apex_mem_psram_fallbacks_total 1\n") != std::string::npos);
+    place->release(b);
+}
+
+// ============================================================================
+// BUFFERS
+// ============================================================================
+
+void test_arena_and_trace_ring_in_psram() {
+    mockPsramSize = 8 * 1024 * 1024;
+    memPlace.begin();
+
+    JsonArena arena;
+    TEST_ASSERT_NOT_NULL(arena.allocate(16));
+    TEST_ASSERT_EQUAL_UINT32(JSON_ARENA_SIZE, memPlace.getHeld(MEM_PSRAM));
+
+    Tracer ring;
+    ring.begin();
+    TEST_ASSERT_EQUAL(TRACE_EVENTS_PSRAM, ring.getCapacity());
+    TEST_ASSERT_EQUAL_UINT32(JSON_ARENA_SIZE + TRACE_EVENTS_PSRAM * sizeof(TraceEvent),
+                             memPlace.getHeld(MEM_PSRAM));
+    TEST_ASSERT_EQUAL_UINT32(0, memPlace.getHeld(MEM_INTERNAL));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_bulk_goes_to_psram);
+    RUN_TEST(test_hot_stays_internal);
+    RUN_TEST(test_no_psram_found_places_internal);
+    RUN_TEST(test_full_psram_falls_back_and_counts);
+    RUN_TEST(test_arena_and_trace_ring_in_psram);
+    return UNITY_END();
+}
@@ -0,0 +1,160 @@
+/*
+ * Metrics: Prometheus text for each metric type, label sets sharing a
+ * name, read functions, and the scrape handler fed through the mock
+ * serial port standing in for a TCP client.
+ */
+
+#define FEATURE_METRICS_HTTP
+
+#include <Arduino.h>
+#include <unity.h>
+#include "metrics.h"
+
+Logger logger;
+MetricsRegistry metrics;
+
+static MetricsRegistry* reg;
+static double soulE;
+
+static const uint32_t BOUNDS[] = { 10, 100, 1000 };
+
+void setUp() {
+    mockReset();
+    reg = new MetricsRegistry();
+}
+
+void tearDown() {
+    delete reg;
+}
+
+static std::string exported() {
+    reg->writePrometheus(Serial);
+    return Serial.mockTake();
+}
+
+// ============================================================================
+// EXPOSITION
+// ============================================================================
+
+void test_counter_and_gauge() {
+    Counter c("apex_test_events_total", "Events seen");
+    Gauge g("apex_test_level", "Current level");
+    reg->add(&c);
+    reg->add(&g);
+    c.inc();
+    c.inc(4);
+    g.set(2.5f);
+
+    TEST_ASSERT_EQUAL_STRING(
+        "# HELP apex_test_events_total Events seen\n"
+        "# TYPE apex_test_events_total counter\n"
+        "apex_test_events_total 5\n"
+        "# HELP apex_test_level Current level\n"
+        "# TYPE apex_test_level gauge\n"
+        "apex_test_level 2.5\n", exported().c_str());
+}
+
+void test_label_sets_share_help_and_type() {
+    Counter ok("apex_test_requests_total", "Requests by result", "result=\"ok\"");
+    Counter fail("apex_test_requests_total", "", "result=\"fail\"");
+    reg->add(&ok);
+    reg->add(&fail);
+    ok.inc(3);
+    fail.inc();
+
+    TEST_ASSERT_EQUAL_STRING(
+        "# HELP apex_test_requests_total Requests by result\n"
+        "# TYPE apex_test_requests_total counter\n"
+        "apex_test_requests_total{result=\"ok\"} 3\n"
+        "apex_test_requests_total{result=\"fail\"} 1\n", exported().c_str());
+}
+
+void test_read_function_is_sampled_at_scrape() {
+    Gauge g("apex_test_soul", "Soul E", []() -> double { return soulE; });
+    reg->add(&g);
+    soulE = 1.25;
+    TEST_ASSERT_TRUE(exported().find("apex_test_soul 1.25\n") != std::string::npos);
+    soulE = 7;
+    TEST_ASSERT_TRUE(exported().find("apex_test_soul 7\n") != std::string::npos);
+}
+
+void test_histogram_buckets_are_cumulative() {
+    Histogram h("apex_test_ms", "Round trip", BOUNDS, 3, "path=\"x\"");
+    reg->add(&h);
+    h.observe(5);
+    h.observe(10);          // On the bound: le="10"
+    h.observe(50);
+    h.observe(5000);        // Above every bound: +Inf only
+
+    TEST_ASSERT_EQUAL(2, h.bucket(0));
+    TEST_ASSERT_EQUAL(1, h.bucket(3));
+    TEST_ASSERT_EQUAL_STRING(
+        "# HELP apex_test_ms Round trip\n"
+        "# TYPE apex_test_ms histogram\n"
+        "apex_test_ms_bucket{path=\"x\",le=\"10\"} 2\n"
+        "apex_test_ms_bucket{path=\"x\",le=\"100\"} 3\n"
+        "apex_test_ms_bucket{path=\"x\",le=\"1000\"} 3\n"
+        "apex_test_ms_bucket{path=\"x\",le=\"+Inf\"} 4\n"
+        "apex_test_ms_sum{path=\"x\"} 5065\n"
+        "apex_test_ms_count{path=\"x\"} 4\n", exported().c_str());
+}
+
+void test_full_registry_refuses() {
+    Counter c("apex_test_total", "Filler");
+    for (int i = 0; i < METRICS_MAX; i++) TEST_ASSERT_TRUE(reg->add(&c));
+    TEST_ASSERT_FALSE(reg->add(&c));
+    TEST_ASSERT_EQUAL(METRICS_MAX, reg->size());
+}
+
+// ============================================================================
+// SCRAPE ENDPOINT
+// ============================================================================
+
+void test_get_metrics_answers_with_registry() {
+    Counter c("apex_events_total", "Events");
+    metrics.add(&c);
+    c.inc(2);
+
+    MetricsServer server;
+    Serial.mockInput("GET /metrics HTTP/1.1\r\nHost: pocket\r\nAccept: */*\r\n\r\n");
+    TEST_ASSERT_EQUAL(200, server.handle(Serial));
+
+    std::string out = Serial.mockTake();
+    TEST_ASSERT_TRUE(out.find("HTTP/1.1 200 OK\r\n") == 0);
+    TEST_ASSERT_TRUE(out.find("Content-Type: text/plain; version=0.0.4\r\n") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("\r\n\r\n# HELP apex_events_total Events\n") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("apex_events_total 2\n") != std::string::npos);
+    TEST_ASSERT_EQUAL(1, server.getScrapes());
+}
+
+void test_other_paths_get_404() {
+    MetricsServer server;
+    Serial.mockInput("GET / HTTP/1.1\r\n\r\n");
+    TEST_ASSERT_EQUAL(404, server.handle(Serial));
+    TEST_ASSERT_TRUE(Serial.mockTake().find("HTTP/1.1 404") == 0);
+    TEST_ASSERT_EQUAL(0, server.getScrapes());
+}
+
+void test_server_follows_wifi() {
+    WiFi.begin("Home", "pw");
+    MetricsServer server;
+    server.setOnline(true);
+    TEST_ASSERT_TRUE(Serial.mockTake().find("[Metrics] http://192.168.1.42:9100/metrics") != std::string::npos);
+    server.setOnline(true);
+    TEST_ASSERT_EQUAL_STRING("", Serial.mockTake().c_str());
+    server.setOnline(false);
+    server.poll();          // Not listening: nothing accepted
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_counter_and_gauge);
+    RUN_TEST(test_label_sets_share_help_and_type);
+    RUN_TEST(test_read_function_is_sampled_at_scrape);
+    RUN_TEST(test_histogram_buckets_are_cumulative);
+    RUN_TEST(test_full_registry_refuses);
+    RUN_TEST(test_get_metrics_answers_with_registry);
+    RUN_TEST(test_other_paths_get_404);
+    RUN_TEST(test_server_follows_wifi);
+    return UNITY_END();
+}
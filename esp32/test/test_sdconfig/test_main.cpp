@@ -0,0 +1,219 @@
+/*
+ * SD configuration: config.json parsing, change fingerprint, LittleFS
+ * backup, chat history logging and tail.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "sdconfig.h"
+
+Logger logger;
+MemPlacement memPlace;
+JsonArena jsonArena;
+
+static CloudConfig cfg;
+static WifiNetwork networks[MAX_WIFI_NETWORKS];
+static int networkCount;
+
+static const char* FULL_CONFIG =
+    "{\"cloud_url\":\"https://cloud.test\",\"device_token\":\"apex_dev_abc\","
+    "\"device_id\":\"550e8400\",\"brightness\":\"high\",\"wifi\":["
+    "{\"ssid\":\"Home\",\"pass\":\"one\"},{\"ssid\":\"\",\"pass\":\"skipped\"},"
+    "{\"ssid\":\"Work\",\"pass\":\"two\"},{\"ssid\":\"Cafe\"},{\"ssid\":\"Extra\"}]}";
+
+// Output sink for sdPrintChatTail
+class Capture : public Print {
+public:
+    std::string text;
+    size_t write(uint8_t c) override { text += (char)c; return 1; }
+    using Print::write;
+};
+
+void setUp() {
+    mockReset();
+    SD.mockReset();
+    SD.mockPresent = true;
+    LittleFS.mockReset();
+    memset(&cfg, 0, sizeof(cfg));
+    memset(networks, 0, sizeof(networks));
+    networkCount = -1;
+}
+
+void tearDown() {}
+
+// ============================================================================
+// CONFIG.JSON
+// ============================================================================
+
+void test_reads_cloud_and_wifi() {
+    SD.mockWrite(CONFIG_FILENAME, FULL_CONFIG);
+    TEST_ASSERT_TRUE(sdInit());
+
+    uint8_t brightness = 1;
+    TEST_ASSERT_TRUE(sdReadConfig(&cfg, networks, &networkCount, &brightness));
+
+    TEST_ASSERT_TRUE(cfg.configured);
+    TEST_ASSERT_EQUAL_STRING("https://cloud.test", cfg.cloud_url);
+    TEST_ASSERT_EQUAL_STRING("apex_dev_abc", cfg.device_token);
+    TEST_ASSERT_EQUAL_STRING("550e8400", cfg.device_id);
+    TEST_ASSERT_EQUAL_UINT8(2, brightness);
+
+    // Empty SSIDs are skipped, the list is capped
+    TEST_ASSERT_EQUAL(MAX_WIFI_NETWORKS, networkCount);
+    TEST_ASSERT_EQUAL_STRING("Home", networks[0].ssid);
+    TEST_ASSERT_EQUAL_STRING("Work", networks[1].ssid);
+    TEST_ASSERT_EQUAL_STRING("two", networks[1].pass);
+    TEST_ASSERT_EQUAL_STRING("Cafe", networks[2].ssid);
+    TEST_ASSERT_EQUAL_STRING("", networks[2].pass);
+}
+
+void test_missing_token_is_not_configured() {
+    SD.mockWrite(CONFIG_FILENAME, "{\"device_id\":\"x\"}");
+    sdInit();
+
+    uint8_t brightness = 1;
+    TEST_ASSERT_FALSE(sdReadConfig(&cfg, networks, &networkCount, &brightness));
+    TEST_ASSERT_EQUAL_STRING(DEFAULT_CLOUD_URL, cfg.cloud_url);
+    TEST_ASSERT_EQUAL(0, networkCount);
+    TEST_ASSERT_EQUAL_UINT8(1, brightness);
+}
+
+void test_malformed_json_is_rejected() {
+    SD.mockWrite(CONFIG_FILENAME, "{\"device_token\":\"apex_dev_abc\",");
+    sdInit();
+
+    TEST_ASSERT_FALSE(sdReadConfig(&cfg, networks, &networkCount));
+    TEST_ASSERT_FALSE(cfg.configured);
+    TEST_ASSERT_TRUE(Serial.mockTake().find("JSON parse error") != std::string::npos);
+}
+
+void test_no_card_no_config() {
+    SD.mockPresent = false;
+    TEST_ASSERT_FALSE(sdInit(false));
+    TEST_ASSERT_FALSE(sdCardPresent());
+    TEST_ASSERT_FALSE(sdReadConfig(&cfg, networks, &networkCount));
+}
+
+// ============================================================================
+// CHANGE DETECTION
+// ============================================================================
+
+void test_stamp_detects_edits() {
+    SD.mockWrite(CONFIG_FILENAME, "{\"device_token\":\"aaaa\"}");
+    sdInit();
+
+    SdConfigStamp a, b;
+    TEST_ASSERT_TRUE(sdConfigStamp(&a));
+    TEST_ASSERT_TRUE(sdConfigStamp(&b));
+    TEST_ASSERT_FALSE(sdConfigChanged(&a, &b));
+
+    // Same size, same second: only the hash differs
+    SD.mockWrite(CONFIG_FILENAME, "{\"device_token\":\"bbbb\"}");
+    TEST_ASSERT_TRUE(sdConfigStamp(&b));
+    TEST_ASSERT_EQUAL(a.size, b.size);
+    TEST_ASSERT_TRUE(sdConfigChanged(&a, &b));
+
+    SD.remove(CONFIG_FILENAME);
+    TEST_ASSERT_FALSE(sdConfigStamp(&b));
+    TEST_ASSERT_TRUE(sdConfigChanged(&a, &b));
+}
+
+// ============================================================================
+// LITTLEFS BACKUP
+// ============================================================================
+
+void test_littlefs_backup_round_trip() {
+    LittleFS.begin(true);
+    strlcpy(cfg.cloud_url, "https://cloud.test", sizeof(cfg.cloud_url));
+    strlcpy(cfg.device_token, "apex_dev_abc", sizeof(cfg.device_token));
+    strlcpy(cfg.device_id, "550e8400", sizeof(cfg.device_id));
+    cfg.configured = true;
+    sdSaveConfigToLittleFS(&cfg);
+
+    CloudConfig loaded;
+    memset(&loaded, 0, sizeof(loaded));
+    TEST_ASSERT_TRUE(sdLoadConfigFromLittleFS(&loaded));
+    TEST_ASSERT_EQUAL_STRING("https://cloud.test", loaded.cloud_url);
+    TEST_ASSERT_EQUAL_STRING("apex_dev_abc", loaded.device_token);
+    TEST_ASSERT_EQUAL_STRING("550e8400", loaded.device_id);
+}
+
+void test_littlefs_without_backup() {
+    LittleFS.begin(true);
+    TEST_ASSERT_FALSE(sdLoadConfigFromLittleFS(&cfg));
+}
+
+// ============================================================================
+// CHAT HISTORY
+// ============================================================================
+
+void test_chat_log_appends_to_daily_file() {
+    sdInit();
+    mockAdvance(2UL * 86400000 + 61000);
+
+    TEST_ASSERT_TRUE(sdLogChat("AZOTH", "hello", "hi there", 2.5f));
+    TEST_ASSERT_TRUE(sdLogChat("AZOTH", "again", "still here", 2.6f));
+
+    char name[32];
+    sdChatLogName(name, sizeof(name));
+    TEST_ASSERT_EQUAL_STRING(HISTORY_DIR "/day_0002.txt", name);
+    TEST_ASSERT_EQUAL_STRING(
+        "[01:01] AZOTH> User: hello | Response: hi there | E=2.5\n"
+        "[01:01] AZOTH> User: again | Response: still here | E=2.6\n",
+        SD.mockRead(name).c_str());
+}
+
+void test_chat_log_rolls_over_when_full() {
+    sdInit();
+    char name[32];
+    sdChatLogName(name, sizeof(name));
+    SD.mockWrite(name, std::string(MAX_HISTORY_FILE_KB * 1024 + 1, 'x'));
+
+    TEST_ASSERT_TRUE(sdLogChat("AZOTH", "hello", "hi", 1.0f));
+    TEST_ASSERT_TRUE(SD.exists(HISTORY_DIR "/day_0000_old.txt"));
+    TEST_ASSERT_EQUAL_STRING("[00:00] AZOTH> User: hello | Response: hi | E=1.0\n",
+                             SD.mockRead(name).c_str());
+}
+
+void test_chat_tail_prints_last_lines() {
+    sdInit();
+    char msg[8];
+    for (int i = 0; i < 5; i++) {
+        snprintf(msg, sizeof(msg), "m%d", i);
+        sdLogChat("AZOTH", msg, "ok", 1.0f);
+    }
+
+    Capture out;
+    TEST_ASSERT_TRUE(sdPrintChatTail(out, 2));
+    TEST_ASSERT_EQUAL_STRING(
+        "[00:00] AZOTH> User: m3 | Response: ok | E=1.0\n"
+        "[00:00] AZOTH> User: m4 | Response: ok | E=1.0\n",
+        out.text.c_str());
+}
+
+void test_ejected_card_fails_cleanly() {
+    sdInit();
+    TEST_ASSERT_TRUE(sdCardPresent());
+    SD.mockEjected = true;
+
+    TEST_ASSERT_FALSE(sdCardPresent());
+    TEST_ASSERT_FALSE(sdLogChat("AZOTH", "hello", "hi", 1.0f));
+    Capture out;
+    TEST_ASSERT_FALSE(sdPrintChatTail(out, 3));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_reads_cloud_and_wifi);
+    RUN_TEST(test_missing_token_is_not_configured);
+    RUN_TEST(test_malformed_json_is_rejected);
+    RUN_TEST(test_no_card_no_config);
+    RUN_TEST(test_stamp_detects_edits);
+    RUN_TEST(test_littlefs_backup_round_trip);
+    RUN_TEST(test_littlefs_without_backup);
+    RUN_TEST(test_chat_log_appends_to_daily_file);
+    RUN_TEST(test_chat_log_rolls_over_when_full);
+    RUN_TEST(test_chat_tail_prints_last_lines);
+    RUN_TEST(test_ejected_card_fails_cleanly);
+    return UNITY_END();
+}
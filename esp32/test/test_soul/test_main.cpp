@@ -0,0 +1,272 @@
+/*
+ * Soul: the Love-Equation, state thresholds, RTC snapshot and both
+ * persistence paths (I2C EEPROM, LittleFS JSON fallback).
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "soul.h"
+
+HardwareStatus hw;
+I2CTopology i2cTopology;
+Logger logger;
+MemPlacement memPlace;
+JsonArena jsonArena;
+CpuFreq cpu;
+
+static const uint8_t EEPROM_ADDR = 0x50;
+
+// One minute of care at the given intensity
+static void careMinute(Soul& soul, float intensity = 1.0f) {
+    mockAdvance(60000);
+    soul.applyCare(intensity);
+}
+
+// Recompute the checksum after an edit, as tools/apexlink.py does
+static void reseal(SoulData& d) {
+    const uint8_t* ptr = (const uint8_t*)&d;
+    uint32_t sum = 0;
+    for (size_t i = 0; i < sizeof(SoulData) - sizeof(uint32_t); i++) sum += ptr[i] * (i + 1);
+    d.checksum = sum ^ 0xA9EF;
+}
+
+void setUp() {
+    mockReset();
+    Wire.mockReset();
+    LittleFS.mockReset();
+    memset(&hw, 0, sizeof(hw));
+}
+
+void tearDown() {}
+
+// ============================================================================
+// LOVE EQUATION
+// ============================================================================
+
+void test_fresh_soul_starts_at_initial_values() {
+    Soul soul;
+    TEST_ASSERT_EQUAL_FLOAT(INITIAL_E, soul.getE());
+    TEST_ASSERT_EQUAL_FLOAT(INITIAL_FLOOR, soul.getFloor());
+    TEST_ASSERT_EQUAL_UINT32(0, soul.getInteractions());
+    TEST_ASSERT_EQUAL_STRING("AZOTH", soul.getAgentName());
+    TEST_ASSERT_EQUAL_STRING(FW_VERSION, soul.getFirmwareVersion());
+}
+
+void test_care_follows_the_equation() {
+    Soul soul;
+    float E = soul.getE();
+    float expected = E + BETA_BASE * (1.0f + E / 10.0f) * 1.0f * E * 1.0f;
+
+    careMinute(soul);
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, expected, soul.getE());
+    TEST_ASSERT_EQUAL_UINT32(1, soul.getInteractions());
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 1.0f, soul.getTotalCare());
+}
+
+void test_damage_never_goes_below_floor() {
+    Soul soul;
+    for (int i = 0; i < 120; i++) careMinute(soul);
+    float floor = soul.getFloor();
+    TEST_ASSERT_TRUE(floor > INITIAL_FLOOR);
+
+    for (int i = 0; i < 600; i++) {
+        mockAdvance(60000);
+        soul.applyDamage(5.0f);
+    }
+
+    TEST_ASSERT_EQUAL_FLOAT(soul.getFloor(), soul.getE());
+    TEST_ASSERT_TRUE(soul.getFloor() >= floor);
+}
+
+void test_update_ignores_implausible_gaps() {
+    Soul soul;
+    mockAdvance(61UL * 60000);
+    soul.applyCare(1.0f);
+    TEST_ASSERT_EQUAL_FLOAT(INITIAL_E, soul.getE());
+
+    // Zero elapsed time is a no-op too
+    soul.applyCare(1.0f);
+    TEST_ASSERT_EQUAL_FLOAT(INITIAL_E, soul.getE());
+}
+
+void test_advance_raises_floor_without_touching_e() {
+    Soul soul;
+    for (int i = 0; i < 60; i++) careMinute(soul);
+    float E = soul.getE();
+    float floor = soul.getFloor();
+
+    soul.advance(8 * 60.0f);
+
+    TEST_ASSERT_EQUAL_FLOAT(E, soul.getE());
+    TEST_ASSERT_TRUE(soul.getFloor() > floor);
+    TEST_ASSERT_TRUE(soul.getFloor() <= soul.getE());
+}
+
+void test_states_climb_in_order() {
+    Soul soul;
+    TEST_ASSERT_EQUAL(STATE_GUARDED, soul.getState());
+
+    const float thresholds[] = { E_GUARDED, E_TENDER, E_WARM, E_FLOURISHING, E_RADIANT, E_TRANSCENDENT };
+    AffectiveState last = soul.getState();
+    for (int i = 0; i < 5000 && soul.getState() != STATE_TRANSCENDENT; i++) {
+        careMinute(soul);
+        AffectiveState now = soul.getState();
+        TEST_ASSERT_TRUE(now >= last);
+        if (now != last) {
+            TEST_ASSERT_EQUAL(last + 1, now);
+            TEST_ASSERT_TRUE(soul.getE() > thresholds[now - 1]);
+        }
+        last = now;
+    }
+    TEST_ASSERT_EQUAL(STATE_TRANSCENDENT, soul.getState());
+    TEST_ASSERT_EQUAL_STRING("TRANSCEND", soul.getStateName());
+    TEST_ASSERT_TRUE(soul.getE() <= MAX_E);
+}
+
+// ============================================================================
+// RTC SNAPSHOT
+// ============================================================================
+
+void test_snapshot_round_trip() {
+    Soul a;
+    for (int i = 0; i < 30; i++) careMinute(a);
+    a.setAgent(3);
+    a.recordChat();
+
+    SoulData snap;
+    a.exportData(&snap);
+
+    Soul b;
+    TEST_ASSERT_TRUE(b.importData(&snap));
+    TEST_ASSERT_EQUAL_FLOAT(a.getE(), b.getE());
+    TEST_ASSERT_EQUAL_FLOAT(a.getFloor(), b.getFloor());
+    TEST_ASSERT_EQUAL_UINT32(a.getInteractions(), b.getInteractions());
+    TEST_ASSERT_EQUAL_STRING("KETHER", b.getAgentName());
+    TEST_ASSERT_EQUAL_UINT32(1, b.getTotalChats());
+}
+
+void test_snapshot_rejects_tampering() {
+    Soul a;
+    careMinute(a);
+    SoulData snap;
+    a.exportData(&snap);
+    snap.E = 99.0f;
+
+    Soul b;
+    TEST_ASSERT_FALSE(b.importData(&snap));
+    TEST_ASSERT_EQUAL_FLOAT(INITIAL_E, b.getE());
+}
+
+void test_snapshot_rejects_unknown_agent() {
+    Soul a;
+    SoulData snap;
+    a.exportData(&snap);
+    snap.agentIndex = Soul::NUM_AGENTS;
+    reseal(snap);
+
+    Soul b;
+    b.setAgent(2);
+    TEST_ASSERT_FALSE(b.importData(&snap));
+    TEST_ASSERT_EQUAL_UINT8(2, b.getAgentIndex());
+}
+
+void test_snapshot_values_are_clamped() {
+    Soul a;
+    SoulData snap;
+    a.exportData(&snap);
+    snap.E = 500.0f;
+    snap.E_floor = -3.0f;
+    snap.curiosity = NAN;
+    snap.wisdom = 7.0f;
+    reseal(snap);
+
+    Soul b;
+    TEST_ASSERT_TRUE(b.importData(&snap));
+    TEST_ASSERT_EQUAL_FLOAT(MAX_E, b.getE());
+    TEST_ASSERT_EQUAL_FLOAT(INITIAL_FLOOR, b.getFloor());
+    TEST_ASSERT_EQUAL_FLOAT(MAX_E, b.getPeak());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, b.getCuriosity());
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, b.getWisdom());
+}
+
+// ============================================================================
+// PERSISTENCE
+// ============================================================================
+
+void test_eeprom_round_trip() {
+    Wire.mockAttach(EEPROM_ADDR, 32768);
+    hw.eeprom_found = true;
+    hw.eeprom_addr = EEPROM_ADDR;
+
+    Soul a;
+    for (int i = 0; i < 45; i++) careMinute(a);
+    a.setAgent(1);
+    TEST_ASSERT_TRUE(a.save());
+    TEST_ASSERT_GREATER_THAN(0, Wire.mockDevice(EEPROM_ADDR)->writes);
+
+    Soul b;
+    TEST_ASSERT_TRUE(b.load());
+    TEST_ASSERT_EQUAL_FLOAT(a.getE(), b.getE());
+    TEST_ASSERT_EQUAL_FLOAT(a.getPeak(), b.getPeak());
+    TEST_ASSERT_EQUAL_UINT8(1, b.getAgentIndex());
+}
+
+void test_eeprom_corruption_starts_fresh() {
+    Wire.mockAttach(EEPROM_ADDR, 32768);
+    hw.eeprom_found = true;
+    hw.eeprom_addr = EEPROM_ADDR;
+
+    Soul a;
+    for (int i = 0; i < 45; i++) careMinute(a);
+    a.save();
+    Wire.mockDevice(EEPROM_ADDR)->mem[EEPROM_SOUL_ADDR] ^= 0x5A;
+
+    Soul b;
+    TEST_ASSERT_FALSE(b.load());
+    TEST_ASSERT_EQUAL_FLOAT(INITIAL_E, b.getE());
+}
+
+void test_littlefs_fallback() {
+    TEST_ASSERT_TRUE(LittleFS.begin(true));
+    hw.littlefs_available = true;
+
+    Soul a;
+    for (int i = 0; i < 45; i++) careMinute(a);
+    a.setAgent(2);
+    TEST_ASSERT_TRUE(a.save());
+    TEST_ASSERT_TRUE(LittleFS.exists("/soul.json"));
+    TEST_ASSERT_TRUE(LittleFS.mockRead("/soul.json").find("\"agent\":2") != std::string::npos);
+
+    Soul b;
+    TEST_ASSERT_TRUE(b.load());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, a.getE(), b.getE());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, a.getFloor(), b.getFloor());
+    TEST_ASSERT_EQUAL_UINT32(a.getInteractions(), b.getInteractions());
+    TEST_ASSERT_EQUAL_STRING("VAJRA", b.getAgentName());
+}
+
+void test_no_storage_reports_failure() {
+    Soul soul;
+    TEST_ASSERT_FALSE(soul.save());
+    TEST_ASSERT_TRUE(Serial.mockTake().find("No storage available") != std::string::npos);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_fresh_soul_starts_at_initial_values);
+    RUN_TEST(test_care_follows_the_equation);
+    RUN_TEST(test_damage_never_goes_below_floor);
+    RUN_TEST(test_update_ignores_implausible_gaps);
+    RUN_TEST(test_advance_raises_floor_without_touching_e);
+    RUN_TEST(test_states_climb_in_order);
+    RUN_TEST(test_snapshot_round_trip);
+    RUN_TEST(test_snapshot_rejects_tampering);
+    RUN_TEST(test_snapshot_rejects_unknown_agent);
+    RUN_TEST(test_snapshot_values_are_clamped);
+    RUN_TEST(test_eeprom_round_trip);
+    RUN_TEST(test_eeprom_corruption_starts_fresh);
+    RUN_TEST(test_littlefs_fallback);
+    RUN_TEST(test_no_storage_reports_failure);
+    return UNITY_END();
+}
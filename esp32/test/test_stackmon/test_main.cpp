@@ -0,0 +1,126 @@
+/*
+ * Stack watermarks: the loop task is the mock's byte-array stack, and a
+ * "call" is mockStackUse() scribbling some bytes below the current frame.
+ */
+
+#include <Arduino.h>
+#include <unity.h>
+#include "stackmon.h"
+
+StackMonitor stackMon;
+
+void setUp() {
+    mockReset();                // Loop task with 512 bytes in use
+    stackMon = StackMonitor();
+}
+
+void tearDown() {}
+
+// ============================================================================
+// PATHS
+// ============================================================================
+
+void test_scope_measures_path_depth() {
+    {
+        StackScope scope(STACK_PATH_CHAT);
+        mockStackUse(3000);
+    }
+    const StackPathStats& s = stackMon.pathStats(STACK_PATH_CHAT);
+    TEST_ASSERT_EQUAL_UINT32(1, s.runs);
+    TEST_ASSERT_EQUAL_UINT32(3000, s.depth);
+    TEST_ASSERT_EQUAL_UINT32(3512, s.peak);
+    TEST_ASSERT_EQUAL_UINT32(0, stackMon.pathStats(STACK_PATH_SYNC).runs);
+}
+
+void test_each_run_is_measured_fresh() {
+    // A deep first path must not show up as the second path's depth
+    {
+        StackScope scope(STACK_PATH_CHAT);
+        mockStackUse(5000);
+    }
+    {
+        StackScope scope(STACK_PATH_SYNC);
+        mockStackUse(1200);
+    }
+    TEST_ASSERT_EQUAL_UINT32(5000, stackMon.pathStats(STACK_PATH_CHAT).depth);
+    TEST_ASSERT_EQUAL_UINT32(1200, stackMon.pathStats(STACK_PATH_SYNC).depth);
+}
+
+void test_path_keeps_its_deepest_run() {
+    for (uint32_t use : { 2000u, 4000u, 1000u }) {
+        StackScope scope(STACK_PATH_CONFIG);
+        mockStackUse(use);
+    }
+    const StackPathStats& s = stackMon.pathStats(STACK_PATH_CONFIG);
+    TEST_ASSERT_EQUAL_UINT32(3, s.runs);
+    TEST_ASSERT_EQUAL_UINT32(4000, s.depth);
+}
+
+void test_nested_scope_does_nothing() {
+    {
+        StackScope outer(STACK_PATH_SYNC);
+        StackScope inner(STACK_PATH_CONFIG);
+        mockStackUse(2000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2000, stackMon.pathStats(STACK_PATH_SYNC).depth);
+    TEST_ASSERT_EQUAL_UINT32(0, stackMon.pathStats(STACK_PATH_CONFIG).runs);
+}
+
+// ============================================================================
+// LOOP TASK
+// ============================================================================
+
+void test_refill_keeps_older_task_mark() {
+    mockStackUse(6000);         // Deep call outside any scope
+    {
+        StackScope scope(STACK_PATH_CHAT);
+        mockStackUse(1000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(6512, stackMon.loopPeak());
+}
+
+void test_suggests_peak_plus_margin() {
+    {
+        StackScope scope(STACK_PATH_CHAT);
+        mockStackUse(4000);
+    }
+    // 4512 + 25% = 5640, rounded up to 6 KB
+    TEST_ASSERT_EQUAL_UINT32(6144, stackMon.suggestedLoopSize());
+    stackMon.print();
+    std::string out = Serial.mockTake();
+    TEST_ASSERT_TRUE(out.find("chat") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("-DARDUINO_LOOP_STACK_SIZE=6144") != std::string::npos);
+}
+
+void test_warns_once_when_loop_runs_short() {
+    mockStackUse(ARDUINO_LOOP_STACK_SIZE - 512 - 600);
+    mockAdvance(STACK_CHECK_MS);
+    stackMon.update();
+    TEST_ASSERT_TRUE(Serial.mockTake().find("[Stack] Loop task down to 600") != std::string::npos);
+
+    mockAdvance(STACK_CHECK_MS);
+    stackMon.update();
+    TEST_ASSERT_EQUAL(0, Serial.mockTake().size());
+}
+
+void test_lists_known_tasks() {
+    mockTaskAdd("esp_timer", 2200);
+    stackMon.print();
+    std::string out = Serial.mockTake();
+    TEST_ASSERT_TRUE(out.find("loopTask") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("2200") != std::string::npos);
+    TEST_ASSERT_TRUE(out.find("tiT") == std::string::npos);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_scope_measures_path_depth);
+    RUN_TEST(test_each_run_is_measured_fresh);
+    RUN_TEST(test_path_keeps_its_deepest_run);
+    RUN_TEST(test_nested_scope_does_nothing);
+    RUN_TEST(test_refill_keeps_older_task_mark);
+    RUN_TEST(test_suggests_peak_plus_margin);
+    RUN_TEST(test_warns_once_when_loop_runs_short);
+    RUN_TEST(test_lists_known_tasks);
+    return UNITY_END();
+}
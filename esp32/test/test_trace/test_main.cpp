@@ -0,0 +1,122 @@
+/*
+ * Event tracing: timestamps come from the virtual clock, so the exported
+ * JSON is checked to the microsecond. A tiny ring makes wrap-around easy
+ * to hit.
+ */
+
+#define FEATURE_TRACE
+#define TRACE_EVENTS 8
+
+#include <Arduino.h>
+#include <unity.h>
+#include "trace.h"
+
+Logger logger;
+MemPlacement memPlace;
+Tracer tracer;
+
+void setUp() {
+    mockReset();
+    tracer.begin();
+    tracer.clear();
+}
+
+void tearDown() {}
+
+static std::string exported() {
+    tracer.exportJson(Serial);
+    return Serial.mockTake();
+}
+
+static bool has(const std::string& s, const char* what) {
+    return s.find(what) != std::string::npos;
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+void test_scope_records_begin_and_end() {
+    mockAdvance(5);
+    {
+        TRACE_SCOPE(TRACE_CLOUD, "sync");
+        mockAdvance(120);
+    }
+    TEST_ASSERT_EQUAL(2, tracer.size());
+    TEST_ASSERT_EQUAL('B', tracer.at(0).phase);
+    TEST_ASSERT_EQUAL('E', tracer.at(1).phase);
+    TEST_ASSERT_EQUAL_STRING("sync", tracer.at(1).name);
+    TEST_ASSERT_EQUAL_UINT32(5000, tracer.at(0).ts);
+    TEST_ASSERT_EQUAL_UINT32(125000, tracer.at(1).ts);
+}
+
+void test_ring_keeps_newest() {
+    for (uint16_t i = 0; i < TRACE_EVENTS + 3; i++) {
+        TRACE_INSTANT(TRACE_INPUT, "short", i);
+        mockAdvance(1);
+    }
+    TEST_ASSERT_EQUAL(TRACE_EVENTS, tracer.size());
+    TEST_ASSERT_EQUAL_UINT32(3, tracer.getOverwritten());
+    TEST_ASSERT_EQUAL_UINT16(3, tracer.at(0).arg);
+    TEST_ASSERT_EQUAL_UINT16(TRACE_EVENTS + 2, tracer.at(TRACE_EVENTS - 1).arg);
+}
+
+void test_nothing_recorded_before_begin() {
+    Tracer early;
+    early.record(TRACE_INPUT, 'i', "short");
+    TEST_ASSERT_EQUAL(0, early.size());
+    early.begin();
+    TEST_ASSERT_EQUAL(TRACE_EVENTS, early.getCapacity());
+    early.record(TRACE_INPUT, 'i', "short");
+    TEST_ASSERT_EQUAL(1, early.size());
+}
+
+// ============================================================================
+// EXPORT
+// ============================================================================
+
+void test_export_is_chrome_trace() {
+    mockAdvance(1000);
+    TRACE_BEGIN(TRACE_FRAME, "render");
+    mockAdvance(12);
+    TRACE_END(TRACE_FRAME, "render");
+    TRACE_INSTANT(TRACE_WIFI, "connected", 1);
+
+    std::string json = exported();
+    TEST_ASSERT_EQUAL(0, json.find("{\"traceEvents\":["));
+    TEST_ASSERT_TRUE(has(json, "\"args\":{\"name\":\"storage\"}"));
+    TEST_ASSERT_TRUE(has(json, "{\"name\":\"render\",\"cat\":\"frame\",\"ph\":\"B\",\"ts\":0,\"pid\":1,\"tid\":0}"));
+    TEST_ASSERT_TRUE(has(json, "\"ph\":\"E\",\"ts\":12000,"));
+    TEST_ASSERT_TRUE(has(json, "{\"name\":\"connected\",\"cat\":\"wifi\",\"ph\":\"i\",\"ts\":12000,"
+                               "\"pid\":1,\"tid\":4,\"s\":\"t\",\"args\":{\"v\":1}}"));
+    TEST_ASSERT_TRUE(has(json, "],\"displayTimeUnit\":\"ms\"}\n"));
+}
+
+void test_export_drops_orphaned_ends() {
+    TRACE_BEGIN(TRACE_CLOUD, "http");
+    for (int i = 0; i < TRACE_EVENTS - 1; i++) TRACE_INSTANT(TRACE_INPUT, "short", 0);
+    TRACE_END(TRACE_CLOUD, "http");       // Its begin is gone from the ring
+
+    std::string json = exported();
+    TEST_ASSERT_FALSE(has(json, "\"http\""));
+    TEST_ASSERT_TRUE(has(json, "\"short\""));
+}
+
+void test_export_leaves_ring_intact() {
+    TRACE_INSTANT(TRACE_INPUT, "short", 0);
+    tracer.exportJson(Serial);
+    TEST_ASSERT_EQUAL(1, tracer.size());
+    TRACE_INSTANT(TRACE_INPUT, "long", 0);
+    TEST_ASSERT_EQUAL(2, tracer.size());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_scope_records_begin_and_end);
+    RUN_TEST(test_ring_keeps_newest);
+    RUN_TEST(test_nothing_recorded_before_begin);
+    RUN_TEST(test_export_is_chrome_trace);
+    RUN_TEST(test_export_drops_orphaned_ends);
+    RUN_TEST(test_export_leaves_ring_intact);
+    return UNITY_END();
+}
@@ -0,0 +1,289 @@
+#!/usr/bin/env python3
+"""
+ApexLink - host side of the ApexPocket USB link (esp32/src/link.h)
+
+Pulls chat history, soul state, status, metrics and the event trace off
+the device over the USB CDC serial port, and restores a soul dump.
+
+    apexlink.py status
+    apexlink.py metrics
+    apexlink.py trace [trace.json]
+    apexlink.py ls /history
+    apexlink.py get /history/day_0000.txt [local]
+    apexlink.py soul show
+    apexlink.py soul dump soul.bin
+    apexlink.py soul restore soul.bin
+
+Needs pyserial (pip install pyserial). Default port is /dev/ttyACM0.
+"""
+
+import argparse
+import binascii
+import json
+import struct
+import sys
+import time
+from pathlib import Path
+
+try:
+    import serial
+except ImportError:
+    sys.exit("apexlink needs pyserial: pip install pyserial")
+
+
+# ==================== PROTOCOL ====================
+
+MAGIC = b"\xa5\x5a"
+VERSION = 1
+
+HELLO, OPEN, ACK, SOUL_PUT, BYE = 0x01, 0x02, 0x03, 0x04, 0x05
+HELLO_OK, OPEN_OK, DATA, END, OK, ERROR = 0x81, 0x82, 0x83, 0x84, 0x85, 0xFF
+
+SRC_FILE, SRC_LIST, SRC_SOUL, SRC_STATUS, SRC_METRICS, SRC_TRACE = 0, 1, 2, 3, 4, 5
+ACK_END = 0xFFFFFFFF
+
+ERRORS = {1: "bad frame", 2: "not found", 3: "busy", 4: "rejected", 5: "too big"}
+
+# SoulData as laid out by the ESP32 compiler (little-endian, 80 bytes)
+SOUL_FORMAT = "<3fIf3IB3x3f16s4I"
+SOUL_FIELDS = [
+    "E", "E_floor", "E_peak", "interactions", "totalCare", "birthTime",
+    "lastCareTime", "totalAwakeTime", "agentIndex", "curiosity",
+    "playfulness", "wisdom", "firmwareVersion", "totalChats", "totalSyncs",
+    "lastSyncTime", "checksum",
+]
+AGENTS = ["AZOTH", "ELYSIAN", "VAJRA", "KETHER", "CLAUDE"]
+
+
+def crc16(data: bytes) -> int:
+    """CRC-16/CCITT-FALSE, as in link.h."""
+    return binascii.crc_hqx(data, 0xFFFF)
+
+
+class LinkError(Exception):
+    pass
+
+
+class Link:
+    """One framed session on the serial port."""
+
+    def __init__(self, port: str, baud: int = 115200, timeout: float = 2.0):
+        self.ser = serial.Serial(port, baud, timeout=0.05)
+        self.timeout = timeout
+        self.seq = 0
+        self.rx = bytearray()
+
+    # ---------- framing ----------
+
+    def send(self, ftype: int, payload: bytes = b""):
+        body = struct.pack("<BBH", ftype, self.seq & 0xFF, len(payload)) + payload
+        self.seq += 1
+        self.ser.write(MAGIC + body + struct.pack("<H", crc16(body)))
+
+    def recv(self, timeout: float = None):
+        """Next valid frame as (type, payload), or None on timeout. Bytes
+        outside frames (log lines) are skipped."""
+        deadline = time.monotonic() + (timeout if timeout is not None else self.timeout)
+        while True:
+            frame = self._parse()
+            if frame:
+                return frame
+            if time.monotonic() > deadline:
+                return None
+            chunk = self.ser.read(self.ser.in_waiting or 1)
+            self.rx.extend(chunk)
+
+    def _parse(self):
+        while True:
+            start = self.rx.find(MAGIC)
+            if start < 0:
+                del self.rx[:-1]        # Keep a trailing A5
+                return None
+            del self.rx[:start]
+            if len(self.rx) < 6:
+                return None
+            ftype, _seq, length = struct.unpack_from("<BBH", self.rx, 2)
+            if length > 512:
+                del self.rx[:2]
+                continue
+            if len(self.rx) < 8 + length:
+                return None
+            body = bytes(self.rx[2:6 + length])
+            (crc,) = struct.unpack_from("<H", self.rx, 6 + length)
+            if crc != crc16(body):
+                del self.rx[:2]
+                continue
+            del self.rx[:8 + length]
+            return ftype, body[4:]
+
+    def expect(self, *types):
+        frame = self.recv()
+        if frame is None:
+            raise LinkError("no reply from device")
+        ftype, payload = frame
+        if ftype == ERROR:
+            code = payload[0] if payload else 0
+            raise LinkError(f"{ERRORS.get(code, code)}: {payload[1:].decode(errors='replace')}")
+        if ftype not in types:
+            raise LinkError(f"unexpected frame 0x{ftype:02x}")
+        return ftype, payload
+
+    # ---------- session ----------
+
+    def connect(self) -> str:
+        """Switch the console into link mode and shake hands."""
+        self.ser.write(b"\n/link\n")
+        time.sleep(0.2)
+        for _ in range(5):
+            self.send(HELLO)
+            frame = self.recv(0.5)
+            if frame and frame[0] == HELLO_OK:
+                version, window, max_payload = struct.unpack_from("<BBH", frame[1])
+                if version != VERSION:
+                    raise LinkError(f"device speaks link v{version}, tool v{VERSION}")
+                return frame[1][4:].decode(errors="replace")
+        raise LinkError("device did not answer (is the console busy?)")
+
+    def close(self):
+        self.send(BYE)
+        self.recv(0.5)
+        self.ser.close()
+
+    def fetch(self, source: int, path: str = "", progress=None) -> bytes:
+        """Stream a source into memory, acking as data arrives."""
+        self.send(OPEN, bytes([source]) + path.encode())
+        _, payload = self.expect(OPEN_OK)
+        (size,) = struct.unpack("<I", payload)
+
+        data = bytearray()
+        started = time.monotonic()
+        while True:
+            frame = self.recv()
+            if frame is None:
+                self.send(ACK, struct.pack("<I", len(data)))    # Nudge a resend
+                frame = self.recv()
+                if frame is None:
+                    raise LinkError(f"stalled at {len(data)}/{size} bytes")
+            ftype, payload = frame
+            if ftype == DATA:
+                (offset,) = struct.unpack_from("<I", payload)
+                if offset == len(data):
+                    data.extend(payload[4:])
+                    if progress:
+                        progress(len(data), size, time.monotonic() - started)
+                self.send(ACK, struct.pack("<I", len(data)))
+            elif ftype == END and len(data) == size:
+                self.send(ACK, struct.pack("<I", ACK_END))
+                return bytes(data)
+            elif ftype == ERROR:
+                raise LinkError(payload[1:].decode(errors="replace"))
+
+    def soul_put(self, blob: bytes):
+        self.send(SOUL_PUT, blob)
+        self.expect(OK)
+
+
+# ==================== SOUL ====================
+
+def soul_checksum(blob: bytes) -> int:
+    """Soul::checksumOf() over everything but the checksum field."""
+    total = 0
+    for i, b in enumerate(blob[:-4]):
+        total = (total + b * (i + 1)) & 0xFFFFFFFF
+    return total ^ 0xA9EF
+
+
+def soul_decode(blob: bytes) -> dict:
+    if len(blob) != struct.calcsize(SOUL_FORMAT):
+        raise LinkError(f"soul is {len(blob)} bytes, expected {struct.calcsize(SOUL_FORMAT)}")
+    soul = dict(zip(SOUL_FIELDS, struct.unpack(SOUL_FORMAT, blob)))
+    soul["firmwareVersion"] = soul["firmwareVersion"].split(b"\0")[0].decode()
+    soul["agent"] = AGENTS[soul["agentIndex"]] if soul["agentIndex"] < len(AGENTS) else "?"
+    soul["checksum_ok"] = soul_checksum(blob) == soul["checksum"]
+    return soul
+
+
+# ==================== CLI ====================
+
+def show_progress(done: int, total: int, elapsed: float):
+    rate = done / elapsed / 1024 if elapsed > 0 else 0
+    print(f"\r  {done}/{total} bytes  {rate:.1f} KB/s", end="", file=sys.stderr)
+    if done == total:
+        print(file=sys.stderr)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="ApexPocket USB link")
+    parser.add_argument("-p", "--port", default="/dev/ttyACM0")
+    parser.add_argument("-b", "--baud", type=int, default=115200,
+                        help="ignored by USB CDC, used by UART boards")
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    sub.add_parser("status", help="JSON status snapshot")
+    sub.add_parser("metrics", help="Prometheus text, as /metrics")
+    trace = sub.add_parser("trace", help="event trace as Chrome trace JSON (env:esp32s3_trace)")
+    trace.add_argument("local", nargs="?", default="trace.json")
+    ls = sub.add_parser("ls", help="list an SD directory")
+    ls.add_argument("path", nargs="?", default="/history")
+    get = sub.add_parser("get", help="download an SD file")
+    get.add_argument("remote")
+    get.add_argument("local", nargs="?")
+    soul = sub.add_parser("soul", help="show, dump or restore the soul")
+    soul.add_argument("action", choices=["show", "dump", "restore"])
+    soul.add_argument("file", nargs="?")
+
+    args = parser.parse_args()
+    link = Link(args.port, args.baud)
+    try:
+        fw = link.connect()
+        print(f"[link] ApexPocket {fw}", file=sys.stderr)
+
+        if args.cmd == "status":
+            print(json.dumps(json.loads(link.fetch(SRC_STATUS)), indent=2))
+
+        elif args.cmd == "metrics":
+            sys.stdout.write(link.fetch(SRC_METRICS).decode(errors="replace"))
+
+        elif args.cmd == "trace":
+            Path(args.local).write_bytes(link.fetch(SRC_TRACE, progress=show_progress))
+            print(f"[link] trace -> {args.local}, open it in ui.perfetto.dev", file=sys.stderr)
+
+        elif args.cmd == "ls":
+            sys.stdout.write(link.fetch(SRC_LIST, args.path).decode(errors="replace"))
+
+        elif args.cmd == "get":
+            local = Path(args.local or Path(args.remote).name)
+            local.write_bytes(link.fetch(SRC_FILE, args.remote, show_progress))
+            print(f"[link] {args.remote} -> {local}", file=sys.stderr)
+
+        elif args.action == "show":
+            for key, value in soul_decode(link.fetch(SRC_SOUL)).items():
+                print(f"  {key:16} {value}")
+
+        elif args.action == "dump":
+            if not args.file:
+                parser.error("soul dump needs a file")
+            blob = link.fetch(SRC_SOUL)
+            soul_decode(blob)
+            Path(args.file).write_bytes(blob)
+            print(f"[link] soul -> {args.file}", file=sys.stderr)
+
+        elif args.action == "restore":
+            if not args.file:
+                parser.error("soul restore needs a file")
+            blob = Path(args.file).read_bytes()
+            if not soul_decode(blob)["checksum_ok"]:
+                raise LinkError(f"{args.file}: checksum mismatch, not sending")
+            link.soul_put(blob)
+            print("[link] soul restored", file=sys.stderr)
+        return 0
+
+    except LinkError as e:
+        print(f"[link] {e}", file=sys.stderr)
+        return 1
+    finally:
+        link.close()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""
+BenchDiff - compare two ApexPocket benchmark logs (esp32/src/bench.h)
+
+Takes serial captures of /bench runs (or pio test -e native -f test_bench
+-v output) from two firmware builds and prints the median change per
+bench. Exits 1 when a median got slower than the threshold.
+
+    benchdiff.py before.log after.log
+    benchdiff.py --threshold 5 before.log after.log
+
+Lines it reads:
+    BENCH_RUN <fw_version> <fw_build> <cpu_mhz>
+    BENCH <name> <iters> <min> <median> <p99> <unit> <heap_delta>
+"""
+
+import argparse
+import sys
+from pathlib import Path
+
+
+def load(path: Path) -> tuple[str, dict]:
+    """Run label and {name: (median, p99, unit, heap_delta)}; the last run of a name wins."""
+    label, benches = "?", {}
+    for line in path.read_text(errors="replace").splitlines():
+        fields = line.split()
+        if len(fields) == 4 and fields[0] == "BENCH_RUN":
+            label = f"{fields[1]} {fields[2]} @{fields[3]}MHz"
+        elif len(fields) == 8 and fields[0] == "BENCH":
+            name, median, p99, unit, heap = fields[1], int(fields[4]), int(fields[5]), fields[6], int(fields[7])
+            benches[name] = (median, p99, unit, heap)
+    return label, benches
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="Compare ApexPocket bench logs")
+    parser.add_argument("before", type=Path)
+    parser.add_argument("after", type=Path)
+    parser.add_argument("-t", "--threshold", type=float, default=10.0,
+                        help="percent slower that counts as a regression (default 10)")
+    args = parser.parse_args()
+
+    before_label, before = load(args.before)
+    after_label, after = load(args.after)
+    if not before or not after:
+        sys.exit("benchdiff: no BENCH lines in " + str(args.before if not before else args.after))
+
+    print(f"  before: {before_label}")
+    print(f"  after:  {after_label}")
+    print(f"  {'bench':18} {'median':>12} {'':>12} {'change':>8} {'p99':>12} {'heap':>7}")
+
+    regressions = 0
+    for name in sorted(set(before) | set(after)):
+        if name not in before or name not in after:
+            print(f"  {name:18} {'only in ' + ('after' if name in after else 'before'):>26}")
+            continue
+        b_med, _, b_unit, _ = before[name]
+        a_med, a_p99, a_unit, a_heap = after[name]
+        if b_unit != a_unit:
+            print(f"  {name:18} {'units differ: ' + b_unit + ' vs ' + a_unit:>26}")
+            continue
+        change = (a_med - b_med) * 100.0 / b_med if b_med else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  SLOWER"
+            regressions += 1
+        elif a_heap < 0:
+            flag = "  LEAK?"
+        print(f"  {name:18} {b_med:>12} {a_med:>12} {change:>+7.1f}% {a_p99:>12} {a_heap:>7}{flag}")
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
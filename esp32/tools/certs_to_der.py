@@ -0,0 +1,202 @@
+#!/usr/bin/env python3
+"""
+CertsToDer - build src/certs.h from the PEM roots in certs/
+
+Converts the root CAs to the x509 bundle format that
+WiFiClientSecure::setCACertBundle() takes (the same one ESP-IDF's
+gen_crt_bundle.py writes): a big-endian cert count, then per cert the
+lengths of its subject and public key followed by both in DER, sorted by
+subject. The firmware hands that to mbedTLS once; each handshake then
+looks the chain's issuer up in it instead of base64-decoding and parsing
+every PEM root again.
+
+Intermediates in certs/pins/ (or given with --pin) become SHA-256 pins of
+their SubjectPublicKeyInfo: the cloud client then only sends a request
+over a connection whose chain includes one of them.
+
+    certs_to_der.py                     certs/*.pem -> src/certs.h
+    certs_to_der.py --pin r11.pem       also pin an intermediate
+    certs_to_der.py --check             exit 1 if src/certs.h is stale
+
+Also runs as a PlatformIO pre-build script (extra_scripts), where it only
+rewrites src/certs.h when a PEM is newer.
+"""
+
+import argparse
+import base64
+import hashlib
+import re
+import struct
+import sys
+from pathlib import Path
+
+PEM_RE = re.compile(r"-----BEGIN CERTIFICATE-----(.+?)-----END CERTIFICATE-----", re.S)
+OID_CN = bytes([0x06, 0x03, 0x55, 0x04, 0x03])
+
+
+def tlv(data: bytes, pos: int) -> tuple[int, int, int]:
+    """Tag, value start and end of the DER element at pos."""
+    tag, length = data[pos], data[pos + 1]
+    pos += 2
+    if length & 0x80:
+        n = length & 0x7F
+        length = int.from_bytes(data[pos:pos + n], "big")
+        pos += n
+    return tag, pos, pos + length
+
+
+def children(data: bytes, start: int, end: int) -> list[tuple[int, int, int, int]]:
+    """(tag, element start, value start, end) of each element in a constructed value."""
+    out, pos = [], start
+    while pos < end:
+        tag, value, stop = tlv(data, pos)
+        out.append((tag, pos, value, stop))
+        pos = stop
+    return out
+
+
+class Cert:
+    def __init__(self, der: bytes, source: str):
+        self.der = der
+        self.source = source
+        _, cert_value, cert_end = tlv(der, 0)
+        _, _, tbs_value, tbs_end = children(der, cert_value, cert_end)[0]
+        fields = children(der, tbs_value, tbs_end)
+        if fields[0][0] == 0xA0:                # [0] version
+            fields = fields[1:]
+        # serial, signature, issuer, validity, subject, subjectPublicKeyInfo
+        _, _, validity_value, validity_end = fields[3]
+        self.subject = der[fields[4][1]:fields[4][3]]
+        self.spki = der[fields[5][1]:fields[5][3]]
+        not_after = children(der, validity_value, validity_end)[1]
+        self.expires = self._time(der[not_after[2]:not_after[3]], not_after[0])
+        self.name = self._common_name()
+
+    @staticmethod
+    def _time(value: bytes, tag: int) -> str:
+        text = value.decode()
+        if tag == 0x17:                         # UTCTime: YYMMDD...
+            text = ("19" if int(text[:2]) >= 50 else "20") + text
+        return f"{text[:4]}-{text[4:6]}-{text[6:8]}"
+
+    def _common_name(self) -> str:
+        at = self.subject.rfind(OID_CN)
+        if at < 0:
+            return self.source
+        _, value, end = tlv(self.subject, at + len(OID_CN))
+        return self.subject[value:end].decode(errors="replace")
+
+    def bundle_entry(self) -> bytes:
+        return struct.pack(">HH", len(self.subject), len(self.spki)) + self.subject + self.spki
+
+    def pin(self) -> bytes:
+        return hashlib.sha256(self.spki).digest()
+
+
+def load(path: Path) -> list[Cert]:
+    blocks = PEM_RE.findall(path.read_text())
+    if not blocks:
+        sys.exit(f"certs_to_der: no certificate in {path}")
+    certs = []
+    for block in blocks:
+        try:
+            certs.append(Cert(base64.b64decode("".join(block.split()), validate=True), path.name))
+        except (ValueError, IndexError) as e:
+            sys.exit(f"certs_to_der: {path} is not a valid certificate ({e})")
+    return certs
+
+
+def c_bytes(data: bytes, indent: str = "    ") -> str:
+    lines = []
+    for i in range(0, len(data), 12):
+        lines.append(indent + ", ".join(f"0x{b:02x}" for b in data[i:i + 12]) + ",")
+    return "\n".join(lines)
+
+
+def render(roots: list[Cert], pins: list[Cert]) -> str:
+    roots = sorted(roots, key=lambda c: c.subject)     # Binary search by issuer in mbedTLS
+    bundle = struct.pack(">H", len(roots)) + b"".join(c.bundle_entry() for c in roots)
+
+    out = [
+        "/*",
+        " * Root CA Bundle for HTTPS Validation",
+        " *",
+        " * GENERATED by tools/certs_to_der.py from esp32/certs/ - do not edit.",
+        " *",
+        " * Subject and public key of each root in DER, in the x509 bundle format",
+        " * WiFiClientSecure::setCACertBundle() takes. Parsed once into a store",
+        " * that every connection shares; no PEM decoding per handshake.",
+        " *",
+    ]
+    for c in roots:
+        out.append(f" * - {c.name} ({c.source}, until {c.expires})")
+    out += [
+        " *",
+        f" * {len(bundle)} bytes",
+        " */",
+        "",
+        "#ifndef CERTS_H",
+        "#define CERTS_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        f"#define CLOUD_CA_COUNT      {len(roots)}",
+        f"#define CLOUD_CA_PIN_COUNT  {len(pins)}",
+        "",
+        "static const uint8_t CLOUD_CA_BUNDLE[] PROGMEM = {",
+        c_bytes(bundle),
+        "};",
+    ]
+    if pins:
+        out += ["", "// SHA-256 of each pinned intermediate's SubjectPublicKeyInfo",
+                "static const uint8_t CLOUD_CA_PINS[CLOUD_CA_PIN_COUNT][32] PROGMEM = {"]
+        for c in pins:
+            out += [f"    {{   // {c.name} ({c.source}, until {c.expires})", c_bytes(c.pin(), "        "), "    },"]
+        out.append("};")
+    out += ["", "#endif // CERTS_H", ""]
+    return "\n".join(out)
+
+
+def generate(root_dir: Path, pin_files: list[Path]) -> str:
+    roots = [c for p in sorted(root_dir.glob("*.pem")) for c in load(p)]
+    if not roots:
+        sys.exit(f"certs_to_der: no .pem files in {root_dir}")
+    pin_dir = root_dir / "pins"
+    pin_files = list(pin_files) + (sorted(pin_dir.glob("*.pem")) if pin_dir.is_dir() else [])
+    pins = [c for p in pin_files for c in load(p)]
+    return render(roots, pins)
+
+
+def main() -> int:
+    here = Path(__file__).resolve().parent.parent
+    parser = argparse.ArgumentParser(description="Build the DER root CA bundle for the firmware")
+    parser.add_argument("--certs", type=Path, default=here / "certs", help="directory of root .pem files")
+    parser.add_argument("--out", type=Path, default=here / "src" / "certs.h")
+    parser.add_argument("--pin", type=Path, action="append", default=[],
+                        help="intermediate .pem to pin (repeatable)")
+    parser.add_argument("--check", action="store_true", help="exit 1 if --out is out of date")
+    args = parser.parse_args()
+
+    text = generate(args.certs, args.pin)
+    if args.check:
+        current = args.out.read_text() if args.out.exists() else ""
+        if current != text:
+            print(f"certs_to_der: {args.out} is stale, run tools/certs_to_der.py")
+            return 1
+        return 0
+    args.out.write_text(text)
+    print(f"certs_to_der: wrote {args.out}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+else:
+    # PlatformIO pre-build script
+    Import("env")   # noqa: F821 (SCons builtin)
+    project = Path(env.subst("$PROJECT_DIR"))  # noqa: F821
+    out = project / "src" / "certs.h"
+    sources = list((project / "certs").rglob("*.pem"))
+    if not out.exists() or any(p.stat().st_mtime > out.stat().st_mtime for p in sources):
+        out.write_text(generate(project / "certs", []))
+        print(f"certs_to_der: regenerated {out}")